@@ -68,7 +68,8 @@ FImGuiContextManager::FImGuiContextManager(FImGuiModuleSettings& InSettings)
 	Settings.OnDPIScaleChangedDelegate.AddRaw(this, &FImGuiContextManager::SetDPIScale);
 
 	SetDPIScale(Settings.GetDPIScaleInfo());
-	BuildFontAtlas();
+
+	// Font atlas is built with the first context, so headless runs never rasterize fonts.
 
 	FWorldDelegates::OnWorldTickStart.AddRaw(this, &FImGuiContextManager::OnWorldTickStart);
 #if ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
@@ -126,11 +127,17 @@ void FImGuiContextManager::OnWorldTickStart(ELevelTick TickType, float DeltaSeco
 
 void FImGuiContextManager::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
 {
-	if (World && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE
+	if (!bHeadless && World && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE
 		|| World->WorldType == EWorldType::Editor))
 	{
 		FImGuiContextProxy& ContextProxy = GetWorldContextProxy(*World);
 
+		// With async frames, world objects don't draw from the game thread and a worker may own the current context.
+		if (FImGuiContextProxy::IsAsyncFrames())
+		{
+			return;
+		}
+
 		// Set as current, so we have right context ready when updating world objects.
 		ContextProxy.SetAsCurrent();
 
@@ -144,7 +151,7 @@ void FImGuiContextManager::OnWorldTickStart(UWorld* World, ELevelTick TickType,
 #if ENGINE_COMPATIBILITY_WITH_WORLD_POST_ACTOR_TICK
 void FImGuiContextManager::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
 {
-	if (World && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE
+	if (!bHeadless && World && (World->WorldType == EWorldType::Game || World->WorldType == EWorldType::PIE
 		|| World->WorldType == EWorldType::Editor))
 	{
 		GetWorldContextProxy(*World).DrawDebug();
@@ -159,6 +166,7 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetEditorContextData()
 
 	if (UNLIKELY(!Data))
 	{
+		BuildFontAtlas();
 		Data = &Contexts.Emplace(Utilities::EDITOR_CONTEXT_INDEX, FContextData{ GetEditorContextName(), Utilities::EDITOR_CONTEXT_INDEX, FontAtlas, DPIScale, -1 });
 		OnContextProxyCreated.Broadcast(Utilities::EDITOR_CONTEXT_INDEX, *Data->ContextProxy);
 	}
@@ -174,6 +182,7 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetStandaloneWorldCont
 
 	if (UNLIKELY(!Data))
 	{
+		BuildFontAtlas();
 		Data = &Contexts.Emplace(Utilities::STANDALONE_GAME_CONTEXT_INDEX, FContextData{ GetWorldContextName(), Utilities::STANDALONE_GAME_CONTEXT_INDEX, FontAtlas, DPIScale });
 		OnContextProxyCreated.Broadcast(Utilities::STANDALONE_GAME_CONTEXT_INDEX, *Data->ContextProxy);
 	}
@@ -216,6 +225,7 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetWorldContextData(co
 #if WITH_EDITOR
 	if (UNLIKELY(!Data))
 	{
+		BuildFontAtlas();
 		Data = &Contexts.Emplace(Index, FContextData{ GetWorldContextName(World), Index, FontAtlas, DPIScale, WorldContext->PIEInstance });
 		OnContextProxyCreated.Broadcast(Index, *Data->ContextProxy);
 	}
@@ -227,6 +237,7 @@ FImGuiContextManager::FContextData& FImGuiContextManager::GetWorldContextData(co
 #else
 	if (UNLIKELY(!Data))
 	{
+		BuildFontAtlas();
 		Data = &Contexts.Emplace(Index, FContextData{ GetWorldContextName(World), Index, FontAtlas, DPIScale });
 		OnContextProxyCreated.Broadcast(Index, *Data->ContextProxy);
 	}
@@ -244,6 +255,9 @@ void FImGuiContextManager::SetDPIScale(const FImGuiDPIScaleInfo& ScaleInfo)
 	const float Scale = ScaleInfo.GetImGuiScale();
 	if (DPIScale != Scale)
 	{
+		// Fonts and styles are used by frames in flight.
+		FImGuiContextProxy::WaitForAsyncFrames();
+
 		DPIScale = Scale;
 
 		// Only rebuild font atlas if it is already built. Otherwise allow the other logic to pick a moment.
@@ -296,6 +310,8 @@ void FImGuiContextManager::BuildFontAtlas(const TMap<FName, TSharedPtr<ImFontCon
 
 void FImGuiContextManager::RebuildFontAtlas()
 {
+	FImGuiContextProxy::WaitForAsyncFrames();
+
 	if (FontAtlas.IsBuilt())
 	{
 		// Keep the old resources alive for a few frames to give all contexts a chance to bind to new ones.
@@ -68,6 +68,9 @@ public:
 
 	void RebuildFontAtlas();
 
+	// In headless mode world ticks are ignored, so contexts are not created on demand or set as current.
+	void SetHeadless(bool bInHeadless) { bHeadless = bInHeadless; }
+
 private:
 
 	struct FContextData
@@ -115,4 +118,6 @@ private:
 
 	float DPIScale = -1.f;
 	int32 FontResourcesReleaseCountdown = 0;
+
+	bool bHeadless = false;
 };
@@ -13,11 +13,15 @@
 
 #include <GenericPlatform/GenericPlatformFile.h>
 #include <Misc/Paths.h>
+#include <Tasks/Task.h>
 
 
 static constexpr float DEFAULT_CANVAS_WIDTH = 3840.f;
 static constexpr float DEFAULT_CANVAS_HEIGHT = 2160.f;
 
+bool FImGuiContextProxy::bAsyncFrames = false;
+UE::Tasks::FTask FImGuiContextProxy::LastAsyncFrame;
+
 
 namespace
 {
@@ -81,6 +85,11 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 	, ContextIndex(InContextIndex)
 	, IniFilename(TCHAR_TO_ANSI(*GetIniFile(InName)))
 {
+	// Creating a context changes the current context, which a worker frame may be using.
+	WaitForAsyncFrames();
+
+	PresentedDrawLists = &DrawBuffers.Read();
+
 	// Create context.
 	Context = ImGui::CreateContext(InFontAtlas);
 
@@ -113,6 +122,9 @@ FImGuiContextProxy::FImGuiContextProxy(const FString& InName, int32 InContextInd
 
 FImGuiContextProxy::~FImGuiContextProxy()
 {
+	// Make sure that no worker is still building a frame in this context or calling into its listeners.
+	WaitForAsyncFrames();
+
 	if (Context)
 	{
 		// It seems that to properly shutdown context we need to set it as the current one (at least in this framework
@@ -144,6 +156,8 @@ void FImGuiContextProxy::SetDPIScale(float Scale)
 		ImGuiStyle NewStyle = ImGuiStyle();
 		NewStyle.ScaleAllSizes(Scale);
 
+		WaitForAsyncFrames();
+
 		FGuardCurrentContext GuardContext;
 		SetAsCurrent();
 		ImGui::GetStyle() = MoveTemp(NewStyle);
@@ -152,6 +166,12 @@ void FImGuiContextProxy::SetDPIScale(float Scale)
 
 void FImGuiContextProxy::DrawEarlyDebug()
 {
+	// With async frames, draw events are called by the worker that builds the frame.
+	if (bAsyncFrames)
+	{
+		return;
+	}
+
 	if (bIsFrameStarted && !bIsDrawEarlyDebugCalled)
 	{
 		bIsDrawEarlyDebugCalled = true;
@@ -166,6 +186,11 @@ void FImGuiContextProxy::DrawEarlyDebug()
 
 void FImGuiContextProxy::DrawDebug()
 {
+	if (bAsyncFrames)
+	{
+		return;
+	}
+
 	if (bIsFrameStarted && !bIsDrawDebugCalled)
 	{
 		bIsDrawDebugCalled = true;
@@ -188,42 +213,154 @@ void FImGuiContextProxy::Tick(float DeltaSeconds)
 	{
 		LastFrameNumber = GFrameNumber;
 
-		SetAsCurrent();
-
-		if (bIsFrameStarted)
+		if (bAsyncFrames)
+		{
+			TickAsync(DeltaSeconds);
+		}
+		else
 		{
-			// Make sure that draw events are called before the end of the frame.
-			DrawDebug();
+			// Switching from async frames: the context must be back on the game thread before we continue.
+			if (!AsyncFrame.IsCompleted())
+			{
+				WaitForAsyncFrames();
+			}
 
-			// Ending frame will produce render output that we capture and store for later use. This also puts context to
-			// state in which it does not allow to draw controls, so we want to immediately start a new frame.
-			EndFrame();
+			SetAsCurrent();
+
+			if (bIsFrameStarted)
+			{
+				// Make sure that draw events are called before the end of the frame.
+				DrawDebug();
+
+				// Ending frame will produce render output that we capture and store for later use. This also puts context to
+				// state in which it does not allow to draw controls, so we want to immediately start a new frame.
+				EndFrame();
+			}
+
+			// Update context information (some data need to be collected before starting a new frame while some other data
+			// may need to be collected after).
+			bHasActiveItem = ImGui::IsAnyItemActive();
+			MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
+
+			// Begin a new frame and set the context back to a state in which it allows to draw controls.
+			BeginFrame(DeltaSeconds);
+
+			// Update remaining context information.
+			bWantsMouseCapture = ImGui::GetIO().WantCaptureMouse;
 		}
 
-		// Update context information (some data need to be collected before starting a new frame while some other data
-		// may need to be collected after).
-		bHasActiveItem = ImGui::IsAnyItemActive();
-		MouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
+		PresentDrawData();
+	}
+}
+
+void FImGuiContextProxy::TickAsync(float DeltaSeconds)
+{
+	// The worker owns the context until its frame is complete. Until then Slate keeps presenting the last frame and
+	// input keeps accumulating for the next one, so the game thread never waits here.
+	if (!AsyncFrame.IsCompleted())
+	{
+		return;
+	}
+
+	if (bIsFrameStarted)
+	{
+		// Switching from synchronous frames: finish the frame that game thread code has been drawing to. Other contexts
+		// may already have a worker frame in flight.
+		WaitForAsyncFrames();
+
+		SetAsCurrent();
+		BroadcastMultiContextEarlyDebug();
+		BroadcastWorldEarlyDebug();
+		BroadcastWorldDebug();
+		BroadcastMultiContextDebug();
+		EndFrame();
+	}
+
+	// Publish context information collected by the last worker frame.
+	bHasActiveItem = bAsyncHasActiveItem;
+	MouseCursor = AsyncMouseCursor;
+	bWantsMouseCapture = bAsyncWantsMouseCapture;
 
-		// Begin a new frame and set the context back to a state in which it allows to draw controls.
-		BeginFrame(DeltaSeconds);
+	// Stage the input, since Slate keeps writing to the input state while the worker builds the frame.
+	AsyncInputState = InputState;
+	InputState.ClearUpdateState();
 
-		// Update remaining context information.
-		bWantsMouseCapture = ImGui::GetIO().WantCaptureMouse;
+	// Copy listeners in the order specified in FImGuiDelegates, so the worker does not read containers that the game
+	// thread can modify.
+	AsyncDrawEvents.Reset();
+	AsyncDrawEvents.Add(FImGuiDelegatesContainer::Get().OnMultiContextEarlyDebug());
+	if (ContextIndex != Utilities::INVALID_CONTEXT_INDEX)
+	{
+		AsyncDrawEvents.Add(FImGuiDelegatesContainer::Get().OnWorldEarlyDebug(ContextIndex));
+	}
+	AsyncDrawEvents.Add(DrawEvent);
+	if (ContextIndex != Utilities::INVALID_CONTEXT_INDEX)
+	{
+		AsyncDrawEvents.Add(FImGuiDelegatesContainer::Get().OnWorldDebug(ContextIndex));
+	}
+	AsyncDrawEvents.Add(FImGuiDelegatesContainer::Get().OnMultiContextDebug());
+
+	auto BuildFrame = [this, DeltaSeconds, FrameDisplaySize = DisplaySize]()
+	{
+		BuildAsyncFrame(DeltaSeconds, FrameDisplaySize);
+	};
+
+	// Chain after the last worker frame of any context, because ImGui has a single current context.
+	AsyncFrame = LastAsyncFrame.IsValid()
+		? UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(BuildFrame), UE::Tasks::Prerequisites(LastAsyncFrame))
+		: UE::Tasks::Launch(UE_SOURCE_LOCATION, MoveTemp(BuildFrame));
+	LastAsyncFrame = AsyncFrame;
+}
+
+void FImGuiContextProxy::BuildAsyncFrame(float DeltaSeconds, const FVector2D& FrameDisplaySize)
+{
+	SetAsCurrent();
+
+	BeginFrame(DeltaSeconds, AsyncInputState, FrameDisplaySize);
+	bAsyncWantsMouseCapture = ImGui::GetIO().WantCaptureMouse;
+
+	for (const FSimpleMulticastDelegate& DrawEvents : AsyncDrawEvents)
+	{
+		DrawEvents.Broadcast();
+	}
+
+	EndFrame();
+
+	bAsyncHasActiveItem = ImGui::IsAnyItemActive();
+	AsyncMouseCursor = ImGuiInterops::ToSlateMouseCursor(ImGui::GetMouseCursor());
+}
+
+void FImGuiContextProxy::WaitForAsyncFrames()
+{
+	check(IsInGameThread());
+	LastAsyncFrame.Wait();
+}
+
+void FImGuiContextProxy::PresentDrawData()
+{
+	if (DrawBuffers.IsDirty())
+	{
+		DrawBuffers.SwapReadBuffers();
+		PresentedDrawLists = &DrawBuffers.Read();
 	}
 }
 
 void FImGuiContextProxy::BeginFrame(float DeltaTime)
+{
+	BeginFrame(DeltaTime, InputState, DisplaySize);
+}
+
+void FImGuiContextProxy::BeginFrame(float DeltaTime, FImGuiInputState& FrameInputState, const FVector2D& FrameDisplaySize)
 {
 	if (!bIsFrameStarted)
 	{
 		ImGuiIO& IO = ImGui::GetIO();
 		IO.DeltaTime = DeltaTime;
 
-		ImGuiInterops::CopyInput(IO, InputState);
-		InputState.ClearUpdateState();
+		ImGuiInterops::CopyInput(IO, FrameInputState);
+		FrameInputState.ClearUpdateState();
 
-		IO.DisplaySize = { (float)DisplaySize.X, (float)DisplaySize.Y };
+		IO.DisplaySize = { (float)FrameDisplaySize.X, (float)FrameDisplaySize.Y };
 
 		ImGui::NewFrame();
 
@@ -250,6 +387,8 @@ void FImGuiContextProxy::EndFrame()
 
 void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData)
 {
+	TArray<FImGuiDrawList>& DrawLists = DrawBuffers.GetWriteBuffer();
+
 	if (DrawData && DrawData->CmdListsCount > 0)
 	{
 		DrawLists.SetNum(DrawData->CmdListsCount, false);
@@ -264,6 +403,9 @@ void FImGuiContextProxy::UpdateDrawData(ImDrawData* DrawData)
 		// If we are not rendering then this might be a good moment to empty the array.
 		DrawLists.Empty();
 	}
+
+	// Hand the frame over to Slate. It picks it up with the next present, while we are free to write the next frame.
+	DrawBuffers.SwapWriteBuffers();
 }
 
 void FImGuiContextProxy::BroadcastWorldEarlyDebug()
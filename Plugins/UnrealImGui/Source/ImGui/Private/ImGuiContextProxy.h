@@ -6,7 +6,9 @@
 #include "ImGuiInputState.h"
 #include "Utilities/WorldContextIndex.h"
 
+#include <Containers/TripleBuffer.h>
 #include <GenericPlatform/ICursor.h>
+#include <Tasks/Task.h>
 
 #include <imgui.h>
 
@@ -15,6 +17,11 @@
 
 // Represents a single ImGui context. All the context updates should be done through this proxy. During update it
 // broadcasts draw events to allow listeners draw their controls. After update it stores draw data.
+//
+// With async frames enabled, the whole frame (new frame, draw events and render) is built on a task graph worker. The
+// game thread only stages input and collects the result: draw data pass through a triple buffer, so Slate always
+// presents the newest completed frame and never waits for the worker. Worker frames of all contexts are serialized,
+// because ImGui keeps the current context in a global.
 class FImGuiContextProxy
 {
 public:
@@ -32,7 +39,7 @@ public:
 	const FString& GetName() const { return Name; }
 
 	// Get draw data from the last frame.
-	const TArray<FImGuiDrawList>& GetDrawData() const { return DrawLists; }
+	const TArray<FImGuiDrawList>& GetDrawData() const { return *PresentedDrawLists; }
 
 	// Get input state used by this context.
 	FImGuiInputState& GetInputState() { return InputState; }
@@ -81,9 +88,24 @@ public:
 	// Tick to advance context to the next frame. Only one call per frame will be processed.
 	void Tick(float DeltaSeconds);
 
+	// Whether frames of all contexts are built on a worker thread.
+	static bool IsAsyncFrames() { return bAsyncFrames; }
+
+	// Enable or disable async frames. Set once at startup; contexts pick it up at their next tick.
+	static void SetAsyncFrames(bool bEnabled) { bAsyncFrames = bEnabled; }
+
+	// Block until worker frames of all contexts are complete. Must be called on the game thread before touching ImGui
+	// state that a frame in flight may use (contexts, styles, font atlas, draw delegate owners).
+	static void WaitForAsyncFrames();
+
 private:
 
+	void TickAsync(float DeltaSeconds);
+	void BuildAsyncFrame(float DeltaSeconds, const FVector2D& FrameDisplaySize);
+	void PresentDrawData();
+
 	void BeginFrame(float DeltaTime = 1.f / 60.f);
+	void BeginFrame(float DeltaTime, FImGuiInputState& FrameInputState, const FVector2D& FrameDisplaySize);
 	void EndFrame();
 
 	void UpdateDrawData(ImDrawData* DrawData);
@@ -109,7 +131,20 @@ private:
 
 	FImGuiInputState InputState;
 
-	TArray<FImGuiDrawList> DrawLists;
+	// Written by the frame that renders, read by Slate.
+	TTripleBuffer<TArray<FImGuiDrawList>> DrawBuffers;
+	const TArray<FImGuiDrawList>* PresentedDrawLists = nullptr;
+
+	// Async frame in flight and the state it works on. Only touched by the game thread while no frame is in flight.
+	UE::Tasks::FTask AsyncFrame;
+	FImGuiInputState AsyncInputState;
+	TArray<FSimpleMulticastDelegate, TInlineAllocator<5>> AsyncDrawEvents;
+	EMouseCursor::Type AsyncMouseCursor = EMouseCursor::None;
+	bool bAsyncHasActiveItem = false;
+	bool bAsyncWantsMouseCapture = false;
+
+	static bool bAsyncFrames;
+	static UE::Tasks::FTask LastAsyncFrame;
 
 	FString Name;
 	int32 ContextIndex = Utilities::INVALID_CONTEXT_INDEX;
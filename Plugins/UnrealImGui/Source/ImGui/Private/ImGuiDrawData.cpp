@@ -2,22 +2,55 @@
 
 #include "ImGuiDrawData.h"
 
+#include <Math/VectorRegister.h>
 
-#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const
+
+// FColor keeps its channels as a little-endian BGRA word, while ImGui packs colors with IM_COL32_*_SHIFT.
+// When the layouts are known, a color is converted with a few bitwise operations on the whole word.
+#if PLATFORM_LITTLE_ENDIAN && IM_COL32_R_SHIFT == 0 && IM_COL32_G_SHIFT == 8 && IM_COL32_B_SHIFT == 16 && IM_COL32_A_SHIFT == 24
+#define IMGUI_PACKED_COLOR_SWAP_RB 1
+#elif PLATFORM_LITTLE_ENDIAN && IM_COL32_R_SHIFT == 16 && IM_COL32_G_SHIFT == 8 && IM_COL32_B_SHIFT == 0 && IM_COL32_A_SHIFT == 24
+#define IMGUI_PACKED_COLOR_SWAP_RB 0
+#endif
+
+#if defined(IMGUI_PACKED_COLOR_SWAP_RB) && !ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+#define IMGUI_VECTORIZED_VERTEX_COPY 1
 #else
-void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform) const
-#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+#define IMGUI_VECTORIZED_VERTEX_COPY 0
+#endif
+
+
+namespace
 {
-	// Reset and reserve space in destination buffer.
-	OutVertexBuffer.SetNumUninitialized(ImGuiVertexBuffer.Size, false);
+#if ENGINE_COMPATIBILITY_LEGACY_ALLOW_SHRINKING
+	constexpr bool NoShrinking = false;
+#else
+	constexpr EAllowShrinking NoShrinking = EAllowShrinking::No;
+#endif // ENGINE_COMPATIBILITY_LEGACY_ALLOW_SHRINKING
 
-	// Transform and copy vertex data.
-	for (int Idx = 0; Idx < ImGuiVertexBuffer.Size; Idx++)
+	// The vectorized path loads position and UV of one vertex as a single 4-float register.
+	static_assert(STRUCT_OFFSET(ImDrawVert, uv) == STRUCT_OFFSET(ImDrawVert, pos) + sizeof(ImVec2),
+		"ImDrawVert position and UV must be adjacent");
+
+#if IMGUI_VECTORIZED_VERTEX_COPY
+	// Convert four ImGui packed colors to FColor words.
+	FORCEINLINE VectorRegister4Int ToFColorWords(const VectorRegister4Int& Colors)
 	{
-		const ImDrawVert& ImGuiVertex = ImGuiVertexBuffer[Idx];
-		FSlateVertex& SlateVertex = OutVertexBuffer[Idx];
+#if IMGUI_PACKED_COLOR_SWAP_RB
+		const VectorRegister4Int GreenAlphaMask = MakeVectorRegisterInt((int32)0xFF00FF00, (int32)0xFF00FF00, (int32)0xFF00FF00, (int32)0xFF00FF00);
+		const VectorRegister4Int LowByteMask = MakeVectorRegisterInt(0xFF, 0xFF, 0xFF, 0xFF);
+		const VectorRegister4Int Red = VectorShiftLeftImm(VectorIntAnd(Colors, LowByteMask), 16);
+		const VectorRegister4Int Blue = VectorIntAnd(VectorShiftRightImmLogical(Colors, 16), LowByteMask);
+		return VectorIntOr(VectorIntAnd(Colors, GreenAlphaMask), VectorIntOr(Red, Blue));
+#else
+		return Colors;
+#endif // IMGUI_PACKED_COLOR_SWAP_RB
+	}
+#endif // IMGUI_VECTORIZED_VERTEX_COPY
 
+	// Scalar conversion of a single vertex, used for the tail of the vectorized loop and for legacy engines.
+	FORCEINLINE void ConvertVertex(const ImDrawVert& ImGuiVertex, FSlateVertex& SlateVertex, const FTransform2D& Transform)
+	{
 		// Final UV is calculated in shader as XY * ZW, so we need set all components.
 		SlateVertex.TexCoords[0] = ImGuiVertex.uv.x;
 		SlateVertex.TexCoords[1] = ImGuiVertex.uv.y;
@@ -27,7 +60,6 @@ void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const
 		const FVector2D VertexPosition = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
 		SlateVertex.Position[0] = VertexPosition.X;
 		SlateVertex.Position[1] = VertexPosition.Y;
-		SlateVertex.ClipRect = VertexClippingRect;
 #else
 #if ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
 		SlateVertex.Position = Transform.TransformPoint(ImGuiInterops::ToVector2D(ImGuiVertex.pos));
@@ -41,16 +73,162 @@ void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const
 	}
 }
 
-void FImGuiDrawList::CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const
+void FImGuiDrawList::GetBatches(TArray<FImGuiDrawBatch>& OutBatches, const FTransform2D& Transform) const
+{
+	OutBatches.Reset();
+
+	const ImDrawCmd* Batch = nullptr;
+	uint32 NumElements = 0;
+
+	const auto CloseBatch = [&]()
+	{
+		if (!Batch || NumElements == 0)
+		{
+			return;
+		}
+
+		// Vertex range referenced by the batch, so only those vertices are converted and submitted.
+		uint32 MinVertex = MAX_uint32;
+		uint32 MaxVertex = 0;
+		const ImDrawIdx* Indices = ImGuiIndexBuffer.Data + Batch->IdxOffset;
+		for (uint32 i = 0; i < NumElements; i++)
+		{
+			MinVertex = FMath::Min<uint32>(MinVertex, Indices[i]);
+			MaxVertex = FMath::Max<uint32>(MaxVertex, Indices[i]);
+		}
+
+		OutBatches.Add({ NumElements, Batch->IdxOffset, Batch->VtxOffset + MinVertex, MaxVertex - MinVertex + 1, MinVertex,
+			TransformRect(Transform, ImGuiInterops::ToSlateRect(Batch->ClipRect)), ImGuiInterops::ToTextureIndex(Batch->TextureId) });
+	};
+
+	for (const ImDrawCmd& Command : ImGuiCommandBuffer)
+	{
+		// Extend the open batch when this command continues it in the index buffer with the same state.
+		const bool bContinuesBatch = Batch && Command.TextureId == Batch->TextureId && Command.VtxOffset == Batch->VtxOffset
+			&& Command.IdxOffset == Batch->IdxOffset + NumElements
+			&& Command.ClipRect.x == Batch->ClipRect.x && Command.ClipRect.y == Batch->ClipRect.y
+			&& Command.ClipRect.z == Batch->ClipRect.z && Command.ClipRect.w == Batch->ClipRect.w;
+
+		if (bContinuesBatch)
+		{
+			NumElements += Command.ElemCount;
+		}
+		else
+		{
+			CloseBatch();
+			Batch = &Command;
+			NumElements = Command.ElemCount;
+		}
+	}
+
+	CloseBatch();
+}
+
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect,
+	const int32 FirstVertex, int32 NumVertices) const
+#else
+void FImGuiDrawList::CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const int32 FirstVertex,
+	int32 NumVertices) const
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+{
+	if (NumVertices < 0)
+	{
+		NumVertices = ImGuiVertexBuffer.Size - FirstVertex;
+	}
+
+	// Reset destination buffer. It never shrinks, so after the first few frames it stays at the high-water mark and
+	// conversion does not allocate.
+	OutVertexBuffer.SetNumUninitialized(NumVertices, NoShrinking);
+
+	const ImDrawVert* Src = ImGuiVertexBuffer.Data + FirstVertex;
+	FSlateVertex* Dst = OutVertexBuffer.GetData();
+	int Idx = 0;
+
+#if IMGUI_VECTORIZED_VERTEX_COPY
+	// Transform and copy four vertices at a time. Transform is affine: P' = (x * A + y * C, x * B + y * D) + T.
+	double A, B, C, D;
+	Transform.GetMatrix().GetMatrix(A, B, C, D);
+	const FVector2D Translation = Transform.GetTranslation();
+
+	const VectorRegister4Float RowX = MakeVectorRegisterFloat((float)A, (float)B, (float)A, (float)B);
+	const VectorRegister4Float RowY = MakeVectorRegisterFloat((float)C, (float)D, (float)C, (float)D);
+	const VectorRegister4Float Offset = MakeVectorRegisterFloat((float)Translation.X, (float)Translation.Y, (float)Translation.X, (float)Translation.Y);
+
+	for (; Idx + 4 <= NumVertices; Idx += 4)
+	{
+		// Each register holds (x, y, u, v) of one vertex.
+		const VectorRegister4Float V0 = VectorLoad(&Src[Idx + 0].pos.x);
+		const VectorRegister4Float V1 = VectorLoad(&Src[Idx + 1].pos.x);
+		const VectorRegister4Float V2 = VectorLoad(&Src[Idx + 2].pos.x);
+		const VectorRegister4Float V3 = VectorLoad(&Src[Idx + 3].pos.x);
+
+		// Final UV is calculated in shader as XY * ZW, so texture coordinates are (u, v, 1, 1).
+		VectorStore(VectorShuffle(V0, VectorOne(), 2, 3, 0, 1), Dst[Idx + 0].TexCoords);
+		VectorStore(VectorShuffle(V1, VectorOne(), 2, 3, 0, 1), Dst[Idx + 1].TexCoords);
+		VectorStore(VectorShuffle(V2, VectorOne(), 2, 3, 0, 1), Dst[Idx + 2].TexCoords);
+		VectorStore(VectorShuffle(V3, VectorOne(), 2, 3, 0, 1), Dst[Idx + 3].TexCoords);
+
+		// Positions of two vertices per register: (x0, x0, x1, x1) * RowX + (y0, y0, y1, y1) * RowY + Offset.
+		const VectorRegister4Float P01 = VectorMultiplyAdd(VectorShuffle(V0, V1, 0, 0, 0, 0), RowX,
+			VectorMultiplyAdd(VectorShuffle(V0, V1, 1, 1, 1, 1), RowY, Offset));
+		const VectorRegister4Float P23 = VectorMultiplyAdd(VectorShuffle(V2, V3, 0, 0, 0, 0), RowX,
+			VectorMultiplyAdd(VectorShuffle(V2, V3, 1, 1, 1, 1), RowY, Offset));
+
+		alignas(16) float Positions[8];
+		VectorStoreAligned(P01, Positions);
+		VectorStoreAligned(P23, Positions + 4);
+
+		const VectorRegister4Int Colors = ToFColorWords(MakeVectorRegisterInt(
+			(int32)Src[Idx + 0].col, (int32)Src[Idx + 1].col, (int32)Src[Idx + 2].col, (int32)Src[Idx + 3].col));
+
+		alignas(16) uint32 ColorWords[4];
+		VectorIntStoreAligned(Colors, ColorWords);
+
+		for (int Lane = 0; Lane < 4; Lane++)
+		{
+			FSlateVertex& SlateVertex = Dst[Idx + Lane];
+#if ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
+			SlateVertex.Position = FVector2D{ Positions[Lane * 2], Positions[Lane * 2 + 1] };
+#else
+			SlateVertex.Position = FVector2f{ Positions[Lane * 2], Positions[Lane * 2 + 1] };
+#endif // ENGINE_COMPATIBILITY_LEGACY_VECTOR2F
+			SlateVertex.Color = FColor{ ColorWords[Lane] };
+		}
+	}
+#endif // IMGUI_VECTORIZED_VERTEX_COPY
+
+	// Transform and copy remaining vertex data.
+	for (; Idx < NumVertices; Idx++)
+	{
+		ConvertVertex(Src[Idx], Dst[Idx], Transform);
+#if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+		Dst[Idx].ClipRect = VertexClippingRect;
+#endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
+	}
+}
+
+void FImGuiDrawList::CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements, const uint32 BaseVertex) const
 {
-	// Reset buffer.
-	OutIndexBuffer.SetNumUninitialized(NumElements, false);
+	// Reset buffer. Like the vertex buffer, it stays at the high-water mark.
+	OutIndexBuffer.SetNumUninitialized(NumElements, NoShrinking);
 
-	// Copy elements (slow copy because of different sizes of ImDrawIdx and SlateIndex and because SlateIndex can
-	// have different size on different platforms).
-	for (int i = 0; i < NumElements; i++)
+	const ImDrawIdx* Src = ImGuiIndexBuffer.Data + StartIndex;
+	SlateIndex* Dst = OutIndexBuffer.GetData();
+
+	if (sizeof(ImDrawIdx) == sizeof(SlateIndex) && BaseVertex == 0)
+	{
+		// Same width (32-bit ImGui indices) and no rebasing, so this is a plain copy.
+		FMemory::Memcpy(Dst, Src, NumElements * sizeof(SlateIndex));
+	}
+	else
 	{
-		OutIndexBuffer[i] = ImGuiIndexBuffer[StartIndex + i];
+		// Rebasing and/or widening copy (16-bit ImGui indices). Contiguous, branch-free and trivially vectorized by the
+		// compiler.
+		for (int32 i = 0; i < NumElements; i++)
+		{
+			Dst[i] = static_cast<SlateIndex>(Src[i] - BaseVertex);
+		}
 	}
 }
 
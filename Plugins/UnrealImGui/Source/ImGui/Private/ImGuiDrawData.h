@@ -10,11 +10,16 @@
 #include <imgui.h>
 
 
-// ImGui draw command data transformed for Slate.
-struct FImGuiDrawCommand
+// Run of consecutive ImGui draw commands that share texture and clipping rectangle, so they can be submitted to Slate
+// as a single element. Vertices are limited to the range referenced by the batch indices, and BaseVertex is what
+// needs to be subtracted from those indices to address the copied range.
+struct FImGuiDrawBatch
 {
 	uint32 NumElements;
 	uint32 IndexOffset;
+	uint32 FirstVertex;
+	uint32 NumVertices;
+	uint32 BaseVertex;
 	FSlateRect ClippingRect;
 	TextureIndex TextureId;
 };
@@ -24,31 +29,28 @@ class FImGuiDrawList
 {
 public:
 
-	// Get the number of draw commands in this list.
-	FORCEINLINE int NumCommands() const { return ImGuiCommandBuffer.Size; }
-
-	// Get the draw command by number.
-	// @param CommandNb - Number of draw command
-	// @param Transform - Transform to apply to clipping rectangle
-	// @returns Draw command data
-	FImGuiDrawCommand GetCommand(int CommandNb, const FTransform2D& Transform) const
-	{
-		const ImDrawCmd& ImGuiCommand = ImGuiCommandBuffer[CommandNb];
-		return { ImGuiCommand.ElemCount, ImGuiCommand.IdxOffset, TransformRect(Transform, ImGuiInterops::ToSlateRect(ImGuiCommand.ClipRect)),
-			ImGuiInterops::ToTextureIndex(ImGuiCommand.TextureId) };
-	}
+	// Merge consecutive draw commands with the same texture and clipping rectangle into batches.
+	// @param OutBatches - Destination buffer (old data are replaced)
+	// @param Transform - Transform to apply to clipping rectangles
+	void GetBatches(TArray<FImGuiDrawBatch>& OutBatches, const FTransform2D& Transform) const;
 
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
 	// @param OutVertexBuffer - Destination buffer
 	// @param Transform - Transform to apply to all vertices
 	// @param VertexClippingRect - Clipping rectangle for transformed Slate vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect) const;
+	// @param FirstVertex - First vertex to copy
+	// @param NumVertices - How many vertices we want to copy (negative to copy everything from FirstVertex)
+	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const FSlateRotatedRect& VertexClippingRect,
+		const int32 FirstVertex = 0, int32 NumVertices = -1) const;
 #else
 	// Transform and copy vertex data to target buffer (old data in the target buffer are replaced).
 	// @param OutVertexBuffer - Destination buffer
 	// @param Transform - Transform to apply to all vertices
-	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform) const;
+	// @param FirstVertex - First vertex to copy
+	// @param NumVertices - How many vertices we want to copy (negative to copy everything from FirstVertex)
+	void CopyVertexData(TArray<FSlateVertex>& OutVertexBuffer, const FTransform2D& Transform, const int32 FirstVertex = 0,
+		int32 NumVertices = -1) const;
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
 	// Transform and copy index data to target buffer (old data in the target buffer are replaced).
@@ -56,7 +58,8 @@ public:
 	// @param OutIndexBuffer - Destination buffer
 	// @param StartIndex - Start copying source data starting from this index
 	// @param NumElements - How many elements we want to copy
-	void CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements) const;
+	// @param BaseVertex - Subtracted from every index, to match vertices copied from FirstVertex
+	void CopyIndexData(TArray<SlateIndex>& OutIndexBuffer, const int32 StartIndex, const int32 NumElements, const uint32 BaseVertex = 0) const;
 
 	// Transfers data from ImGui source list to this object. Leaves source cleared.
 	void TransferDrawData(ImDrawList& Src);
@@ -13,6 +13,7 @@
 #include "Editor/ImGuiEditor.h"
 #endif
 
+#include <Framework/Application/SlateApplication.h>
 #include <Interfaces/IPluginManager.h>
 
 
@@ -116,6 +117,24 @@ void FImGuiModule::ReleaseTexture(const FImGuiTextureHandle& Handle)
 	}
 }
 
+FImGuiTextureHandle FImGuiModule::CreateStreamingTexture(const FName& Name, int32 Width, int32 Height)
+{
+	// Slate resources can't be created without Slate or while running headless.
+	if (ImGuiModuleManager->GetProperties().IsHeadless() || !FSlateApplication::IsInitialized())
+	{
+		return {};
+	}
+
+	const TextureIndex Index = ImGuiModuleManager->GetTextureManager().CreateStreamingTexture(Name, Width, Height);
+	return FImGuiTextureHandle{ Name, ImGuiInterops::ToImTextureID(Index) };
+}
+
+bool FImGuiModule::UpdateTexture(const FImGuiTextureHandle& Handle, int32 Width, int32 Height, uint32 SrcPitch, const uint8* SrcData)
+{
+	return Handle.IsValid() && ImGuiModuleManager->GetTextureManager().UpdateTexture(
+		ImGuiInterops::ToTextureIndex(Handle.GetTextureId()), Width, Height, SrcPitch, SrcData);
+}
+
 void FImGuiModule::RebuildFontAtlas()
 {
 	if (ImGuiModuleManager)
@@ -226,6 +245,19 @@ const FImGuiModuleProperties& FImGuiModule::GetProperties() const
 	return ImGuiModuleManager->GetProperties();
 }
 
+bool FImGuiModule::IsUIActive() const
+{
+	return ImGuiModuleManager && ImGuiModuleManager->IsUIActive();
+}
+
+void FImGuiModule::EnterHeadlessMode()
+{
+	if (ImGuiModuleManager && !ImGuiModuleManager->GetProperties().IsHeadless())
+	{
+		ImGuiModuleManager->EnterHeadless();
+	}
+}
+
 bool FImGuiModule::IsInputMode() const
 {
 	return ImGuiModuleManager && ImGuiModuleManager->GetProperties().IsInputEnabled();
@@ -6,11 +6,16 @@
 #include "Utilities/WorldContextIndex.h"
 
 #include <Framework/Application/SlateApplication.h>
+#include <Misc/App.h>
+#include <Misc/CommandLine.h>
+#include <Misc/Parse.h>
 #include <Modules/ModuleManager.h>
 
 #include <imgui.h>
 
 
+DEFINE_LOG_CATEGORY_STATIC(LogImGuiModule, Log, All);
+
 // High enough z-order guarantees that ImGui output is rendered on top of the game UI.
 constexpr int32 IMGUI_WIDGET_Z_ORDER = 10000;
 
@@ -24,6 +29,20 @@ FImGuiModuleManager::FImGuiModuleManager()
 	, ImGuiDemo(Properties)
 	, ContextManager(Settings)
 {
+	// Without anything to render to (or when asked to), we skip all UI work.
+	Properties.SetHeadless(!FApp::CanEverRender() || IsRunningDedicatedServer()
+		|| FParse::Param(FCommandLine::Get(), TEXT("ImGuiHeadless")));
+
+	// Build ImGui frames on a worker thread if requested on the command line.
+	Properties.SetAsyncFramesEnabled(!Properties.IsHeadless() && FParse::Param(FCommandLine::Get(), TEXT("ImGuiAsyncFrames")));
+	FImGuiContextProxy::SetAsyncFrames(Properties.IsAsyncFramesEnabled());
+
+	if (Properties.IsHeadless())
+	{
+		EnterHeadless();
+		return;
+	}
+
 	// Register in context manager to get information whenever a new context proxy is created.
 	ContextManager.OnContextProxyCreated.AddRaw(this, &FImGuiModuleManager::OnContextProxyCreated);
 
@@ -56,6 +75,42 @@ FImGuiModuleManager::~FImGuiModuleManager()
 	}
 
 	// Remove still active widgets (important during hot-reloading).
+	RemoveWidgetsFromViewports();
+
+	// Deactivate this manager.
+	ReleaseTickInitializer();
+	UnregisterTick();
+}
+
+void FImGuiModuleManager::EnterHeadless()
+{
+	Properties.SetHeadless(true);
+
+	// Async frames would have nothing to build.
+	Properties.SetAsyncFramesEnabled(false);
+	FImGuiContextProxy::SetAsyncFrames(false);
+
+	// Contexts are neither ticked nor set as current, and no widgets or textures are created.
+	ContextManager.SetHeadless(true);
+	ContextManager.OnContextProxyCreated.RemoveAll(this);
+
+	if (ViewportCreatedHandle.IsValid())
+	{
+		UGameViewportClient::OnViewportCreated().Remove(ViewportCreatedHandle);
+		ViewportCreatedHandle.Reset();
+	}
+
+	RemoveWidgetsFromViewports();
+	Widgets.Reset();
+
+	ReleaseTickInitializer();
+	UnregisterTick();
+
+	UE_LOG(LogImGuiModule, Log, TEXT("ImGui module is running headless, UI will not be built."));
+}
+
+void FImGuiModuleManager::RemoveWidgetsFromViewports()
+{
 	for (auto& Widget : Widgets)
 	{
 		auto SharedWidget = Widget.Pin();
@@ -68,10 +123,6 @@ FImGuiModuleManager::~FImGuiModuleManager()
 			}
 		}
 	}
-
-	// Deactivate this manager.
-	ReleaseTickInitializer();
-	UnregisterTick();
 }
 
 void FImGuiModuleManager::RebuildFontAtlas()
@@ -79,6 +130,11 @@ void FImGuiModuleManager::RebuildFontAtlas()
 	ContextManager.RebuildFontAtlas();
 }
 
+bool FImGuiModuleManager::IsUIActive() const
+{
+	return !Properties.IsHeadless() && Widgets.ContainsByPredicate([](const auto& Widget) { return Widget.IsValid(); });
+}
+
 void FImGuiModuleManager::LoadTextures()
 {
 	checkf(FSlateApplication::IsInitialized(), TEXT("Slate should be initialized before we can create textures."));
@@ -36,6 +36,13 @@ public:
 
 	void RebuildFontAtlas();
 
+	// Whether ImGui frames are built and shown in at least one game viewport.
+	bool IsUIActive() const;
+
+	// Switch to headless mode: stop ticking, drop widgets and stop adding them to new viewports. Meant for startup,
+	// before the first frame is built; there is no way back.
+	void EnterHeadless();
+
 private:
 
 	FImGuiModuleManager();
@@ -63,6 +70,7 @@ private:
 
 	void AddWidgetToViewport(UGameViewportClient* GameViewport);
 	void AddWidgetsToActiveViewports();
+	void RemoveWidgetsFromViewports();
 
 	void OnContextProxyCreated(int32 ContextIndex, FImGuiContextProxy& ContextProxy);
 
@@ -4,10 +4,57 @@
 
 #include <Engine/Texture2D.h>
 #include <Framework/Application/SlateApplication.h>
+#include <Misc/ScopeLock.h>
 
 #include <algorithm>
 
 
+// Upper limit for uploads waiting for the render thread. If it lags behind that much, new updates are dropped rather
+// than queued, so memory stays bounded even with many streaming textures.
+constexpr int32 MaxStagingBuffersInFlight = 256;
+
+struct FTextureManager::FStagingPool
+{
+	struct FBuffer
+	{
+		TArray<uint8> Data;
+		FUpdateTextureRegion2D Region;
+	};
+
+	~FStagingPool()
+	{
+		for (FBuffer* Buffer : FreeBuffers)
+		{
+			delete Buffer;
+		}
+	}
+
+	FBuffer* Acquire()
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (InFlight >= MaxStagingBuffersInFlight)
+		{
+			return nullptr;
+		}
+		InFlight++;
+		return FreeBuffers.Num() > 0 ? FreeBuffers.Pop() : new FBuffer();
+	}
+
+	void Release(FBuffer* Buffer)
+	{
+		FScopeLock Lock(&CriticalSection);
+		InFlight--;
+		FreeBuffers.Add(Buffer);
+	}
+
+private:
+
+	FCriticalSection CriticalSection;
+	TArray<FBuffer*> FreeBuffers;
+	int32 InFlight = 0;
+};
+
+
 void FTextureManager::InitializeErrorTexture(const FColor& Color)
 {
 	CreatePlainTextureInternal(NAME_ErrorTexture, 2, 2, Color);
@@ -36,10 +83,84 @@ TextureIndex FTextureManager::CreateTextureResources(const FName& Name, UTexture
 	return AddTextureEntry(Name, Texture, false);
 }
 
+TextureIndex FTextureManager::CreateStreamingTexture(const FName& Name, int32 Width, int32 Height)
+{
+	return CreatePlainTexture(Name, Width, Height, FColor::Black);
+}
+
+bool FTextureManager::UpdateTexture(TextureIndex Index, int32 Width, int32 Height, uint32 SrcPitch, const uint8* SrcData)
+{
+	constexpr uint32 Bpp = 4;
+	checkf(SrcData, TEXT("Null source data."));
+	checkf(SrcPitch >= Width * Bpp, TEXT("Source pitch %u is too small for a row of %d pixels."), SrcPitch, Width);
+
+	if (!IsValidTexture(Index))
+	{
+		return false;
+	}
+
+	UTexture2D* Texture = Cast<UTexture2D>(TextureResources[Index].GetOwnedTexture());
+	if (!Texture)
+	{
+		return false;
+	}
+
+	// Resizing needs a new texture. Name lookup keeps the index, so handles remain valid.
+	if (Texture->GetSizeX() != Width || Texture->GetSizeY() != Height)
+	{
+		const FName Name = TextureResources[Index].GetName();
+		CreatePlainTextureInternal(Name, Width, Height, FColor::Black);
+		Texture = Cast<UTexture2D>(TextureResources[Index].GetOwnedTexture());
+	}
+
+	if (!StagingPool.IsValid())
+	{
+		StagingPool = MakeShared<FStagingPool, ESPMode::ThreadSafe>();
+	}
+
+	FStagingPool::FBuffer* Buffer = StagingPool->Acquire();
+	if (!Buffer)
+	{
+		return false;
+	}
+
+	// Tightly pack rows, so a matching pitch can be copied at once.
+	const uint32 DstPitch = Width * Bpp;
+	Buffer->Data.SetNumUninitialized(DstPitch * Height);
+	if (SrcPitch == DstPitch)
+	{
+		FMemory::Memcpy(Buffer->Data.GetData(), SrcData, DstPitch * Height);
+	}
+	else
+	{
+		for (int32 Row = 0; Row < Height; Row++)
+		{
+			FMemory::Memcpy(Buffer->Data.GetData() + Row * DstPitch, SrcData + Row * SrcPitch, DstPitch);
+		}
+	}
+	Buffer->Region = FUpdateTextureRegion2D(0, 0, 0, 0, Width, Height);
+
+	// Cleanup runs on the render thread after the upload. Pool is shared, so it outlives this manager if needed.
+	auto ReturnToPool = [Pool = StagingPool, Buffer](uint8*, const FUpdateTextureRegion2D*)
+	{
+		Pool->Release(Buffer);
+	};
+	Texture->UpdateTextureRegions(0, 1u, &Buffer->Region, DstPitch, Bpp, Buffer->Data.GetData(), ReturnToPool);
+
+	return true;
+}
+
 void FTextureManager::ReleaseTextureResources(TextureIndex Index)
 {
 	checkf(IsInRange(Index), TEXT("Invalid texture index %d. Texture resources array has %d entries total."), Index, TextureResources.Num());
 
+	// Entries that are already released are in the free list.
+	if (IsValidTexture(Index))
+	{
+		TextureIndices.Remove(TextureResources[Index].GetName());
+		FreeIndices.Add(Index);
+	}
+
 	TextureResources[Index] = {};
 }
 
@@ -92,22 +213,24 @@ TextureIndex FTextureManager::AddTextureEntry(const FName& Name, UTexture* Textu
 	// Try to find an entry with that name.
 	TextureIndex Index = FindTextureIndex(Name);
 
-	// If this is a new name, try to find an entry to reuse.
-	if (Index == INDEX_NONE)
+	// If this is a new name, try to reuse a released entry.
+	if (Index == INDEX_NONE && FreeIndices.Num() > 0)
 	{
-		Index = FindTextureIndex(NAME_None);
+		Index = FreeIndices.Pop();
 	}
 
 	// Either update/reuse an entry or add a new one.
 	if (Index != INDEX_NONE)
 	{
 		TextureResources[Index] = { Name, Texture, bAddToRoot };
-		return Index;
 	}
 	else
 	{
-		return TextureResources.Emplace(Name, Texture, bAddToRoot);
+		Index = TextureResources.Emplace(Name, Texture, bAddToRoot);
 	}
+
+	TextureIndices.Add(Name, Index);
+	return Index;
 }
 
 FTextureManager::FTextureEntry::FTextureEntry(const FName& InName, UTexture* InTexture, bool bAddToRoot)
@@ -41,7 +41,8 @@ public:
 	// @returns The index of a texture with given name or INDEX_NONE if there is no such texture
 	TextureIndex FindTextureIndex(const FName& Name) const
 	{
-		return TextureResources.IndexOfByPredicate([&](const auto& Entry) { return Entry.GetName() == Name; });
+		const TextureIndex* Index = TextureIndices.Find(Name);
+		return Index ? *Index : INDEX_NONE;
 	}
 
 	// Get the name of a texture at given index. Returns NAME_None, if index is out of range.
@@ -96,6 +97,26 @@ public:
 	// @returns The index to created/updated texture resources
 	TextureIndex CreateTextureResources(const FName& Name, UTexture* Texture);
 
+	// Create a texture that is meant to be updated from CPU memory with UpdateTexture.
+	// @param Name - The texture name
+	// @param Width - The texture width
+	// @param Height - The texture height
+	// @returns The index of a texture that was created
+	TextureIndex CreateStreamingTexture(const FName& Name, int32 Width, int32 Height);
+
+	// Update a texture owned by this manager (created with CreateTexture, CreatePlainTexture or CreateStreamingTexture)
+	// from a CPU buffer. Source pixels are copied to a pooled staging buffer and uploaded on the render thread, keeping
+	// the texture object and its Slate resources. If the size is different, the texture is recreated under the same
+	// name and index first.
+	// @param Index - The index of a texture
+	// @param Width - The source width
+	// @param Height - The source height
+	// @param SrcPitch - The size in bytes of one source row (at least Width * 4)
+	// @param SrcData - The source data in BGRA8 format, not referenced after this call
+	// @returns True, if update was queued and false, if index doesn't point to an owned texture or if too many uploads
+	// are still in flight (in which case caller can simply try again with the next frame)
+	bool UpdateTexture(TextureIndex Index, int32 Width, int32 Height, uint32 SrcPitch, const uint8* SrcData);
+
 	// Release resources for given texture. Ignores invalid indices.
 	// @param Index - The index of a texture resources
 	void ReleaseTextureResources(TextureIndex Index);
@@ -151,6 +172,9 @@ private:
 		const FSlateResourceHandle& GetResourceHandle() const;
 		UTexture* GetTexture() const { return Cast<UTexture>(Brush.GetResourceObject()); }
 
+		// Texture created by the manager (null for textures managed externally).
+		UTexture* GetOwnedTexture() const { return Texture.Get(); }
+
 	private:
 
 		void Reset(bool bReleaseResources);
@@ -161,9 +185,18 @@ private:
 		FSlateBrush Brush;
 	};
 
+	// Staging buffers shared with render thread commands, which return them after upload.
+	struct FStagingPool;
+
 	TArray<FTextureEntry> TextureResources;
 	FTextureEntry ErrorTexture;
 
+	// Name lookup and released entries that can be reused.
+	TMap<FName, TextureIndex> TextureIndices;
+	TArray<TextureIndex> FreeIndices;
+
+	TSharedPtr<FStagingPool, ESPMode::ThreadSafe> StagingPool;
+
 	static constexpr EName NAME_ErrorTexture = NAME_None;
 	static constexpr TextureIndex INDEX_ErrorTexture = INDEX_NONE;
 };
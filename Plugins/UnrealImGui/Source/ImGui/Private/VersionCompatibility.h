@@ -35,3 +35,6 @@
 #define ENGINE_COMPATIBILITY_LEGACY_KEY_AXIS_API        BELOW_ENGINE_VERSION(4, 26)
 
 #define ENGINE_COMPATIBILITY_LEGACY_VECTOR2F            BELOW_ENGINE_VERSION(5, 0)
+
+// Starting from version 5.4, TArray resizing functions take EAllowShrinking instead of a bool.
+#define ENGINE_COMPATIBILITY_LEGACY_ALLOW_SHRINKING     BELOW_ENGINE_VERSION(5, 4)
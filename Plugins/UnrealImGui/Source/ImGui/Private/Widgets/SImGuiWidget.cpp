@@ -137,6 +137,8 @@ SImGuiWidget::~SImGuiWidget()
 	if (auto* ContextProxy = ModuleManager->GetContextManager().GetContextProxy(ContextIndex))
 	{
 #if IMGUI_WIDGET_DEBUG
+		// A worker frame may still be drawing our debug windows.
+		FImGuiContextProxy::WaitForAsyncFrames();
 		ContextProxy->OnDraw().RemoveAll(this);
 #endif // IMGUI_WIDGET_DEBUG
 	}
@@ -656,23 +658,25 @@ int32 SImGuiWidget::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeo
 
 		for (const auto& DrawList : ContextProxy->GetDrawData())
 		{
+			// Consecutive commands with the same texture and clipping rectangle are submitted as one element, with
+			// only the vertices that its indices reference.
+			DrawList.GetBatches(DrawBatches, ImGuiToScreen);
+
+			for (const FImGuiDrawBatch& DrawBatch : DrawBatches)
+			{
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
-			DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen, VertexClippingRect);
+				DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen, VertexClippingRect, DrawBatch.FirstVertex, DrawBatch.NumVertices);
 #else
-			DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen);
+				DrawList.CopyVertexData(VertexBuffer, ImGuiToScreen, DrawBatch.FirstVertex, DrawBatch.NumVertices);
 #endif // ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 
-			for (int CommandNb = 0; CommandNb < DrawList.NumCommands(); CommandNb++)
-			{
-				const auto& DrawCommand = DrawList.GetCommand(CommandNb, ImGuiToScreen);
-
-				DrawList.CopyIndexData(IndexBuffer, DrawCommand.IndexOffset, DrawCommand.NumElements);
+				DrawList.CopyIndexData(IndexBuffer, DrawBatch.IndexOffset, DrawBatch.NumElements, DrawBatch.BaseVertex);
 
-				// Get texture resource handle for this draw command (null index will be also mapped to a valid texture).
-				const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(DrawCommand.TextureId);
+				// Get texture resource handle for this batch (null index will be also mapped to a valid texture).
+				const FSlateResourceHandle& Handle = ModuleManager->GetTextureManager().GetTextureHandle(DrawBatch.TextureId);
 
 				// Transform clipping rectangle to screen space and apply to elements that we draw.
-				const FSlateRect ClippingRect = DrawCommand.ClippingRect.IntersectionWith(MyClippingRect);
+				const FSlateRect ClippingRect = DrawBatch.ClippingRect.IntersectionWith(MyClippingRect);
 
 #if ENGINE_COMPATIBILITY_LEGACY_CLIPPING_API
 				// Get access to the Slate scissor rectangle defined in Slate Core API, so we can customize elements drawing.
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "ImGuiDrawData.h"
 #include "ImGuiModuleDebug.h"
 #include "ImGuiModuleSettings.h"
 
@@ -137,6 +138,7 @@ private:
 	FSlateRenderTransform ImGuiTransform;
 	FSlateRenderTransform ImGuiRenderTransform;
 
+	mutable TArray<FImGuiDrawBatch> DrawBatches;
 	mutable TArray<FSlateVertex> VertexBuffer;
 	mutable TArray<SlateIndex> IndexBuffer;
 
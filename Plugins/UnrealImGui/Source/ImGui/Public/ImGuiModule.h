@@ -134,6 +134,30 @@ public:
 	 */
 	virtual void ReleaseTexture(const FImGuiTextureHandle& Handle);
 
+	/**
+	 * Create a texture owned by the module that can be updated from CPU memory with UpdateTexture (e.g. camera images).
+	 * If texture with that name already exists, its resources are replaced. Returns a null handle in headless mode.
+	 *
+	 * @param Name - Resource name for the texture
+	 * @param Width - Initial texture width
+	 * @param Height - Initial texture height
+	 * @returns Handle to the texture resources
+	 */
+	virtual FImGuiTextureHandle CreateStreamingTexture(const FName& Name, int32 Width, int32 Height);
+
+	/**
+	 * Update a texture created with CreateStreamingTexture. Pixels are copied before returning and uploaded on the
+	 * render thread through pooled staging buffers; the Slate resources stay the same unless the size changes.
+	 *
+	 * @param Handle - Handle returned by CreateStreamingTexture
+	 * @param Width - Source width
+	 * @param Height - Source height
+	 * @param SrcPitch - Size in bytes of one source row (at least Width * 4)
+	 * @param SrcData - Source pixels in BGRA8 format
+	 * @returns True, if update was queued and false, if handle is not valid or uploads are falling behind
+	 */
+	virtual bool UpdateTexture(const FImGuiTextureHandle& Handle, int32 Width, int32 Height, uint32 SrcPitch, const uint8* SrcData);
+
 	virtual void RebuildFontAtlas();
 
 	/**
@@ -144,6 +168,21 @@ public:
 	virtual FImGuiModuleProperties& GetProperties();
 	virtual const FImGuiModuleProperties& GetProperties() const;
 
+	/**
+	 * Check whether ImGui output can currently be seen, i.e. the module is not headless and at least one ImGui widget is
+	 * attached to a game viewport. Code that builds UI every frame can use it to skip that work when nobody looks.
+	 *
+	 * @returns True, if ImGui frames are being built and displayed.
+	 */
+	virtual bool IsUIActive() const;
+
+	/**
+	 * Switch the module to headless mode, as if it was started with -ImGuiHeadless. Contexts stop ticking, no widgets
+	 * are added to viewports and the font atlas is never built. Intended for game modules that decide at startup that
+	 * they run without UI; there is no way to leave headless mode.
+	 */
+	virtual void EnterHeadlessMode();
+
 	/**
 	 * DEPRECIATED: Please use GetProperties() as this function is scheduled for removal.
 	 * Check whether Input Mode is enabled (tests ImGui.InputEnabled console variable).
@@ -72,6 +72,26 @@ public:
 	/** Toggle ImGui demo. */
 	void ToggleDemo() { SetShowDemo(!ShowDemo()); }
 
+	/**
+	 * Check whether ImGui frames are built on a worker thread (enabled with -ImGuiAsyncFrames). In that mode draw
+	 * delegates are called on the worker and must only read state that is safe to share, e.g. a snapshot published by
+	 * the game thread. ImGui must not be called from the game thread outside of those delegates.
+	 */
+	bool IsAsyncFramesEnabled() const { return bAsyncFrames; }
+
+	/** Enable or disable async frames. This is a startup option, changing it while worlds are running is not supported. */
+	void SetAsyncFramesEnabled(bool bEnabled) { bAsyncFrames = bEnabled; }
+
+	/**
+	 * Check whether the module runs headless. That is the case when nothing can be rendered (-nullrhi, dedicated
+	 * server) or when requested with -ImGuiHeadless. Headless module never ticks contexts or creates widgets, so game
+	 * code must not call ImGui (@see FImGuiModule::IsUIActive).
+	 */
+	bool IsHeadless() const { return bHeadless; }
+
+	/** Set headless mode. This is a startup option, changing it after the module is initialized has no effect (@see FImGuiModule::EnterHeadlessMode). */
+	void SetHeadless(bool bInHeadless) { bHeadless = bInHeadless; }
+
 	/** Adds a new font to initialize */
 	void AddCustomFont(FName FontName, TSharedPtr<ImFontConfig> Font) { CustomFonts.Emplace(FontName, Font); }
 
@@ -94,5 +114,9 @@ private:
 
 	bool bShowDemo = false;
 
+	bool bAsyncFrames = false;
+
+	bool bHeadless = false;
+
 	TMap<FName, TSharedPtr<ImFontConfig>> CustomFonts;
 };
@@ -6,8 +6,14 @@
 #include "DrawDebugHelpers.h"
 #include "Core/DroneGlobalState.h"
 #include "UI/ImGuiUtil.h"
+#include "UI/AsyncHud.h"
 #include "Core/DroneJSONConfig.h"
 #include "Core/DroneManager.h"
+#include "Utility/FlightRecorder.h"
+#include "Utility/SimProfiler.h"
+#include "Core/DomainRandomizer.h"
+#include "Core/SimClock.h"
+#include "Core/RunProfile.h"
 #include "Kismet/GameplayStatics.h"
 #include "Math/UnrealMathUtility.h"
 
@@ -33,43 +39,48 @@ UQuadDroneController::UQuadDroneController(const FObjectInitializer& ObjectIniti
 	, initialDronePosition(FVector::ZeroVector)
 	, bHoverModeActive(false)
 	, hoverTargetAltitude(0.0f)
+	, Profile(nullptr)
+	, BatteryVoltage(0.0f)
+	, RecorderDroneIndex(0)
+	, ControlStep(0)
+	, ProfilerDroneSlot(INDEX_NONE)
+	, LastStepVelocity(FVector::ZeroVector)
+	, CommandMailboxes(MakeShared<FDroneCommandMailboxes, ESPMode::ThreadSafe>())
+	, bAttitudeMode(false)
+	, AttitudeTarget(FRotator::ZeroRotator)
+	, AttitudeThrust(1.0f)
+	, BaseMassKg(0.0f)
+	, MotorConstantScale(1.0f)
+	, WindAcceleration(FVector::ZeroVector)
+	, WindGustStdDev(0.0f)
+	, PositionNoiseStdDev(0.0f)
+	, VelocityNoiseStdDev(0.0f)
 {
-	const auto& Config = UDroneJSONConfig::Get().Config;
+	const FDroneConfigData& Config = UDroneJSONConfig::GetConfigFor(*this);
 	maxPIDOutput = Config.FlightParams.MaxPIDOutput;
 	acceptableDistance = Config.FlightParams.AcceptableDistance;
   
+    // Gains and limits come from the airframe profile in ApplyConfig
     FFullPIDSet VelocitySet;
     VelocitySet.XPID = new QuadPIDController();
-    VelocitySet.XPID->SetLimits(-maxPIDOutput, maxPIDOutput);
-    VelocitySet.XPID->SetGains(1.f, 0.f, 0.1f);
-
     VelocitySet.YPID = new QuadPIDController();
-    VelocitySet.YPID->SetLimits(-maxPIDOutput, maxPIDOutput);
-    VelocitySet.YPID->SetGains(1.f, 0.f, 0.1f);
-
     VelocitySet.ZPID = new QuadPIDController();
-    VelocitySet.ZPID->SetLimits(-maxPIDOutput, maxPIDOutput);
-    VelocitySet.ZPID->SetGains(5.f, 1.f, 0.1f);
-
     VelocitySet.RollPID = new QuadPIDController();
-    VelocitySet.RollPID->SetLimits(-maxPIDOutput, maxPIDOutput);
-    VelocitySet.RollPID->SetGains(4.75f, 0.3f, 2.347f);
-
     VelocitySet.PitchPID = new QuadPIDController();
-    VelocitySet.PitchPID->SetLimits(-maxPIDOutput, maxPIDOutput);
-    VelocitySet.PitchPID->SetGains(4.75f, 0.3f, 2.347f);
-
     VelocitySet.YawPID = new QuadPIDController();
-    VelocitySet.YawPID->SetLimits(-maxPIDOutput, maxPIDOutput);
-    VelocitySet.YawPID->SetGains(0.f, 0.f, 0.f);
 	PIDMap.Add(VelocitySet);
 
+	ApplyConfig(Config);
 	
 	DroneGlobalState::Get().BindController(this);
 }
 
 UQuadDroneController::~UQuadDroneController()
 {
+	if (ConfigChangedHandle.IsValid())
+	{
+		UDroneJSONConfig::Get().OnConfigChanged().Remove(ConfigChangedHandle);
+	}
 	DroneGlobalState::Get().UnbindController();
 }
 
@@ -89,13 +100,26 @@ void UQuadDroneController::Initialize(AQuadPawn* InPawn)
 		dronePawn = InPawn;
 	}
 
+	// Only live controllers follow config reloads; the CDO never gets initialized
+	UDroneJSONConfig& ConfigObject = UDroneJSONConfig::Get();
+	if (!ConfigChangedHandle.IsValid())
+	{
+		ConfigChangedHandle = ConfigObject.OnConfigChanged().AddUObject(this, &UQuadDroneController::ApplyConfig);
+	}
+
+	// Now that the pawn (and its DroneID) is known, pick up any per-drone profile
+	ApplyConfig(ConfigObject.GetConfig());
 
+	RecorderDroneIndex = FFlightRecorder::Get().RegisterDrone(InPawn->DroneID);
+	ProfilerDroneSlot = FSimProfiler::Get().GetDroneSlot(InPawn->DroneID);
+	ControlStep = 0;
 }
 
 // ---------------------- Update ------------------------
 
 void UQuadDroneController::Update(double a_deltaTime)
 {
+	FSimScopedTimer Timer(ESimPhase::Control, ProfilerDroneSlot);
 	VelocityControl(a_deltaTime);
 }
 
@@ -105,6 +129,8 @@ void UQuadDroneController::VelocityControl(double a_deltaTime)
     FFullPIDSet* CurrentSet = GetPIDSet();
     if (!CurrentSet || !dronePawn)
         return;
+
+    ConsumeExternalCommands();
     
     FVector currentPosition = dronePawn->GetActorLocation();
     FVector currentVelocity = dronePawn->GetVelocity();
@@ -138,6 +164,23 @@ void UQuadDroneController::VelocityControl(double a_deltaTime)
     
 	
     if (!bManualThrustMode)
+    {
+        // Both modes run the roll/pitch PIDs, so both get their scheduled gains
+        ApplyGainSchedules(currentVelocity, currentPosition);
+    }
+
+    if (!bManualThrustMode && bAttitudeMode)
+    {
+        roll_output = CurrentSet->RollPID->Calculate(AttitudeTarget.Roll - currentRotation.Roll, a_deltaTime);
+        pitch_output = CurrentSet->PitchPID->Calculate(AttitudeTarget.Pitch - currentRotation.Pitch, a_deltaTime);
+
+        // Inverse of ThrustMixer's collective mapping, so a thrust of 1 is exactly the hover thrust
+        z_output = (AttitudeThrust - 1.0f) / 0.8f * maxPIDOutput;
+        desiredForwardVector = FRotator(0.0f, AttitudeTarget.Yaw, 0.0f).Vector();
+
+        ThrustMixer(0.0, 0.0, z_output, roll_output, pitch_output);
+    }
+    else if (!bManualThrustMode)
     {
         FVector velocityError = desiredNewVelocity - currentVelocity;
         x_output = CurrentSet->XPID->Calculate(velocityError.X, a_deltaTime);
@@ -160,7 +203,7 @@ void UQuadDroneController::VelocityControl(double a_deltaTime)
     		desiredYaw = normalizedDesiredYaw;
         
     		// Debug info
-    		UE_LOG(LogTemp, Display, TEXT("Velocity Direction: X=%.2f, Y=%.2f, DesiredForward: X=%.2f, Y=%.2f"),
+    		UE_LOG(LogTemp, Verbose, TEXT("Velocity Direction: X=%.2f, Y=%.2f, DesiredForward: X=%.2f, Y=%.2f"),
 				  horizontalVelocity.X, horizontalVelocity.Y, desiredForwardVector.X, desiredForwardVector.Y);
     	}
     
@@ -170,12 +213,29 @@ void UQuadDroneController::VelocityControl(double a_deltaTime)
     {
         ApplyManualThrusts();
     }
+
+    ApplyWind();
     
     YawStabilization(a_deltaTime);
-	DrawDebugVisuals(horizontalVelocity);
+	if (FRunProfile::Get().WantsDebugDraw())
+	{
+		DrawDebugVisuals(horizontalVelocity);
+	}
+
+	if (FFlightRecorder::Get().IsRecording())
+	{
+		RecordFlightStep(currentPosition, currentVelocity, currentRotation);
+	}
+	if (ControlStepEvent.IsBound())
+	{
+		BroadcastControlStep(currentPosition, currentVelocity, a_deltaTime);
+	}
+	LastStepVelocity = currentVelocity;
+	ControlStep++;
 
 
-    if (dronePawn && dronePawn->ImGuiUtil)
+    // The async HUD draws from the drone manager's snapshot instead
+    if (dronePawn && dronePawn->ImGuiUtil && !FAsyncHud::IsEnabled() && UImGuiUtil::IsUIActive())
     {
         ADroneManager* Manager = Cast<ADroneManager>(UGameplayStatics::GetActorOfClass(dronePawn->GetWorld(), ADroneManager::StaticClass()));
         if (Manager)
@@ -185,6 +245,7 @@ void UQuadDroneController::VelocityControl(double a_deltaTime)
             AQuadPawn* selectedPawn = (DroneList.IsValidIndex(idx)) ? DroneList[idx] : nullptr;
             if (dronePawn == selectedPawn)
             {
+                FSimScopedTimer UITimer(ESimPhase::UI);
                 dronePawn->ImGuiUtil->VelocityHud(Thrusts, roll_output, pitch_output, currentRotation,FVector::ZeroVector, currentPosition, FVector::ZeroVector,currentVelocity, x_output, y_output, z_output, a_deltaTime);
             	//FVector currentForwardVector = dronePawn->GetActorForwardVector();
             	//dronePawn->ImGuiUtil->RenderImPlot(Thrusts, desiredForwardVector, currentForwardVector, a_deltaTime);
@@ -222,7 +283,7 @@ void UQuadDroneController::ThrustMixer(double xOutput, double yOutput, double zO
 	{
 		if (!dronePawn || !dronePawn->Thrusters.IsValidIndex(i))
 			continue;
-		double force = droneMass * 0.5f * Thrusts[i];
+		double force = droneMass * 0.5f * Thrusts[i] * MotorConstantScale;
 		dronePawn->Thrusters[i]->ApplyForce(force);
 	}
 }
@@ -375,12 +436,18 @@ void UQuadDroneController::ResetDroneHigh()
 		// Reset controller states
 		ResetPID();
 		desiredNewVelocity = FVector::ZeroVector;
+		bAttitudeMode = false;
 		initialTakeoff = true;
 		altitudeReached = false;
 	}
 }
 
 void UQuadDroneController::ResetDroneOrigin()
+{
+	ResetDroneTo(FVector(0.0f, 0.0f, 10.0f), FRotator::ZeroRotator);
+}
+
+void UQuadDroneController::ResetDroneTo(const FVector& Location, const FRotator& Rotation)
 {
 	if (dronePawn)
 	{
@@ -390,9 +457,8 @@ void UQuadDroneController::ResetDroneOrigin()
 			dronePawn->DroneBody->SetSimulatePhysics(false);
 		}
 
-		// Reset position and rotation
-		dronePawn->SetActorLocation(FVector(0.0f, 0.0f, 10.0f), false, nullptr, ETeleportType::TeleportPhysics);
-		dronePawn->SetActorRotation(FRotator::ZeroRotator);
+		// Reset position and rotation in a single teleport
+		dronePawn->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
 
 		if (dronePawn->DroneBody)
 		{
@@ -410,6 +476,7 @@ void UQuadDroneController::ResetDroneOrigin()
 		// Reset controller states
 		ResetPID();
 		desiredNewVelocity = FVector::ZeroVector;
+		bAttitudeMode = false;
 		desiredYaw = 0.0f;
 		desiredForwardVector = FVector(1.0f, 0.0f, 0.0f);  // Reset to forward direction
 		initialTakeoff = true;
@@ -417,6 +484,59 @@ void UQuadDroneController::ResetDroneOrigin()
 	}
 }
 
+void UQuadDroneController::ApplyRandomization(const FDroneRandomization& Randomization)
+{
+	if (!dronePawn || !dronePawn->DroneBody)
+		return;
+
+	ResetDroneTo(Randomization.SpawnLocation, Randomization.SpawnRotation);
+
+	UStaticMeshComponent* Body = dronePawn->DroneBody;
+	if (BaseMassKg <= 0.0f)
+	{
+		BaseMassKg = Body->GetMass();
+	}
+
+	// The mass override recomputes mass properties, which picks up the inertia scale as well
+	if (FBodyInstance* BodyInstance = Body->GetBodyInstance())
+	{
+		BodyInstance->InertiaTensorScale = FVector(Randomization.InertiaScale);
+	}
+	Body->SetMassOverrideInKg(NAME_None, BaseMassKg * Randomization.MassScale, true);
+
+	MotorConstantScale = Randomization.MotorConstantScale;
+	WindAcceleration = Randomization.WindAcceleration;
+	WindGustStdDev = Randomization.WindGustStdDev;
+	PositionNoiseStdDev = Randomization.PositionNoiseStdDev;
+	VelocityNoiseStdDev = Randomization.VelocityNoiseStdDev;
+	GustStream.Initialize(Randomization.GustSeed);
+	NoiseStream.Initialize(Randomization.NoiseSeed);
+}
+
+void UQuadDroneController::ApplyWind()
+{
+	if (!dronePawn || !dronePawn->DroneBody || !dronePawn->DroneBody->IsSimulatingPhysics())
+		return;
+	if (WindAcceleration.IsZero() && WindGustStdDev <= 0.0f)
+		return;
+
+	FVector Acceleration = WindAcceleration;
+	if (WindGustStdDev > 0.0f)
+	{
+		Acceleration.X += FDomainRandomizer::Gaussian(GustStream) * WindGustStdDev;
+		Acceleration.Y += FDomainRandomizer::Gaussian(GustStream) * WindGustStdDev;
+	}
+	dronePawn->DroneBody->AddForce(Acceleration, NAME_None, true);
+}
+
+FVector UQuadDroneController::AddSensorNoise(const FVector& Value, float StdDev)
+{
+	if (StdDev <= 0.0f)
+		return Value;
+
+	return Value + FVector(FDomainRandomizer::Gaussian(NoiseStream), FDomainRandomizer::Gaussian(NoiseStream), FDomainRandomizer::Gaussian(NoiseStream)) * StdDev;
+}
+
 
 // ---------------------- Helper Functions ------------------------
 
@@ -489,19 +609,204 @@ void UQuadDroneController::ApplyManualThrusts()
 		Thrusts[i] = FMath::Clamp(Thrusts[i], 0.0f, 700.0f);
 		if (!dronePawn->Thrusters.IsValidIndex(i))
 			continue;
-		float force = droneMass * mult * Thrusts[i];
+		float force = droneMass * mult * Thrusts[i] * MotorConstantScale;
 		dronePawn->Thrusters[i]->ApplyForce(force);
 	}
 }
 
 // ------------ Setter and Getter -------------------
+void UQuadDroneController::ApplyConfig(const FDroneConfigData& Config)
+{
+	Profile = &Config.GetProfile(dronePawn ? dronePawn->DroneID : FString());
+
+	const FDroneConfigData::FFlightParameters& FlightParams = Profile->FlightParams;
+	maxVelocity = FlightParams.MaxVelocity;
+	maxAngle = FlightParams.MaxAngle;
+	maxPIDOutput = FlightParams.MaxPIDOutput;
+	altitudeThresh = FlightParams.AltitudeThreshold;
+	minAltitudeLocal = FlightParams.MinAltitudeLocal;
+	acceptableDistance = FlightParams.AcceptableDistance;
+	BatteryVoltage = Profile->NominalBatteryVoltage;
+
+	for (FFullPIDSet& ThisSet : PIDMap)
+	{
+		for (int32 Axis = 0; Axis < static_cast<int32>(EPIDAxis::Count); Axis++)
+		{
+			if (QuadPIDController* PID = ThisSet.GetAxis(static_cast<EPIDAxis>(Axis)))
+			{
+				const FPIDGains& Gains = Profile->Gains[Axis];
+				PID->SetLimits(-maxPIDOutput, maxPIDOutput);
+				PID->SetGains(Gains.P, Gains.I, Gains.D);
+			}
+		}
+	}
+}
+
+EGainScheduleVariable UQuadDroneController::GetGainScheduleVariable(EPIDAxis Axis) const
+{
+	if (!Profile)
+		return EGainScheduleVariable::None;
+
+	const FGainScheduleTable& Schedule = Profile->Schedules[static_cast<int32>(Axis)];
+	return Schedule.IsActive() ? Schedule.Variable : EGainScheduleVariable::None;
+}
+
+void UQuadDroneController::ApplyGainSchedules(const FVector& CurrentVelocity, const FVector& CurrentPosition)
+{
+	FFullPIDSet* CurrentSet = GetPIDSet();
+	if (!Profile || !CurrentSet)
+		return;
+
+	for (int32 Axis = 0; Axis < static_cast<int32>(EPIDAxis::Count); Axis++)
+	{
+		const FGainScheduleTable& Schedule = Profile->Schedules[Axis];
+		QuadPIDController* PID = CurrentSet->GetAxis(static_cast<EPIDAxis>(Axis));
+		if (!Schedule.IsActive() || !PID)
+			continue;
+
+		float Input = 0.0f;
+		switch (Schedule.Variable)
+		{
+		case EGainScheduleVariable::GroundSpeed:    Input = CurrentVelocity.Size(); break;
+		case EGainScheduleVariable::Altitude:       Input = CurrentPosition.Z; break;
+		case EGainScheduleVariable::BatteryVoltage: Input = BatteryVoltage; break;
+		default: break;
+		}
+
+		// Set the gains directly so the derivative filter coefficient is left alone
+		const FPIDGains Gains = Schedule.Evaluate(Input);
+		PID->ProportionalGain = Gains.P;
+		PID->IntegralGain = Gains.I;
+		PID->DerivativeGain = Gains.D;
+	}
+}
+
+void UQuadDroneController::RecordFlightStep(const FVector& CurrentPosition, const FVector& CurrentVelocity, const FRotator& CurrentRotation)
+{
+	FFlightRecord Record;
+	FMemory::Memzero(Record);
+
+	Record.Step = ControlStep;
+	Record.SimTime = FSimClock::Get().GetSimSeconds();
+	Record.DroneIndex = RecorderDroneIndex;
+	Record.Flags = (bManualThrustMode ? FFlightRecord::ManualThrust : 0) | (bHoverModeActive ? FFlightRecord::HoverMode : 0);
+
+	const FVector AngularVelocity = dronePawn->DroneBody ? dronePawn->DroneBody->GetPhysicsAngularVelocityInDegrees() : FVector::ZeroVector;
+	for (int32 i = 0; i < 3; i++)
+	{
+		Record.Position[i] = CurrentPosition[i];
+		Record.Velocity[i] = CurrentVelocity[i];
+		Record.AngularVelocity[i] = AngularVelocity[i];
+		Record.DesiredVelocity[i] = desiredNewVelocity[i];
+	}
+	Record.Rotation[0] = CurrentRotation.Roll;
+	Record.Rotation[1] = CurrentRotation.Pitch;
+	Record.Rotation[2] = CurrentRotation.Yaw;
+	Record.DesiredYaw = desiredYaw;
+
+	// In manual thrust mode the PIDs are not stepped, so these hold their last computed values
+	if (const FFullPIDSet* CurrentSet = GetPIDSet())
+	{
+		for (int32 Axis = 0; Axis < static_cast<int32>(EPIDAxis::Count); Axis++)
+		{
+			if (const QuadPIDController* PID = CurrentSet->GetAxis(static_cast<EPIDAxis>(Axis)))
+			{
+				Record.PIDOutput[Axis] = PID->lastOutput;
+				Record.PIDTerms[Axis][0] = PID->lastPTerm;
+				Record.PIDTerms[Axis][1] = PID->lastITerm;
+				Record.PIDTerms[Axis][2] = PID->lastDTerm;
+			}
+		}
+	}
+
+	for (int32 i = 0; i < 4 && i < Thrusts.Num(); i++)
+	{
+		Record.Thrusts[i] = Thrusts[i];
+	}
+
+	FFlightRecorder::Get().Record(Record);
+}
+
+void UQuadDroneController::BroadcastControlStep(const FVector& CurrentPosition, const FVector& CurrentVelocity, double DeltaTime)
+{
+	UWorld* World = dronePawn->GetWorld();
+
+	FDroneStateSample Sample;
+	Sample.Step = ControlStep;
+	Sample.SimTime = FSimClock::Get().GetSimSeconds();
+	Sample.Position = CurrentPosition;
+	Sample.Velocity = CurrentVelocity;
+	Sample.Orientation = dronePawn->GetActorQuat();
+	Sample.AngularVelocity = dronePawn->DroneBody ? dronePawn->DroneBody->GetPhysicsAngularVelocityInRadians() : FVector::ZeroVector;
+
+	// Finite difference over the step, minus gravity, so a hovering drone reads +g up like a real IMU
+	const FVector Acceleration = (ControlStep > 0 && DeltaTime > 0.0) ? (CurrentVelocity - LastStepVelocity) / DeltaTime : FVector::ZeroVector;
+	Sample.SpecificForce = Acceleration - FVector(0.0, 0.0, World ? World->GetGravityZ() : -980.0);
+
+	for (int32 i = 0; i < 4 && i < Thrusts.Num(); i++)
+	{
+		Sample.Thrusts[i] = Thrusts[i];
+	}
+
+	ControlStepEvent.Broadcast(Sample);
+}
+
 void UQuadDroneController::SetDesiredVelocity(const FVector& NewVelocity)
 {
+	// Every command source goes through here, so a velocity command always takes over from attitude mode
+	bAttitudeMode = false;
 	desiredNewVelocity = NewVelocity;
-	UE_LOG(LogTemp, Display, TEXT("[QuadDroneController] SetDesiredVelocity called: X=%.2f, Y=%.2f, Z=%.2f"),
+	UE_LOG(LogTemp, Verbose, TEXT("[QuadDroneController] SetDesiredVelocity called: X=%.2f, Y=%.2f, Z=%.2f"),
 			NewVelocity.X, NewVelocity.Y, NewVelocity.Z);
 }
 
+void UQuadDroneController::SetAttitudeTarget(const FRotator& Attitude, float CollectiveThrust)
+{
+	bAttitudeMode = true;
+	AttitudeTarget = Attitude;
+	AttitudeThrust = FMath::Max(CollectiveThrust, 0.0f);
+}
+
+void UQuadDroneController::ConsumeExternalCommands()
+{
+	FDroneCommandMailboxes& Mailboxes = *CommandMailboxes;
+
+	// A burst since the last step has already collapsed to its newest value per mailbox
+	FDroneCommandMailboxes::FVelocity Velocity;
+	if (Mailboxes.Velocity.ConsumeLatest(Velocity))
+	{
+		if (bManualThrustMode)
+		{
+			SetManualThrustMode(false);
+		}
+		SetDesiredVelocity(Velocity.Velocity);
+	}
+
+	FDroneCommandMailboxes::FAttitude Attitude;
+	if (Mailboxes.Attitude.ConsumeLatest(Attitude))
+	{
+		if (bManualThrustMode)
+		{
+			SetManualThrustMode(false);
+		}
+		SetAttitudeTarget(Attitude.Attitude, Attitude.Thrust);
+	}
+
+	FDroneCommandMailboxes::FMotors Motors;
+	if (Mailboxes.Motors.ConsumeLatest(Motors))
+	{
+		bAttitudeMode = false;
+		if (!bManualThrustMode)
+		{
+			SetManualThrustMode(true);
+		}
+		for (int32 i = 0; i < Thrusts.Num() && i < UE_ARRAY_COUNT(Motors.Thrusts); i++)
+		{
+			Thrusts[i] = Motors.Thrusts[i];
+		}
+	}
+}
+
 void UQuadDroneController::SetManualThrustMode(bool bEnable)
 {
 	bManualThrustMode = bEnable;
@@ -0,0 +1,449 @@
+// ROS2Bridge.cpp
+#include "Controllers/ROS2Bridge.h"
+#include "Controllers/QuadDroneController.h"
+#include "Controllers/ROS2Conversions.h"
+#include "Core/CommandJournal.h"
+#include "Core/DroneManager.h"
+#include "Core/RunProfile.h"
+#include "Pawns/QuadPawn.h"
+#include "ROS2NodeComponent.h"
+#include "ROS2Publisher.h"
+#include "ROS2Subscriber.h"
+#include "Msgs/ROS2Clock.h"
+#include "Msgs/ROS2Float32MultiArray.h"
+#include "Msgs/ROS2Imu.h"
+#include "Msgs/ROS2Odom.h"
+#include "Msgs/ROS2Twist.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace
+{
+    // Journal payloads go into .qscmd files, so they are written field by field rather than as raw structs.
+    // FVelocity and FMotors have no padding; FAttitude (three doubles and a float) does.
+    void WriteJournalPayload(const FDroneCommandMailboxes::FVelocity& Command, TArray<uint8>& Data)
+    {
+        Data.Append(reinterpret_cast<const uint8*>(&Command.Velocity), sizeof(Command.Velocity));
+    }
+
+    bool ReadJournalPayload(const TArray<uint8>& Data, FDroneCommandMailboxes::FVelocity& Command)
+    {
+        if (Data.Num() != sizeof(Command.Velocity))
+        {
+            return false;
+        }
+        FMemory::Memcpy(&Command.Velocity, Data.GetData(), sizeof(Command.Velocity));
+        return true;
+    }
+
+    void WriteJournalPayload(const FDroneCommandMailboxes::FAttitude& Command, TArray<uint8>& Data)
+    {
+        // Roll, pitch, yaw in degrees, then thrust
+        const float Values[4] = { static_cast<float>(Command.Attitude.Roll), static_cast<float>(Command.Attitude.Pitch),
+            static_cast<float>(Command.Attitude.Yaw), Command.Thrust };
+        Data.Append(reinterpret_cast<const uint8*>(Values), sizeof(Values));
+    }
+
+    bool ReadJournalPayload(const TArray<uint8>& Data, FDroneCommandMailboxes::FAttitude& Command)
+    {
+        float Values[4];
+        if (Data.Num() != sizeof(Values))
+        {
+            return false;
+        }
+        FMemory::Memcpy(Values, Data.GetData(), sizeof(Values));
+        Command.Attitude = FRotator(Values[1], Values[2], Values[0]);
+        Command.Thrust = Values[3];
+        return true;
+    }
+
+    void WriteJournalPayload(const FDroneCommandMailboxes::FMotors& Command, TArray<uint8>& Data)
+    {
+        Data.Append(reinterpret_cast<const uint8*>(Command.Thrusts), sizeof(Command.Thrusts));
+    }
+
+    bool ReadJournalPayload(const TArray<uint8>& Data, FDroneCommandMailboxes::FMotors& Command)
+    {
+        if (Data.Num() != sizeof(Command.Thrusts))
+        {
+            return false;
+        }
+        FMemory::Memcpy(Command.Thrusts, Data.GetData(), sizeof(Command.Thrusts));
+        return true;
+    }
+}
+
+// ---------------------- Drone link ------------------------
+
+void UROS2DroneLink::Init(AQuadPawn* InPawn, const FString& InNamespace, UROS2NodeComponent* Node, const FROS2BridgeTopics& Topics, FROS2StatePublisher* InStatePublisher)
+{
+    Pawn = InPawn;
+    Namespace = InNamespace;
+    OdometryDecimation = Topics.OdometryDecimation;
+    ImuDecimation = Topics.ImuDecimation;
+    MotorDecimation = Topics.MotorDecimation;
+    StatePublisher = InStatePublisher;
+
+    UQuadDroneController* Controller = InPawn->QuadController;
+    CommandMailboxes = Controller->GetCommandMailboxes();
+
+    // A rate of zero creates the publishers without a loop timer; the state publisher thread publishes them
+    if (OdometryDecimation > 0)
+    {
+        ROS2_CREATE_LOOP_PUBLISHER_WITH_QOS(Node, this, Namespace / Topics.Odometry, UROS2Publisher::StaticClass(), UROS2OdomMsg::StaticClass(),
+            0, &UROS2DroneLink::UpdateStateMessage, UROS2QoS::SensorData, OdometryPublisher);
+    }
+    if (ImuDecimation > 0)
+    {
+        ROS2_CREATE_LOOP_PUBLISHER_WITH_QOS(Node, this, Namespace / Topics.Imu, UROS2Publisher::StaticClass(), UROS2ImuMsg::StaticClass(),
+            0, &UROS2DroneLink::UpdateStateMessage, UROS2QoS::SensorData, ImuPublisher);
+    }
+    if (MotorDecimation > 0)
+    {
+        ROS2_CREATE_LOOP_PUBLISHER_WITH_QOS(Node, this, Namespace / Topics.Motors, UROS2Publisher::StaticClass(), UROS2Float32MultiArrayMsg::StaticClass(),
+            0, &UROS2DroneLink::UpdateStateMessage, UROS2QoS::SensorData, MotorPublisher);
+    }
+
+    FROS2DroneStreams Streams;
+    Streams.Odometry = OdometryPublisher;
+    Streams.Imu = ImuPublisher;
+    Streams.Motors = MotorPublisher;
+    Streams.OdomFrameId = Namespace / TEXT("odom");
+    Streams.BaseFrameId = Namespace / TEXT("base_link");
+    StateHandle = StatePublisher->RegisterDrone(Streams);
+    ControlStepHandle = Controller->OnControlStep().AddUObject(this, &UROS2DroneLink::HandleControlStep);
+
+    if (!Topics.VelocityCommand.IsEmpty())
+    {
+        Subscribe(Node, Namespace / Topics.VelocityCommand, UROS2TwistMsg::StaticClass(), GET_FUNCTION_NAME_CHECKED(UROS2DroneLink, HandleVelocityCommand));
+    }
+    if (!Topics.AttitudeCommand.IsEmpty())
+    {
+        Subscribe(Node, Namespace / Topics.AttitudeCommand, UROS2Float32MultiArrayMsg::StaticClass(), GET_FUNCTION_NAME_CHECKED(UROS2DroneLink, HandleAttitudeCommand));
+    }
+    if (!Topics.MotorCommand.IsEmpty())
+    {
+        Subscribe(Node, Namespace / Topics.MotorCommand, UROS2Float32MultiArrayMsg::StaticClass(), GET_FUNCTION_NAME_CHECKED(UROS2DroneLink, HandleMotorCommand));
+    }
+
+    JournalTarget = FString::Printf(TEXT("ROS2Bridge/%s"), *Namespace);
+    FCommandJournal::Get().RegisterTarget(JournalTarget, FOnExternalCommand::CreateUObject(this, &UROS2DroneLink::DispatchCommand));
+
+    UE_LOG(LogTemp, Display, TEXT("ROS2Bridge: Connected %s"), *Namespace);
+}
+
+UROS2Subscriber* UROS2DroneLink::Subscribe(UROS2NodeComponent* Node, const FString& Topic, TSubclassOf<UROS2GenericMsg> MsgClass, FName Callback)
+{
+    FSubscriptionCallback Delegate;
+    Delegate.BindUFunction(this, Callback);
+
+    UROS2Subscriber* Subscriber = Node->CreateSubscriber(Topic, MsgClass, Delegate);
+    if (Subscriber)
+    {
+        Subscribers.Add(Subscriber);
+    }
+    return Subscriber;
+}
+
+void UROS2DroneLink::Shutdown()
+{
+    FCommandJournal::Get().UnregisterTarget(JournalTarget);
+
+    if (AQuadPawn* Drone = Pawn.Get())
+    {
+        if (Drone->QuadController)
+        {
+            Drone->QuadController->OnControlStep().Remove(ControlStepHandle);
+        }
+    }
+
+    // Waits for the publisher thread to finish any in-flight message for this drone
+    if (StatePublisher)
+    {
+        StatePublisher->UnregisterDrone(StateHandle);
+        StatePublisher = nullptr;
+    }
+
+    for (UROS2Subscriber* Subscriber : Subscribers)
+    {
+        Subscriber->Destroy();
+    }
+    Subscribers.Reset();
+
+    for (UROS2Publisher* Publisher : { OdometryPublisher, ImuPublisher, MotorPublisher })
+    {
+        if (Publisher)
+        {
+            Publisher->Destroy();
+        }
+    }
+    OdometryPublisher = ImuPublisher = MotorPublisher = nullptr;
+
+    CommandMailboxes.Reset();
+    UE_LOG(LogTemp, Display, TEXT("ROS2Bridge: Disconnected %s"), *Namespace);
+}
+
+void UROS2DroneLink::UpdateStateMessage(UROS2GenericMsg* InMessage)
+{
+    // Empty - state messages are filled and published by the state publisher thread
+}
+
+void UROS2DroneLink::HandleControlStep(const FDroneStateSample& Sample)
+{
+    auto IsDue = [&Sample](int32 Decimation) { return Decimation > 0 && Sample.Step % Decimation == 0; };
+
+    uint8 StreamMask = 0;
+    StreamMask |= IsDue(OdometryDecimation) ? FROS2StatePublisher::Odometry : 0;
+    StreamMask |= IsDue(ImuDecimation) ? FROS2StatePublisher::Imu : 0;
+    StreamMask |= IsDue(MotorDecimation) ? FROS2StatePublisher::Motors : 0;
+
+    if (StreamMask != 0 && StatePublisher)
+    {
+        StatePublisher->Enqueue(StateHandle, Sample, StreamMask);
+    }
+}
+
+template <typename CommandType>
+void UROS2DroneLink::PostCommand(const TCHAR* Name, TCommandMailbox<CommandType>& Mailbox, const CommandType& Command)
+{
+    if (FCommandJournal::Get().GetMode() == FCommandJournal::EMode::Off)
+    {
+        Mailbox.Post(Command);
+        return;
+    }
+
+    FExternalCommand External;
+    External.Target = JournalTarget;
+    External.Name = Name;
+    WriteJournalPayload(Command, External.Data);
+    FCommandJournal::Get().Submit(MoveTemp(External));
+}
+
+// Subscriber callbacks only convert and post, so they stay O(1) however often clients publish
+
+void UROS2DroneLink::HandleVelocityCommand(const UROS2GenericMsg* InMsg)
+{
+    const UROS2TwistMsg* TwistMsg = Cast<UROS2TwistMsg>(InMsg);
+    if (!TwistMsg || !CommandMailboxes)
+    {
+        return;
+    }
+
+    FROSTwist Twist;
+    TwistMsg->GetMsg(Twist);
+
+    // The controller turns to face its direction of travel, so the angular part is not used
+    FDroneCommandMailboxes::FVelocity Command;
+    Command.Velocity = QuadROS2::FromROSVector(Twist.Linear);
+    PostCommand(TEXT("CMD_VELOCITY"), CommandMailboxes->Velocity, Command);
+}
+
+void UROS2DroneLink::HandleAttitudeCommand(const UROS2GenericMsg* InMsg)
+{
+    const UROS2Float32MultiArrayMsg* ArrayMsg = Cast<UROS2Float32MultiArrayMsg>(InMsg);
+    if (!ArrayMsg || !CommandMailboxes)
+    {
+        return;
+    }
+
+    FROSFloat32MultiArray Values;
+    ArrayMsg->GetMsg(Values);
+    if (Values.Data.Num() != 4)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ROS2Bridge: %s attitude command needs [roll, pitch, yaw, thrust], got %d values"), *Namespace, Values.Data.Num());
+        return;
+    }
+
+    FDroneCommandMailboxes::FAttitude Command;
+    Command.Attitude = QuadROS2::FromROSEuler(Values.Data[0], Values.Data[1], Values.Data[2]);
+    Command.Thrust = Values.Data[3];
+    PostCommand(TEXT("CMD_ATTITUDE"), CommandMailboxes->Attitude, Command);
+}
+
+void UROS2DroneLink::HandleMotorCommand(const UROS2GenericMsg* InMsg)
+{
+    const UROS2Float32MultiArrayMsg* ArrayMsg = Cast<UROS2Float32MultiArrayMsg>(InMsg);
+    if (!ArrayMsg || !CommandMailboxes)
+    {
+        return;
+    }
+
+    FROSFloat32MultiArray Values;
+    ArrayMsg->GetMsg(Values);
+
+    FDroneCommandMailboxes::FMotors Command;
+    if (Values.Data.Num() != UE_ARRAY_COUNT(Command.Thrusts))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ROS2Bridge: %s motor command needs %d thrusts, got %d"), *Namespace, UE_ARRAY_COUNT(Command.Thrusts), Values.Data.Num());
+        return;
+    }
+    FMemory::Memcpy(Command.Thrusts, Values.Data.GetData(), sizeof(Command.Thrusts));
+    PostCommand(TEXT("CMD_MOTORS"), CommandMailboxes->Motors, Command);
+}
+
+void UROS2DroneLink::DispatchCommand(const FExternalCommand& Command)
+{
+    if (!CommandMailboxes)
+    {
+        return;
+    }
+
+    // Journaled commands land in the same mailboxes live ones do
+    auto PostJournaled = [&Command](auto& Mailbox, auto Payload)
+    {
+        if (ReadJournalPayload(Command.Data, Payload))
+        {
+            Mailbox.Post(Payload);
+        }
+    };
+
+    if (Command.Name == TEXT("CMD_VELOCITY"))
+    {
+        PostJournaled(CommandMailboxes->Velocity, FDroneCommandMailboxes::FVelocity());
+    }
+    else if (Command.Name == TEXT("CMD_ATTITUDE"))
+    {
+        PostJournaled(CommandMailboxes->Attitude, FDroneCommandMailboxes::FAttitude());
+    }
+    else if (Command.Name == TEXT("CMD_MOTORS"))
+    {
+        PostJournaled(CommandMailboxes->Motors, FDroneCommandMailboxes::FMotors());
+    }
+}
+
+// ---------------------- Bridge ------------------------
+
+AROS2Bridge::AROS2Bridge()
+{
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.TickInterval = 0.1f;
+
+    Node = CreateDefaultSubobject<UROS2NodeComponent>(TEXT("ROS2NodeComponent"));
+}
+
+FString AROS2Bridge::MakeNamespace(const FString& DroneID)
+{
+    // ROS names allow alphanumerics and underscores, and may not start with a digit
+    FString Namespace = DroneID;
+    for (TCHAR& Char : Namespace)
+    {
+        if (!FChar::IsAlnum(Char) && Char != TEXT('_'))
+        {
+            Char = TEXT('_');
+        }
+    }
+    if (Namespace.IsEmpty() || FChar::IsDigit(Namespace[0]))
+    {
+        Namespace = TEXT("drone_") + Namespace;
+    }
+    return Namespace;
+}
+
+void AROS2Bridge::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (!FRunProfile::Get().WantsROS2())
+    {
+        UE_LOG(LogTemp, Display, TEXT("ROS2Bridge: Skipped, run profile '%s' has no ROS2"), FRunProfile::Get().GetProfileName());
+        SetActorTickEnabled(false);
+        return;
+    }
+
+    Node->Name = NodeName;
+    Node->Namespace = FString();
+    Node->Init();
+
+    if (bPublishClock)
+    {
+        ROS2_CREATE_LOOP_PUBLISHER_WITH_QOS(Node, this, TEXT("/clock"), UROS2Publisher::StaticClass(), UROS2ClockMsg::StaticClass(),
+            0, &AROS2Bridge::UpdateClockMessage, UROS2QoS::ClockPub, ClockPublisher);
+    }
+    StatePublisher = MakeUnique<FROS2StatePublisher>(ClockPublisher);
+
+    // Drones the manager already knows come in through its delegate as it registers them; when the manager began
+    // play first, pick them up here
+    Manager = Cast<ADroneManager>(UGameplayStatics::GetActorOfClass(GetWorld(), ADroneManager::StaticClass()));
+    if (ADroneManager* DroneManager = Manager.Get())
+    {
+        DroneAddedHandle = DroneManager->OnDroneAdded().AddUObject(this, &AROS2Bridge::AddDrone);
+        DroneRemovedHandle = DroneManager->OnDroneRemoved().AddUObject(this, &AROS2Bridge::RemoveDrone);
+        for (AQuadPawn* Drone : DroneManager->GetDroneList())
+        {
+            AddDrone(Drone);
+        }
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ROS2Bridge: No DroneManager in the world, no drones will be bridged"));
+    }
+}
+
+void AROS2Bridge::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (ADroneManager* DroneManager = Manager.Get())
+    {
+        DroneManager->OnDroneAdded().Remove(DroneAddedHandle);
+        DroneManager->OnDroneRemoved().Remove(DroneRemovedHandle);
+    }
+
+    for (UROS2DroneLink* Link : Links)
+    {
+        Link->Shutdown();
+    }
+    Links.Reset();
+    PendingDrones.Reset();
+
+    StatePublisher.Reset();
+    Super::EndPlay(EndPlayReason);
+}
+
+void AROS2Bridge::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    // Pawns create their controller in BeginPlay, which can come after they register with the manager
+    for (int32 i = PendingDrones.Num() - 1; i >= 0; i--)
+    {
+        AQuadPawn* Drone = PendingDrones[i].Get();
+        if (!Drone || Drone->QuadController)
+        {
+            PendingDrones.RemoveAtSwap(i);
+            AddDrone(Drone);
+        }
+    }
+}
+
+void AROS2Bridge::AddDrone(AQuadPawn* Drone)
+{
+    if (!Drone || !StatePublisher || Links.ContainsByPredicate([Drone](const UROS2DroneLink* Link) { return Link->GetPawn() == Drone; }))
+    {
+        return;
+    }
+
+    if (!Drone->QuadController)
+    {
+        PendingDrones.AddUnique(Drone);
+        return;
+    }
+
+    UROS2DroneLink* Link = NewObject<UROS2DroneLink>(this);
+    Link->Init(Drone, MakeNamespace(Drone->DroneID), Node, Topics, StatePublisher.Get());
+    Links.Add(Link);
+}
+
+void AROS2Bridge::RemoveDrone(AQuadPawn* Drone)
+{
+    PendingDrones.Remove(Drone);
+
+    const int32 Index = Links.IndexOfByPredicate([Drone](const UROS2DroneLink* Link) { return Link->GetPawn() == Drone; });
+    if (Index != INDEX_NONE)
+    {
+        Links[Index]->Shutdown();
+        Links.RemoveAtSwap(Index);
+    }
+}
+
+void AROS2Bridge::UpdateClockMessage(UROS2GenericMsg* InMessage)
+{
+    // Empty - /clock is published by the state publisher thread as sim time advances
+}
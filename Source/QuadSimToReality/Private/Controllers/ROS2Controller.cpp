@@ -5,14 +5,18 @@
 #include "Msgs/ROS2Float32.h"
 #include "Msgs/ROS2Float64.h"
 #include "Msgs/ROS2Str.h"
+#include "Core/CommandJournal.h"
+#include "Utility/SimProfiler.h"
+#include "Core/SimClock.h"
+#include "Core/EnvPool.h"
+#include "Core/RunProfile.h"
+#include "Controllers/ROS2Conversions.h"
+#include "Controllers/ROS2Bridge.h"
 
 AROS2Controller::AROS2Controller()
 {
     PrimaryActorTick.bCanEverTick = false;
 
-    // Initialize ROS2 node component
-    Node = CreateDefaultSubobject<UROS2NodeComponent>(TEXT("ROS2NodeComponent"));
-    
     // Initialize SceneCapture component
     SceneCapture = CreateDefaultSubobject<USceneCaptureComponent2D>(TEXT("SceneCapture"));
     SceneCapture->SetupAttachment(RootComponent);  // Attach to root temporarily
@@ -31,16 +35,51 @@ void AROS2Controller::BeginPlay()
         return;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("ROS2Controller: Initializing with namespace '%s'"), *Namespace);
-    
-    // Initialize ROS2 node
-    Node->Name = NodeName;
-    Node->Namespace = Namespace;
-    Node->Init();
-    
+    // Training workers never talk to ROS; bringing up a node would only slow their start
+    if (!FRunProfile::Get().WantsROS2())
+    {
+        UE_LOG(LogTemp, Display, TEXT("ROS2Controller: Skipped, run profile '%s' has no ROS2"), FRunProfile::Get().GetProfileName());
+        return;
+    }
+
+    // The drone manager spawns the bridge from its own BeginPlay, which may come after this one
+    GetWorld()->GetTimerManager().SetTimerForNextTick(this, &AROS2Controller::InitializeROS2);
+}
+
+void AROS2Controller::InitializeROS2()
+{
+    // One node per process: topics go on the bridge's node instead of one of our own
+    Bridge = Cast<AROS2Bridge>(UGameplayStatics::GetActorOfClass(GetWorld(), AROS2Bridge::StaticClass()));
+    if (!Bridge.IsValid())
+    {
+        UE_LOG(LogTemp, Display, TEXT("ROS2Controller: No ROS2Bridge in the world, spawning one for its node"));
+        Bridge = GetWorld()->SpawnActor<AROS2Bridge>(AROS2Bridge::StaticClass(), FTransform::Identity);
+    }
+    Node = Bridge.IsValid() ? Bridge->GetNode() : nullptr;
+    if (!Node)
+    {
+        UE_LOG(LogTemp, Error, TEXT("ROS2Controller: ROS2Bridge has no node, topics not created"));
+        return;
+    }
+
+    // Topics are created on the bridge's node, which has no namespace of its own; relative names go under ours
+    auto Qualify = [this](FString& Topic)
+    {
+        if (!Topic.StartsWith(TEXT("/")) && !Namespace.IsEmpty())
+        {
+            Topic = Namespace / Topic;
+        }
+    };
+    Qualify(PositionTopicName);
+    Qualify(ImageTopicName);
+    Qualify(ImageDescriptorTopicName);
+    Qualify(ObstacleTopicName);
+
+    UE_LOG(LogTemp, Warning, TEXT("ROS2Controller: Initializing on node '%s' with namespace '%s'"), *Bridge->NodeName, *Namespace);
+
     // Log the fully qualified topic names
     UE_LOG(LogTemp, Warning, TEXT("Position topic: %s"), *PositionTopicName);
-    UE_LOG(LogTemp, Warning, TEXT("Image topic: %s"), *ImageTopicName);
+    UE_LOG(LogTemp, Warning, TEXT("Image topic: %s"), bSharedMemoryFrames ? *ImageDescriptorTopicName : *ImageTopicName);
     UE_LOG(LogTemp, Warning, TEXT("Obstacle topic: %s"), *ObstacleTopicName);
 
     // Setup position publisher
@@ -56,31 +95,49 @@ void AROS2Controller::BeginPlay()
         PositionPublisher
     );
 
-    // Setup image publisher
-    ROS2_CREATE_LOOP_PUBLISHER_WITH_QOS(
-        Node,
-        this,
-        ImageTopicName,
-        UROS2Publisher::StaticClass(),
-        UROS2ImgMsg::StaticClass(),
-        ImageFrequencyHz,
-        &AROS2Controller::UpdateImageMessage,
-        UROS2QoS::SensorData,
-        ImagePublisher
-    );
+    // ImageResolution is an FVector2D; the ring is sized in whole pixels
+    const int32 FrameWidth = FMath::RoundToInt32(ImageResolution.X);
+    const int32 FrameHeight = FMath::RoundToInt32(ImageResolution.Y);
+    if (bSharedMemoryFrames && FrameRing.Open(TEXT("quadsim_") + FEnvPool::Get().QualifyName(GetName()), FrameWidth, FrameHeight))
+    {
+        ROS2_CREATE_LOOP_PUBLISHER_WITH_QOS(
+            Node,
+            this,
+            ImageDescriptorTopicName,
+            UROS2Publisher::StaticClass(),
+            UROS2StrMsg::StaticClass(),
+            0,
+            &AROS2Controller::UpdateImageMessage,
+            UROS2QoS::SensorData,
+            ImageDescriptorPublisher
+        );
+    }
+    else
+    {
+        // Setup image publisher
+        ROS2_CREATE_LOOP_PUBLISHER_WITH_QOS(
+            Node,
+            this,
+            ImageTopicName,
+            UROS2Publisher::StaticClass(),
+            UROS2ImgMsg::StaticClass(),
+            ImageFrequencyHz,
+            &AROS2Controller::UpdateImageMessage,
+            UROS2QoS::SensorData,
+            ImagePublisher
+        );
+    }
 
     SetupObstacleManager();
+
+    FCommandJournal::Get().RegisterTarget(GetName(), FOnExternalCommand::CreateUObject(this, &AROS2Controller::DispatchCommand));
     
     UE_LOG(LogTemp, Warning, TEXT("Setting up obstacle subscriber on topic: %s"), *ObstacleTopicName);
     
-    // Create obstacle subscriber with standard macro
-    ROS2_CREATE_SUBSCRIBER(
-        Node,
-        this,
-        ObstacleTopicName,
-        UROS2Float64Msg::StaticClass(),
-        &AROS2Controller::HandleObstacleMessage
-    );
+    // Kept so EndPlay can remove it from the shared node
+    FSubscriptionCallback ObstacleCallback;
+    ObstacleCallback.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(AROS2Controller, HandleObstacleMessage));
+    ObstacleSubscriber = Node->CreateSubscriber(ObstacleTopicName, UROS2Float64Msg::StaticClass(), ObstacleCallback);
     
     UE_LOG(LogTemp, Warning, TEXT("Obstacle subscriber created successfully"));
 
@@ -101,7 +158,34 @@ void AROS2Controller::BeginPlay()
 }
 void AROS2Controller::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-    GetWorld()->GetTimerManager().ClearTimer(CaptureTimerHandle);
+    // Also drops the deferred InitializeROS2 if play ends before the first tick
+    GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+    FCommandJournal::Get().UnregisterTarget(GetName());
+
+    // The node outlives us unless the bridge is going away as well
+    if (Bridge.IsValid() && Bridge->GetNode())
+    {
+        if (ObstacleSubscriber)
+        {
+            ObstacleSubscriber->Destroy();
+        }
+        for (UROS2Publisher* Publisher : { PositionPublisher, ImagePublisher, ImageDescriptorPublisher })
+        {
+            if (Publisher)
+            {
+                Publisher->Destroy();
+            }
+        }
+    }
+    ObstacleSubscriber = nullptr;
+    PositionPublisher = ImagePublisher = ImageDescriptorPublisher = nullptr;
+    Node = nullptr;
+
+    // A readback still in flight keeps writing to the ring; the destructor unmaps it then
+    if (!bIsProcessingImage)
+    {
+        FrameRing.Close();
+    }
     Super::EndPlay(EndPlayReason);
 }
 
@@ -149,6 +233,8 @@ void AROS2Controller::CaptureImage()
 {
     if (!SceneCapture || bIsProcessingImage) return;
 
+    FSimScopedTimer Timer(ESimPhase::ImageCapture);
+
     SceneCapture->SetWorldLocationAndRotation(
         QuadPawn->CameraFPV->GetComponentLocation(),
         QuadPawn->CameraFPV->GetComponentRotation()
@@ -166,21 +252,38 @@ void AROS2Controller::CaptureImage()
     if (!RTResource) return;
 
     bIsProcessingImage = true;
+    const double SimTime = FSimClock::Get().GetSimSeconds();
     
     ENQUEUE_RENDER_COMMAND(CaptureImageCommand)(
-        [this, RTResource](FRHICommandListImmediate& RHICmdList)
+        [this, RTResource, SimTime](FRHICommandListImmediate& RHICmdList)
         {
             TArray<FColor> Pixels;
-            RHICmdList.ReadSurfaceData(
-                RTResource->GetRenderTargetTexture(),
-                FIntRect(0, 0, ImageResolution.X, ImageResolution.Y),
-                Pixels,
-                FReadSurfaceDataFlags(RCM_UNorm, CubeFace_MAX)
-            );
-
-            AsyncTask(ENamedThreads::GameThread, [this, Pixels]()
             {
-                ProcessCapturedImage(Pixels);
+                FSimScopedTimer ReadbackTimer(ESimPhase::ImageReadback);
+                RHICmdList.ReadSurfaceData(
+                    RTResource->GetRenderTargetTexture(),
+                    FIntRect(0, 0, ImageResolution.X, ImageResolution.Y),
+                    Pixels,
+                    FReadSurfaceDataFlags(RCM_UNorm, CubeFace_MAX)
+                );
+            }
+
+            // Shared memory frames are copied once, here, and only the descriptor goes back to the game thread
+            if (FrameRing.IsOpen())
+            {
+                const uint64 FrameId = Pixels.Num() == FrameRing.GetWidth() * FrameRing.GetHeight()
+                    ? FrameRing.Write(Pixels.GetData(), FrameRing.GetWidth(), FrameRing.GetHeight(), SimTime)
+                    : 0;
+                AsyncTask(ENamedThreads::GameThread, [this, FrameId]()
+                {
+                    PublishFrameDescriptor(FrameId);
+                });
+                return;
+            }
+
+            AsyncTask(ENamedThreads::GameThread, [this, Pixels = MoveTemp(Pixels), SimTime]()
+            {
+                ProcessCapturedImage(Pixels, SimTime);
             });
         }
     );
@@ -188,7 +291,7 @@ void AROS2Controller::CaptureImage()
     
 }
 
-void AROS2Controller::ProcessCapturedImage(const TArray<FColor>& Pixels)
+void AROS2Controller::ProcessCapturedImage(const TArray<FColor>& Pixels, double SimTime)
 {
     if (Pixels.Num() == 0)
     {
@@ -197,20 +300,26 @@ void AROS2Controller::ProcessCapturedImage(const TArray<FColor>& Pixels)
         return;
     }
 
+    FSimScopedTimer Timer(ESimPhase::ROS2);
+
     // Convert to ROS image message
     FROSImg ImageMsg;
+    ImageMsg.Header.Stamp = QuadROS2::ToROSTime(SimTime);
     ImageMsg.Height = ImageResolution.Y;
     ImageMsg.Width = ImageResolution.X;
     ImageMsg.Encoding = "bgr8";  // Change to bgr8 since we're sending in BGR order
     ImageMsg.Step = ImageResolution.X * 3;
     ImageMsg.Data.Reserve(Pixels.Num() * 3);
 
-    for (const FColor& Pixel : Pixels)
     {
-        // Store in BGR order to match the expected format
-        ImageMsg.Data.Add(Pixel.B);  
-        ImageMsg.Data.Add(Pixel.G);  
-        ImageMsg.Data.Add(Pixel.R);  
+        FSimScopedTimer EncodeTimer(ESimPhase::ImageEncode);
+        for (const FColor& Pixel : Pixels)
+        {
+            // Store in BGR order to match the expected format
+            ImageMsg.Data.Add(Pixel.B);  
+            ImageMsg.Data.Add(Pixel.G);  
+            ImageMsg.Data.Add(Pixel.R);  
+        }
     }
 
     if (IsValid(ImagePublisher) && IsValid(ImagePublisher->TopicMessage))
@@ -233,6 +342,24 @@ void AROS2Controller::ProcessCapturedImage(const TArray<FColor>& Pixels)
     bIsProcessingImage = false;
 }
 
+void AROS2Controller::PublishFrameDescriptor(uint64 FrameId)
+{
+    FSimScopedTimer Timer(ESimPhase::ROS2);
+
+    if (FrameId != 0 && IsValid(ImageDescriptorPublisher))
+    {
+        if (UROS2StrMsg* Msg = Cast<UROS2StrMsg>(ImageDescriptorPublisher->TopicMessage))
+        {
+            FROSStr Descriptor;
+            Descriptor.Data = FrameRing.MakeDescriptor(FrameId);
+            Msg->SetMsg(Descriptor);
+            ImageDescriptorPublisher->Publish();
+        }
+    }
+
+    bIsProcessingImage = false;
+}
+
 void AROS2Controller::UpdatePositionMessage(UROS2GenericMsg* InMessage)
 {
     if(!QuadPawn) return;
@@ -309,12 +436,28 @@ void AROS2Controller::HandleObstacleMessage(const UROS2GenericMsg* InMsg)
     
     FROSFloat64 RosMsg;
     Float64Msg->GetMsg(RosMsg);
-    float ObstacleCount = RosMsg.Data;
+
+    FExternalCommand Command;
+    Command.Target = GetName();
+    Command.Name = TEXT("OBSTACLES");
+    Command.Data.Append(reinterpret_cast<const uint8*>(&RosMsg.Data), sizeof(RosMsg.Data));
+    FCommandJournal::Get().Submit(MoveTemp(Command));
+}
+
+void AROS2Controller::DispatchCommand(const FExternalCommand& Command)
+{
+    if (Command.Name != TEXT("OBSTACLES") || Command.Data.Num() != sizeof(double))
+    {
+        return;
+    }
+
+    double ObstacleCount = 0.0;
+    FMemory::Memcpy(&ObstacleCount, Command.Data.GetData(), sizeof(ObstacleCount));
     
     UE_LOG(LogTemp, Display, TEXT("Received obstacle count: %f"), ObstacleCount);
     
     // Only create obstacles if the count is positive and manager exists
-    if (ObstacleCount > 0.0f && ObstacleManagerInstance)
+    if (ObstacleCount > 0.0 && ObstacleManagerInstance)
     {
         int32 Count = FMath::RoundToInt(ObstacleCount); // Convert float to int
         UE_LOG(LogTemp, Warning, TEXT("Creating %d obstacles"), Count);
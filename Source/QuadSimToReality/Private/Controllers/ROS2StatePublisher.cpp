@@ -0,0 +1,165 @@
+// ROS2StatePublisher.cpp
+#include "Controllers/ROS2StatePublisher.h"
+#include "Controllers/ROS2Conversions.h"
+#include "ROS2Publisher.h"
+#include "Msgs/ROS2Clock.h"
+#include "Msgs/ROS2Float32MultiArray.h"
+#include "Msgs/ROS2Imu.h"
+#include "Msgs/ROS2Odom.h"
+#include "HAL/RunnableThread.h"
+#include "Utility/SimProfiler.h"
+
+FROS2StatePublisher::FROS2StatePublisher(UROS2Publisher* InClockPublisher)
+    : ClockPublisher(InClockPublisher)
+{
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    Thread = FRunnableThread::Create(this, TEXT("ROS2StatePublisher"), 0, TPri_AboveNormal);
+}
+
+FROS2StatePublisher::~FROS2StatePublisher()
+{
+    if (Thread)
+    {
+        Thread->Kill(true);
+        delete Thread;
+        Thread = nullptr;
+    }
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+}
+
+int32 FROS2StatePublisher::RegisterDrone(const FROS2DroneStreams& InStreams)
+{
+    FScopeLock Lock(&StreamsLock);
+    const int32 Handle = NextHandle++;
+    Streams.Add(Handle, InStreams);
+    return Handle;
+}
+
+void FROS2StatePublisher::UnregisterDrone(int32 Handle)
+{
+    FScopeLock Lock(&StreamsLock);
+    Streams.Remove(Handle);
+}
+
+bool FROS2StatePublisher::Enqueue(int32 Handle, const FDroneStateSample& Sample, uint8 StreamMask)
+{
+    if (NumPending.load(std::memory_order_relaxed) >= MaxPendingSamples)
+    {
+        // Logged on powers of two so a stalled worker does not flood the log
+        if (FMath::IsPowerOfTwo(++NumDropped))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("ROS2StatePublisher: Publishing is falling behind, dropped %llu samples"), NumDropped);
+        }
+        return false;
+    }
+
+    Pending.Enqueue(FPendingSample{ Handle, StreamMask, Sample });
+    NumPending.fetch_add(1, std::memory_order_relaxed);
+    WakeEvent->Trigger();
+    return true;
+}
+
+void FROS2StatePublisher::Stop()
+{
+    bStopping = true;
+    WakeEvent->Trigger();
+}
+
+uint32 FROS2StatePublisher::Run()
+{
+    while (!bStopping)
+    {
+        WakeEvent->Wait(100);
+        Drain();
+    }
+    return 0;
+}
+
+void FROS2StatePublisher::Drain()
+{
+    FScopeLock Lock(&StreamsLock);
+
+    FPendingSample Item;
+    while (Pending.Dequeue(Item))
+    {
+        NumPending.fetch_sub(1, std::memory_order_relaxed);
+
+        FSimScopedTimer Timer(ESimPhase::ROS2);
+        if (Item.Sample.SimTime > LastClockTime)
+        {
+            PublishClock(Item.Sample.SimTime);
+        }
+        if (const FROS2DroneStreams* DroneStreams = Streams.Find(Item.Handle))
+        {
+            Publish(*DroneStreams, Item.Sample, Item.StreamMask);
+        }
+    }
+}
+
+void FROS2StatePublisher::PublishClock(double SimTime)
+{
+    LastClockTime = SimTime;
+    if (!ClockPublisher)
+    {
+        return;
+    }
+
+    FROSClock ClockMsg;
+    ClockMsg.Clock = QuadROS2::ToROSTime(SimTime);
+    CastChecked<UROS2ClockMsg>(ClockPublisher->TopicMessage)->SetMsg(ClockMsg);
+    ClockPublisher->Publish();
+}
+
+void FROS2StatePublisher::Publish(const FROS2DroneStreams& DroneStreams, const FDroneStateSample& Sample, uint8 StreamMask)
+{
+    FROSHeader Header;
+    Header.Stamp = QuadROS2::ToROSTime(Sample.SimTime);
+
+    const FQuat Orientation = QuadROS2::ToROSQuat(Sample.Orientation);
+    const FVector BodyAngularVelocity = QuadROS2::ToROSAngular(Sample.Orientation.UnrotateVector(Sample.AngularVelocity));
+
+    if ((StreamMask & Odometry) && DroneStreams.Odometry)
+    {
+        FROSOdom OdomMsg;
+        OdomMsg.Header = Header;
+        OdomMsg.Header.FrameId = DroneStreams.OdomFrameId;
+        OdomMsg.ChildFrameId = DroneStreams.BaseFrameId;
+        OdomMsg.Pose.Pose.Position = QuadROS2::ToROSVector(Sample.Position);
+        OdomMsg.Pose.Pose.Orientation = Orientation;
+        OdomMsg.Pose.Covariance.SetNumZeroed(36);
+
+        // REP 105: odometry twist is expressed in the child (body) frame
+        OdomMsg.Twist.Twist.Linear = QuadROS2::ToROSVector(Sample.Orientation.UnrotateVector(Sample.Velocity));
+        OdomMsg.Twist.Twist.Angular = BodyAngularVelocity;
+        OdomMsg.Twist.Covariance.SetNumZeroed(36);
+
+        CastChecked<UROS2OdomMsg>(DroneStreams.Odometry->TopicMessage)->SetMsg(OdomMsg);
+        DroneStreams.Odometry->Publish();
+    }
+
+    if ((StreamMask & Imu) && DroneStreams.Imu)
+    {
+        FROSImu ImuMsg;
+        ImuMsg.Header = Header;
+        ImuMsg.Header.FrameId = DroneStreams.BaseFrameId;
+        ImuMsg.Orientation = Orientation;
+        ImuMsg.AngularVelocity = BodyAngularVelocity;
+        ImuMsg.LinearAcceleration = QuadROS2::ToROSVector(Sample.Orientation.UnrotateVector(Sample.SpecificForce));
+        ImuMsg.OrientationCovariance.SetNumZeroed(9);
+        ImuMsg.AngularVelocityCovariance.SetNumZeroed(9);
+        ImuMsg.LinearAccelerationCovariance.SetNumZeroed(9);
+
+        CastChecked<UROS2ImuMsg>(DroneStreams.Imu->TopicMessage)->SetMsg(ImuMsg);
+        DroneStreams.Imu->Publish();
+    }
+
+    if ((StreamMask & Motors) && DroneStreams.Motors)
+    {
+        FROSFloat32MultiArray MotorMsg;
+        MotorMsg.Data.Append(Sample.Thrusts, UE_ARRAY_COUNT(Sample.Thrusts));
+
+        CastChecked<UROS2Float32MultiArrayMsg>(DroneStreams.Motors->TopicMessage)->SetMsg(MotorMsg);
+        DroneStreams.Motors->Publish();
+    }
+}
@@ -10,6 +10,10 @@
 #include "HAL/RunnableThread.h"
 #include "Async/Async.h"
 #include "Core/DroneManager.h"
+#include "Core/CommandJournal.h"
+#include "Utility/SimProfiler.h"
+#include "Core/SimClock.h"
+#include "Core/EnvPool.h"
 
 #include "Kismet/GameplayStatics.h"
 
@@ -43,12 +47,31 @@ void AZMQController::Initialize(AQuadPawn* InPawn, UQuadDroneController* InDrone
         Configuration.DroneID = InPawn->GetName();
     }
 
+    if (DroneController)
+    {
+        DroneController->OnControlStep().Remove(ControlStepHandle);
+    }
+
     DronePawn = InPawn;
     DroneController = InDroneController;
     TargetPawn = InPawn;
 
+    // STEP replies are counted in control steps and carry the state of the step they complete on
+    if (DroneController && Configuration.bEnableStepRpc)
+    {
+        ControlStepHandle = DroneController->OnControlStep().AddUObject(this, &AZMQController::HandleControlStep);
+    }
+
     UE_LOG(LogTemp, Display, TEXT("ZMQController initialized with DroneID: %s"), *Configuration.DroneID);
 
+    FCommandJournal& Journal = FCommandJournal::Get();
+    if (!RegisteredCommandTarget.IsEmpty())
+    {
+        Journal.UnregisterTarget(RegisteredCommandTarget);
+    }
+    RegisteredCommandTarget = Configuration.DroneID;
+    Journal.RegisterTarget(RegisteredCommandTarget, FOnExternalCommand::CreateUObject(this, &AZMQController::DispatchCommand));
+
     InitializeZMQ();
     //InitializeImageCapture();
     
@@ -107,7 +130,25 @@ void AZMQController::BeginPlay()
 void AZMQController::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     GetWorld()->GetTimerManager().ClearTimer(ImageCaptureTimerHandle);
+
+    if (!RegisteredCommandTarget.IsEmpty())
+    {
+        FCommandJournal::Get().UnregisterTarget(RegisteredCommandTarget);
+        RegisteredCommandTarget.Empty();
+    }
     
+    if (DroneController)
+    {
+        DroneController->OnControlStep().Remove(ControlStepHandle);
+    }
+    StepServer.Close();
+
+    // An image task still in flight keeps writing to the ring; the destructor unmaps it then
+    if (!bIsCapturing)
+    {
+        FrameRing.Close();
+    }
+
     PublishSocket.Reset();
     CommandSocket.Reset();
     ControlSocket.Reset();
@@ -118,30 +159,88 @@ void AZMQController::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    FSimScopedTimer Timer(ESimPhase::ZMQ);
+
     // Process incoming commands
     ProcessCommands();
+    StepServer.Poll(Configuration.MaxCommandsPerTick);
     // Send state data
     SendStateData();
 }
 
+zmq::context_t& AZMQController::GetSharedContext(int32 IOThreads)
+{
+    // One context for every controller, so inproc endpoints are reachable and I/O threads are not
+    // multiplied per drone. Never destroyed: a context torn down during static destruction can block.
+    static zmq::context_t* SharedContext = new zmq::context_t(FMath::Max(IOThreads, 1));
+    return *SharedContext;
+}
+
+FString AZMQController::MakeEndpoint(const FZMQConfiguration& Config, int32 Port, bool bBind)
+{
+    // Pooled instances each get their own port range, and with it their own IPC paths
+    Port = FEnvPool::Get().OffsetPort(Port);
+
+    switch (Config.Transport)
+    {
+    case EZMQTransport::Ipc:
+        return FString::Printf(TEXT("ipc://%s/quadsim_%d"), *Config.IpcDirectory, Port);
+    case EZMQTransport::Inproc:
+        return FString::Printf(TEXT("inproc://quadsim_%d"), Port);
+    default:
+        return FString::Printf(bBind ? TEXT("tcp://*:%d") : TEXT("tcp://localhost:%d"), Port);
+    }
+}
+
+void AZMQController::ConfigureSocket(const FZMQConfiguration& Config, zmq::socket_t& Socket, int32 SendHighWaterMark, int32 ReceiveHighWaterMark)
+{
+    // Options only apply to connections made afterwards, so this runs before bind/connect.
+    // libzmq already sets TCP_NODELAY on every TCP connection.
+    Socket.set(zmq::sockopt::linger, Config.LingerMs);
+    Socket.set(zmq::sockopt::sndhwm, SendHighWaterMark);
+    Socket.set(zmq::sockopt::rcvhwm, ReceiveHighWaterMark);
+    Socket.set(zmq::sockopt::immediate, Config.bImmediate);
+}
+
 void AZMQController::InitializeZMQ()
 {
     try 
     {
+        zmq::context_t& Context = GetSharedContext(Configuration.IOThreads);
+
+        // Image messages are multipart, which ZMQ_CONFLATE does not support; a small HWM bounds their staleness instead
         PublishSocket = MakeShared<zmq::socket_t>(Context, zmq::socket_type::pub);
-        FString PublishEndpoint = FString::Printf(TEXT("tcp://*:%d"), Configuration.PublishPort);
-        PublishSocket->bind(TCHAR_TO_UTF8(*PublishEndpoint));
+        ConfigureSocket(Configuration, *PublishSocket, Configuration.ImageSendHighWaterMark, 0);
+        PublishSocket->bind(TCHAR_TO_UTF8(*MakeEndpoint(Configuration, Configuration.PublishPort, true)));
 
         CommandSocket = MakeShared<zmq::socket_t>(Context, zmq::socket_type::sub);
-        FString CommandEndpoint = FString::Printf(TEXT("tcp://localhost:%d"), Configuration.CommandPort);
-        CommandSocket->connect(TCHAR_TO_UTF8(*CommandEndpoint));
+        ConfigureSocket(Configuration, *CommandSocket, 0, Configuration.CommandReceiveHighWaterMark);
         CommandSocket->set(zmq::sockopt::subscribe, "");
+        CommandSocket->connect(TCHAR_TO_UTF8(*MakeEndpoint(Configuration, Configuration.CommandPort, false)));
 
         ControlSocket = MakeShared<zmq::socket_t>(Context, zmq::socket_type::pub);
-        FString ControlEndpoint = FString::Printf(TEXT("tcp://*:%d"), Configuration.ControlPort);
-        ControlSocket->bind(TCHAR_TO_UTF8(*ControlEndpoint));
+        ConfigureSocket(Configuration, *ControlSocket, Configuration.StateSendHighWaterMark, 0);
+        if (Configuration.bConflateState)
+        {
+            ControlSocket->set(zmq::sockopt::conflate, true);
+        }
+        ControlSocket->bind(TCHAR_TO_UTF8(*MakeEndpoint(Configuration, Configuration.ControlPort, true)));
+
+        if (Configuration.bEnableStepRpc && StepServer.Bind(Configuration))
+        {
+            StepServer.SetTarget(0, MakeStepTarget());
+        }
+
+        FEnvPool& Pool = FEnvPool::Get();
+        Pool.ReportEndpoint(Configuration.DroneID, TEXT("image"), MakeEndpoint(Configuration, Configuration.PublishPort, false));
+        Pool.ReportEndpoint(Configuration.DroneID, TEXT("command"), MakeEndpoint(Configuration, Configuration.CommandPort, true));
+        Pool.ReportEndpoint(Configuration.DroneID, TEXT("state"), MakeEndpoint(Configuration, Configuration.ControlPort, false));
+        if (StepServer.IsBound())
+        {
+            Pool.ReportEndpoint(Configuration.DroneID, TEXT("rpc"), MakeEndpoint(Configuration, Configuration.RpcPort, false));
+        }
 
-        UE_LOG(LogTemp, Display, TEXT("ZMQ Initialization Successful"));
+        UE_LOG(LogTemp, Display, TEXT("ZMQ Initialization Successful (%s)"), *MakeEndpoint(Configuration, Configuration.PublishPort, true));
     }
     catch (const zmq::error_t& Error)
     {
@@ -152,33 +251,35 @@ void AZMQController::InitializeZMQ()
 
 void AZMQController::ProcessCommands()
 {
-    if (!CommandSocket || bIsProcessingCommand) return;
+    // During a replay the journal is the only command source
+    if (!CommandSocket || bIsProcessingCommand || FCommandJournal::Get().IsReplaying()) return;
 
     bIsProcessingCommand = true;
 
     try
     {
+        // Drain everything that arrived since the last tick, so commands never queue up behind the tick rate
         zmq::multipart_t Message;
-        if (Message.recv(*CommandSocket, static_cast<int>(zmq::recv_flags::dontwait)))
+        for (int32 Received = 0; Received < Configuration.MaxCommandsPerTick; Received++)
         {
+            if (!Message.recv(*CommandSocket, static_cast<int>(zmq::recv_flags::dontwait)))
+            {
+                break;
+            }
             if (!Message.empty())
             {
-                std::string Command = Message.popstr();
-
-                if (Command == "RESET")
+                FExternalCommand Command;
+                Command.Target = Configuration.DroneID;
+                Command.Name = UTF8_TO_TCHAR(Message.popstr().c_str());
+                if (!Message.empty())
                 {
-                    HandleResetCommand();
-                }
-                else if (Command == "INTEGRAL_RESET" && DroneController)
-                {
-                    DroneController->ResetDroneIntegral();
-                }
-                else if (Command == "VELOCITY")
-                {
-                    UE_LOG(LogTemp, Display, TEXT("[ZMQController] Received 'VELOCITY' command."));
-                    HandleVelocityCommand(Message);
+                    zmq::message_t Data = Message.pop();
+                    Command.Data.Append(static_cast<const uint8*>(Data.data()), Data.size());
                 }
+
+                FCommandJournal::Get().Submit(MoveTemp(Command));
             }
+            Message.clear();
         }
     }
     catch (const zmq::error_t& Error)
@@ -190,6 +291,81 @@ void AZMQController::ProcessCommands()
     bIsProcessingCommand = false;
 }
 
+void AZMQController::HandleControlStep(const FDroneStateSample& Sample)
+{
+    LastStepSample = Sample;
+    bHasStepSample = true;
+    StepServer.OnControlStep(0);
+}
+
+FZMQStepTarget AZMQController::MakeStepTarget()
+{
+    FZMQStepTarget Target;
+    Target.CommandTarget = Configuration.DroneID;
+    Target.GetState = [this]() { return MakeStepState(); };
+    Target.HasControlSteps = [this]() { return DroneController != nullptr; };
+    return Target;
+}
+
+FZMQStepState AZMQController::MakeStepState() const
+{
+    FZMQStepState State = {};
+    FVector Position = DronePawn ? DronePawn->GetActorLocation() : FVector::ZeroVector;
+    FVector Velocity = DronePawn ? DronePawn->GetVelocity() : FVector::ZeroVector;
+    FQuat Orientation = DronePawn ? DronePawn->GetActorQuat() : FQuat::Identity;
+    FVector AngularVelocity = FVector::ZeroVector;
+
+    if (bHasStepSample)
+    {
+        State.Step = LastStepSample.Step;
+        State.SimTime = LastStepSample.SimTime;
+        Position = LastStepSample.Position;
+        Velocity = LastStepSample.Velocity;
+        Orientation = LastStepSample.Orientation;
+        AngularVelocity = LastStepSample.AngularVelocity;
+    }
+    else
+    {
+        // Step counts control steps, not world ticks, even before the first sample
+        State.Step = DroneController ? DroneController->GetControlStep() : 0;
+        State.SimTime = FSimClock::Get().GetSimSeconds();
+    }
+
+    for (int32 i = 0; i < 3; i++)
+    {
+        State.Position[i] = Position[i];
+        State.Velocity[i] = Velocity[i];
+        State.AngularVelocity[i] = AngularVelocity[i];
+        State.Goal[i] = CurrentGoalPosition[i];
+    }
+    State.Orientation[0] = Orientation.X;
+    State.Orientation[1] = Orientation.Y;
+    State.Orientation[2] = Orientation.Z;
+    State.Orientation[3] = Orientation.W;
+    return State;
+}
+
+void AZMQController::DispatchCommand(const FExternalCommand& Command)
+{
+    if (Command.Name == TEXT("RESET"))
+    {
+        HandleResetCommand();
+    }
+    else if (Command.Name == TEXT("RESET_RANDOMIZED"))
+    {
+        HandleRandomizedResetCommand(Command.Data);
+    }
+    else if (Command.Name == TEXT("INTEGRAL_RESET") && DroneController)
+    {
+        DroneController->ResetDroneIntegral();
+    }
+    else if (Command.Name == TEXT("VELOCITY"))
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("[ZMQController] Received 'VELOCITY' command."));
+        HandleVelocityCommand(Command.Data);
+    }
+}
+
 void AZMQController::HandleResetCommand()
 {
     if (!DroneController) return;
@@ -201,16 +377,39 @@ void AZMQController::HandleResetCommand()
     DroneController->ResetDroneOrigin();
 }
 
-void AZMQController::HandleVelocityCommand(zmq::multipart_t& Message)
+void AZMQController::HandleRandomizedResetCommand(const TArray<uint8>& Data)
+{
+    // The spec is a UTF-8 JSON object; see FResetSpec
+    const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Data.GetData()), Data.Num());
+    FResetSpec Spec;
+    if (!FResetSpec::FromJson(FString(Converted.Length(), Converted.Get()), Spec))
+    {
+        return;
+    }
+
+    ADroneManager* Manager = Cast<ADroneManager>(UGameplayStatics::GetActorOfClass(GetWorld(), ADroneManager::StaticClass()));
+    if (!Manager)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("ZMQController: RESET_RANDOMIZED needs a DroneManager; doing a plain reset"));
+        HandleResetCommand();
+        return;
+    }
+
+    CurrentGoalPosition = FVector(0.0f, 0.0f, 1000);
+    // Only this controller's drone; the others belong to their own clients and episodes
+    Manager->ResetDrone(DronePawn, Spec);
+}
+
+void AZMQController::HandleVelocityCommand(const TArray<uint8>& Data)
 {
-    if (!DroneController || Message.empty()) return;
+    if (!DroneController) return;
 
-    zmq::message_t VelocityData = Message.pop();
-    if (VelocityData.size() == sizeof(float) * 3 && VelocityData.data())
+    if (Data.Num() == sizeof(float) * 3)
     {
-        float* VelocityArray = reinterpret_cast<float*>(VelocityData.data());
+        float VelocityArray[3];
+        FMemory::Memcpy(VelocityArray, Data.GetData(), sizeof(VelocityArray));
 
-        UE_LOG(LogTemp, Display, TEXT("[ZMQController] Velocity array from Python: %f, %f, %f"),
+        UE_LOG(LogTemp, Verbose, TEXT("[ZMQController] Velocity array from Python: %f, %f, %f"),
             VelocityArray[0], VelocityArray[1], VelocityArray[2]);
 
         FVector DesiredVelocity(VelocityArray[0], VelocityArray[1], VelocityArray[2]);
@@ -231,14 +430,21 @@ void AZMQController::SendStateData()
 
     FVector CurrentVelocity = RootPrimitive->GetPhysicsLinearVelocity();
     FVector CurrentPosition = DronePawn->GetActorLocation();
+    if (DroneController)
+    {
+        CurrentVelocity = DroneController->GetSensedVelocity(CurrentVelocity);
+        CurrentPosition = DroneController->GetSensedPosition(CurrentPosition);
+    }
 
     try
     {
+        // TIME is sim seconds and the sim clock's tick
         FString StateData = FString::Printf(
-            TEXT("VELOCITY:%f,%f,%f;POSITION:%f,%f,%f;GOAL:%f,%f,%f"),
+            TEXT("VELOCITY:%f,%f,%f;POSITION:%f,%f,%f;GOAL:%f,%f,%f;TIME:%.6f,%llu"),
             CurrentVelocity.X, CurrentVelocity.Y, CurrentVelocity.Z,
             CurrentPosition.X, CurrentPosition.Y, CurrentPosition.Z,
-            CurrentGoalPosition.X, CurrentGoalPosition.Y, CurrentGoalPosition.Z
+            CurrentGoalPosition.X, CurrentGoalPosition.Y, CurrentGoalPosition.Z,
+            FSimClock::Get().GetSimSeconds(), FSimClock::Get().GetTick()
         );
 
         zmq::multipart_t Message;
@@ -281,6 +487,11 @@ void AZMQController::InitializeImageCapture()
     CaptureComponent->bCaptureEveryFrame = false;
     CaptureComponent->bCaptureOnMovement = false;
     CaptureComponent->PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_LegacySceneCapture;
+
+    if (Configuration.bSharedMemoryFrames)
+    {
+        FrameRing.Open(TEXT("quadsim_") + FEnvPool::Get().QualifyName(Configuration.DroneID), Configuration.ImageResolution.X, Configuration.ImageResolution.Y);
+    }
 }
 
 void AZMQController::ProcessImageCapture()
@@ -291,7 +502,8 @@ void AZMQController::ProcessImageCapture()
     }
     
     bIsCapturing = true;
-    
+
+    FSimScopedTimer Timer(ESimPhase::ImageCapture);
     CaptureComponent->CaptureScene();
     RenderTarget->UpdateResourceImmediate(false);
     
@@ -303,34 +515,54 @@ void AZMQController::ProcessImageCapture()
     }
     
     FIntRect Rect(0, 0, Configuration.ImageResolution.X, Configuration.ImageResolution.Y);
+    const double SimTime = FSimClock::Get().GetSimSeconds();
     
     TArray<FColor>* ImageDataPtr = new TArray<FColor>();
     
     ENQUEUE_RENDER_COMMAND(AsyncReadPixelsCommand)(
-        [this, RenderTargetResource, Rect, ImageDataPtr](FRHICommandListImmediate& RHICmdList)
+        [this, RenderTargetResource, Rect, ImageDataPtr, SimTime](FRHICommandListImmediate& RHICmdList)
         {
-            RHICmdList.ReadSurfaceData(
-                RenderTargetResource->GetRenderTargetTexture(),
-                Rect,
-                *ImageDataPtr,
-                FReadSurfaceDataFlags(RCM_UNorm)
-            );
+            {
+                FSimScopedTimer ReadbackTimer(ESimPhase::ImageReadback);
+                RHICmdList.ReadSurfaceData(
+                    RenderTargetResource->GetRenderTargetTexture(),
+                    Rect,
+                    *ImageDataPtr,
+                    FReadSurfaceDataFlags(RCM_UNorm)
+                );
+            }
             
-            AsyncTask(ENamedThreads::GameThread, [this, ImageDataPtr]()
+            AsyncTask(ENamedThreads::GameThread, [this, ImageDataPtr, SimTime]()
             {
-                UE_LOG(LogTemp, Display, TEXT("Captured image via render command: %d pixels"), ImageDataPtr->Num());
+                UE_LOG(LogTemp, Verbose, TEXT("Captured image via render command: %d pixels"), ImageDataPtr->Num());
                 
-                AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, ImageDataPtr]()
+                AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, ImageDataPtr, SimTime]()
                 {
-                    TArray<uint8> CompressedData = CompressImageData(*ImageDataPtr);
-                    
+                    // With a shared memory ring the pixels are copied once into it and only the descriptor is sent
+                    TArray<uint8> CompressedData;
+                    const FIntPoint Size = Configuration.ImageResolution;
+                    const uint64 FrameId = ImageDataPtr->Num() == Size.X * Size.Y ? FrameRing.Write(ImageDataPtr->GetData(), Size.X, Size.Y, SimTime) : 0;
+                    if (FrameId == 0)
+                    {
+                        FSimScopedTimer EncodeTimer(ESimPhase::ImageEncode);
+                        CompressedData = CompressImageData(*ImageDataPtr);
+                    }
+
+                    FSimScopedTimer SendTimer(ESimPhase::ZMQ);
                     if (PublishSocket)
                     {
                         try
                         {
                             zmq::multipart_t Message;
                             Message.addstr(TCHAR_TO_UTF8(*Configuration.DroneID));
-                            Message.addmem(CompressedData.GetData(), CompressedData.Num());
+                            if (FrameId != 0)
+                            {
+                                Message.addstr(TCHAR_TO_UTF8(*FrameRing.MakeDescriptor(FrameId)));
+                            }
+                            else
+                            {
+                                Message.addmem(CompressedData.GetData(), CompressedData.Num());
+                            }
                             Message.send(*PublishSocket, static_cast<int>(zmq::send_flags::none));
                         }
                         catch (const zmq::error_t& Error)
@@ -340,6 +572,11 @@ void AZMQController::ProcessImageCapture()
                         }
                     }
                     
+                    if (Configuration.bEnableStepRpc && ImageDataPtr->Num() == Size.X * Size.Y)
+                    {
+                        StepServer.PublishImage(0, MoveTemp(*ImageDataPtr), Size.X, Size.Y, SimTime);
+                    }
+
                     delete ImageDataPtr;
                     bIsCapturing = false;
                 });
@@ -398,6 +635,19 @@ void AZMQController::SetDroneID(const FString& NewID)
 {
     Configuration.DroneID = NewID;
     UE_LOG(LogTemp, Display, TEXT("ZMQController DroneID set to: %s"), *Configuration.DroneID);
+
+    if (!RegisteredCommandTarget.IsEmpty())
+    {
+        FCommandJournal& Journal = FCommandJournal::Get();
+        Journal.UnregisterTarget(RegisteredCommandTarget);
+        RegisteredCommandTarget = Configuration.DroneID;
+        Journal.RegisterTarget(RegisteredCommandTarget, FOnExternalCommand::CreateUObject(this, &AZMQController::DispatchCommand));
+    }
+
+    if (StepServer.IsBound())
+    {
+        StepServer.SetTarget(0, MakeStepTarget());
+    }
 }
 
 void AZMQController::CheckAndInitialize()
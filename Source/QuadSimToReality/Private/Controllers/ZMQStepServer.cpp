@@ -0,0 +1,307 @@
+// ZMQStepServer.cpp
+#include "Controllers/ZMQStepServer.h"
+#include "Controllers/ZMQController.h"
+#include "Core/CommandJournal.h"
+#include "Core/RunProfile.h"
+#include "Utility/SimProfiler.h"
+#include <zmq_addon.hpp>
+
+FZMQStepServer::~FZMQStepServer()
+{
+    Close();
+}
+
+bool FZMQStepServer::Bind(const FZMQConfiguration& Config)
+{
+    Close();
+
+    try
+    {
+        // Replies are never dropped; a client that stops reading only grows its own queue
+        Socket = MakeShared<zmq::socket_t>(AZMQController::GetSharedContext(Config.IOThreads), zmq::socket_type::router);
+        AZMQController::ConfigureSocket(Config, *Socket, 0, 0);
+        Socket->bind(TCHAR_TO_UTF8(*AZMQController::MakeEndpoint(Config, Config.RpcPort, true)));
+        return true;
+    }
+    catch (const zmq::error_t& Error)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Step server failed to bind port %d: %s"), Config.RpcPort,
+               *FString(UTF8_TO_TCHAR(Error.what())));
+        Socket.Reset();
+        return false;
+    }
+}
+
+void FZMQStepServer::Close()
+{
+    for (TPair<uint8, FEnvironment>& Pair : Environments)
+    {
+        CancelPending(Pair.Value);
+    }
+    Socket.Reset();
+}
+
+void FZMQStepServer::SetTarget(uint8 EnvIndex, FZMQStepTarget Target)
+{
+    Environments.FindOrAdd(EnvIndex).Target = MoveTemp(Target);
+}
+
+void FZMQStepServer::RemoveTarget(uint8 EnvIndex)
+{
+    if (FEnvironment* Environment = Environments.Find(EnvIndex))
+    {
+        CancelPending(*Environment);
+        Environments.Remove(EnvIndex);
+    }
+
+    FScopeLock Lock(&ImageLock);
+    LatestImages.Remove(EnvIndex);
+}
+
+void FZMQStepServer::Poll(int32 MaxRequests)
+{
+    if (!Socket)
+    {
+        return;
+    }
+
+    FSimScopedTimer Timer(ESimPhase::ZMQ);
+
+    try
+    {
+        // ROUTER hands each request over as [client identity][request]
+        zmq::multipart_t Message;
+        for (int32 Received = 0; Received < MaxRequests; Received++)
+        {
+            if (!Message.recv(*Socket, static_cast<int>(zmq::recv_flags::dontwait)))
+            {
+                break;
+            }
+            if (Message.size() != 2 || Message[1].size() < sizeof(FZMQStepRequestHeader))
+            {
+                RejectMalformed(Message);
+                Message.clear();
+                continue;
+            }
+
+            zmq::message_t Identity = Message.pop();
+            zmq::message_t Body = Message.pop();
+
+            FPendingStep Request;
+            Request.Client.Append(static_cast<const uint8*>(Identity.data()), Identity.size());
+            FMemory::Memcpy(&Request.Header, Body.data(), sizeof(FZMQStepRequestHeader));
+            Request.Payload.Append(static_cast<const uint8*>(Body.data()) + sizeof(FZMQStepRequestHeader), Body.size() - sizeof(FZMQStepRequestHeader));
+            HandleRequest(MoveTemp(Request));
+        }
+    }
+    catch (const zmq::error_t& Error)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Step request error: %s"),
+               *FString(UTF8_TO_TCHAR(Error.what())));
+    }
+
+    for (TPair<uint8, FEnvironment>& Pair : Environments)
+    {
+        Advance(Pair.Value);
+    }
+}
+
+void FZMQStepServer::RejectMalformed(const zmq::multipart_t& Message)
+{
+    UE_LOG(LogTemp, Warning, TEXT("Step server: Dropped malformed request (%d frames, %d bytes)"),
+        static_cast<int32>(Message.size()), Message.size() > 1 ? static_cast<int32>(Message[1].size()) : 0);
+
+    // Without an identity there is nobody to answer; otherwise the client gets a reply it can match,
+    // so it does not wait out its timeout with everything pipelined behind this request
+    if (Message.size() == 0)
+    {
+        return;
+    }
+
+    FZMQStepRequestHeader Header = {};
+    if (Message.size() > 1)
+    {
+        const uint8* Body = static_cast<const uint8*>(Message[1].data());
+        const int64 BodySize = Message[1].size();
+        if (BodySize >= static_cast<int64>(sizeof(Header.RequestId)))
+        {
+            FMemory::Memcpy(&Header.RequestId, Body, sizeof(Header.RequestId));
+        }
+        if (BodySize > static_cast<int64>(sizeof(Header.RequestId)))
+        {
+            Header.Op = Body[sizeof(Header.RequestId)];
+        }
+    }
+
+    TArray<uint8> Client;
+    Client.Append(static_cast<const uint8*>(Message[0].data()), Message[0].size());
+    SendReply(Client, Header, ZMQStep::EStatus::BadRequest);
+}
+
+void FZMQStepServer::HandleRequest(FPendingStep&& Request)
+{
+    FEnvironment* Environment = Environments.Find(Request.Header.EnvIndex);
+    if (!Environment)
+    {
+        SendReply(Request.Client, Request.Header, ZMQStep::EStatus::BadRequest);
+        return;
+    }
+
+    switch (static_cast<ZMQStep::EOp>(Request.Header.Op))
+    {
+    case ZMQStep::EOp::Step:
+        if (Request.Payload.Num() != sizeof(FZMQStepAction))
+        {
+            SendReply(Request.Client, Request.Header, ZMQStep::EStatus::BadRequest);
+            break;
+        }
+        Environment->Pending.Add(MoveTemp(Request));
+        break;
+
+    case ZMQStep::EOp::Reset:
+        Environment->Pending.Add(MoveTemp(Request));
+        break;
+
+    case ZMQStep::EOp::GetImage:
+    {
+        FScopeLock Lock(&ImageLock);
+        const FLatestImage* Image = LatestImages.Find(Request.Header.EnvIndex);
+        if (!Image || Image->Pixels.Num() == 0)
+        {
+            SendReply(Request.Client, Request.Header, ZMQStep::EStatus::NoImage);
+        }
+        else
+        {
+            SendReply(Request.Client, Request.Header, ZMQStep::EStatus::Ok, &Image->Info, sizeof(Image->Info),
+                Image->Pixels.GetData(), Image->Pixels.Num() * sizeof(FColor));
+        }
+        break;
+    }
+
+    default:
+        SendReply(Request.Client, Request.Header, ZMQStep::EStatus::BadRequest);
+        break;
+    }
+}
+
+void FZMQStepServer::Advance(FEnvironment& Environment)
+{
+    // Requests run in arrival order: each one's action is applied only once the one before it has replied,
+    // so a client can pipeline steps without later actions overwriting earlier ones
+    while (Environment.Pending.Num() > 0)
+    {
+        FPendingStep& Head = Environment.Pending[0];
+        if (!Head.bStarted)
+        {
+            Head.bStarted = true;
+            Head.Remaining = Head.Header.SubSteps;
+
+            // During a replay the journal is the only command source; requests just observe the steps
+            if (!FCommandJournal::Get().IsReplaying())
+            {
+                FExternalCommand Command;
+                Command.Target = Environment.Target.CommandTarget;
+                if (static_cast<ZMQStep::EOp>(Head.Header.Op) == ZMQStep::EOp::Step)
+                {
+                    Command.Name = TEXT("VELOCITY");
+                }
+                else
+                {
+                    Command.Name = Head.Payload.Num() > 0 ? TEXT("RESET_RANDOMIZED") : TEXT("RESET");
+                }
+                Command.Data = Head.Payload;
+
+                // While recording the action lands on the next step; control steps before then do not count
+                Head.DispatchStep = FCommandJournal::Get().GetDispatchStep();
+                FCommandJournal::Get().Submit(MoveTemp(Command));
+            }
+        }
+
+        // Without control steps there is nothing to wait for
+        if (Head.Remaining > 0 && Environment.Target.HasControlSteps && Environment.Target.HasControlSteps())
+        {
+            return;
+        }
+
+        const FZMQStepState State = Environment.Target.GetState ? Environment.Target.GetState() : FZMQStepState{};
+        SendReply(Head.Client, Head.Header, ZMQStep::EStatus::Ok, &State, sizeof(State));
+        if (static_cast<ZMQStep::EOp>(Head.Header.Op) == ZMQStep::EOp::Step)
+        {
+            FRunProfile::Get().MarkMilestone(TEXT("FirstStep"));
+        }
+        Environment.Pending.RemoveAt(0);
+    }
+}
+
+void FZMQStepServer::OnControlStep(uint8 EnvIndex)
+{
+    FEnvironment* Environment = Environments.Find(EnvIndex);
+    if (!Environment || Environment->Pending.Num() == 0)
+    {
+        return;
+    }
+
+    FPendingStep& Head = Environment->Pending[0];
+    if (Head.bStarted && FCommandJournal::Get().GetStep() >= Head.DispatchStep && --Head.Remaining <= 0)
+    {
+        Advance(*Environment);
+    }
+}
+
+void FZMQStepServer::PublishImage(uint8 EnvIndex, TArray<FColor>&& Pixels, uint32 Width, uint32 Height, double SimTime)
+{
+    FScopeLock Lock(&ImageLock);
+    FLatestImage& Image = LatestImages.FindOrAdd(EnvIndex);
+    Image.Pixels = MoveTemp(Pixels);
+    Image.Info.FrameId++;
+    Image.Info.SimTime = SimTime;
+    Image.Info.Width = Width;
+    Image.Info.Height = Height;
+}
+
+void FZMQStepServer::CancelPending(FEnvironment& Environment)
+{
+    for (const FPendingStep& Pending : Environment.Pending)
+    {
+        SendReply(Pending.Client, Pending.Header, ZMQStep::EStatus::Cancelled);
+    }
+    Environment.Pending.Reset();
+}
+
+void FZMQStepServer::SendReply(const TArray<uint8>& Client, const FZMQStepRequestHeader& Request, ZMQStep::EStatus Status,
+    const void* Payload, int64 PayloadSize, const void* Extra, int64 ExtraSize)
+{
+    if (!Socket)
+    {
+        return;
+    }
+
+    FZMQStepReplyHeader Reply;
+    Reply.RequestId = Request.RequestId;
+    Reply.Op = Request.Op;
+    Reply.Status = static_cast<uint8>(Status);
+    Reply.Version = ZMQStep::Version;
+
+    zmq::message_t Body(sizeof(Reply) + PayloadSize + ExtraSize);
+    uint8* Out = static_cast<uint8*>(Body.data());
+    FMemory::Memcpy(Out, &Reply, sizeof(Reply));
+    if (PayloadSize > 0)
+    {
+        FMemory::Memcpy(Out + sizeof(Reply), Payload, PayloadSize);
+    }
+    if (ExtraSize > 0)
+    {
+        FMemory::Memcpy(Out + sizeof(Reply) + PayloadSize, Extra, ExtraSize);
+    }
+
+    try
+    {
+        Socket->send(zmq::buffer(Client.GetData(), Client.Num()), zmq::send_flags::sndmore);
+        Socket->send(Body, zmq::send_flags::none);
+    }
+    catch (const zmq::error_t& Error)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to send step reply: %s"),
+               *FString(UTF8_TO_TCHAR(Error.what())));
+    }
+}
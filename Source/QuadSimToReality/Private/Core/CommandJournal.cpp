@@ -0,0 +1,418 @@
+// CommandJournal.cpp
+#include "Core/CommandJournal.h"
+#include "Core/SimClock.h"
+#include "Core/EnvPool.h"
+#include "Pawns/QuadPawn.h"
+#include "Engine/Engine.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+
+namespace
+{
+    const ANSICHAR JournalMagic[8] = { 'Q', 'S', 'C', 'M', 'D', 'L', 'O', 'G' };
+    const uint32 JournalVersion = 1;
+
+    // Create the journal once the engine is up so the fixed step is in place before the first world ticks
+    FDelayedAutoRegisterHelper JournalAutoRegister(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+    {
+        FCommandJournal::Get();
+    });
+}
+
+FCommandJournal& FCommandJournal::Get()
+{
+    static FCommandJournal Instance;
+    return Instance;
+}
+
+FCommandJournal::FCommandJournal()
+{
+    const TCHAR* CommandLine = FCommandLine::Get();
+
+    FString ReplayPath;
+    if (FParse::Value(CommandLine, TEXT("ReplayCommands="), ReplayPath))
+    {
+        if (LoadReplay(ReplayPath))
+        {
+            Mode = EMode::Replay;
+        }
+    }
+    else if (FParse::Value(CommandLine, TEXT("RecordCommands="), JournalPath) || FParse::Param(CommandLine, TEXT("RecordCommands")))
+    {
+        Mode = EMode::Record;
+
+        float StepHz = 60.f;
+        FParse::Value(CommandLine, TEXT("FixedStepHz="), StepHz);
+        FixedDeltaTime = 1.f / FMath::Max(StepHz, 1.f);
+
+        if (!FParse::Value(CommandLine, TEXT("RandomSeed="), RandomSeed))
+        {
+            RandomSeed = static_cast<int32>(FPlatformTime::Cycles());
+        }
+    }
+
+    if (Mode == EMode::Off)
+    {
+        return;
+    }
+
+    ConfigureTimeStep();
+
+    FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FCommandJournal::OnPostWorldInitialization);
+    FWorldDelegates::OnWorldCleanup.AddRaw(this, &FCommandJournal::OnWorldCleanup);
+    FWorldDelegates::OnWorldTickStart.AddRaw(this, &FCommandJournal::OnWorldTickStart);
+    FWorldDelegates::OnWorldPostActorTick.AddRaw(this, &FCommandJournal::OnWorldPostActorTick);
+}
+
+FCommandJournal::~FCommandJournal()
+{
+    EndSession();
+}
+
+void FCommandJournal::ConfigureTimeStep()
+{
+    // Recording stays paced to wall-clock time so live clients see a normal sim; replay steps as fast as it can
+    FSimClock::Get().SetFixedStep(FixedDeltaTime, Mode == EMode::Replay);
+
+    UE_LOG(LogTemp, Display, TEXT("CommandJournal: %s at a fixed step of %.4f s"),
+        Mode == EMode::Record ? TEXT("Recording") : TEXT("Replaying"), FixedDeltaTime);
+}
+
+// ---------------------- Targets ------------------------
+
+void FCommandJournal::RegisterTarget(const FString& Target, FOnExternalCommand Handler)
+{
+    Targets.Add(Target, MoveTemp(Handler));
+}
+
+void FCommandJournal::UnregisterTarget(const FString& Target)
+{
+    Targets.Remove(Target);
+}
+
+void FCommandJournal::Dispatch(const FExternalCommand& Command)
+{
+    if (const FOnExternalCommand* Handler = Targets.Find(Command.Target))
+    {
+        Handler->ExecuteIfBound(Command);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CommandJournal: No target named %s for command %s"), *Command.Target, *Command.Name);
+    }
+}
+
+void FCommandJournal::Submit(FExternalCommand&& Command)
+{
+    if (Mode == EMode::Off || !SessionWorld.IsValid())
+    {
+        Dispatch(Command);
+        return;
+    }
+
+    if (Mode == EMode::Replay)
+    {
+        // Live input would make the replay diverge; the journal is the only source
+        return;
+    }
+
+    WriteCommand(Step + 1, Command);
+    PendingCommands.Add(MoveTemp(Command));
+}
+
+// ---------------------- Session ------------------------
+
+bool FCommandJournal::BeginSession(UWorld* World)
+{
+    SessionWorld = World;
+    Step = 0;
+    PendingCommands.Reset();
+
+    if (Mode == EMode::Record)
+    {
+        FString Path = JournalPath;
+        if (Path.IsEmpty())
+        {
+            const FString Directory = FPaths::ProjectSavedDir() / TEXT("CommandLogs");
+            IFileManager::Get().MakeDirectory(*Directory, true);
+            Path = Directory / FEnvPool::Get().QualifyName(FString::Printf(TEXT("commands_%s.qscmd"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+        }
+
+        Writer.Reset(IFileManager::Get().CreateFileWriter(*Path));
+        if (!Writer)
+        {
+            UE_LOG(LogTemp, Error, TEXT("CommandJournal: Could not open %s"), *Path);
+            SessionWorld = nullptr;
+            return false;
+        }
+
+        uint32 Version = JournalVersion;
+        Writer->Serialize(const_cast<ANSICHAR*>(JournalMagic), sizeof(JournalMagic));
+        *Writer << Version << FixedDeltaTime << RandomSeed;
+
+        UE_LOG(LogTemp, Display, TEXT("CommandJournal: Recording to %s (seed %d)"), *Path, RandomSeed);
+    }
+    else
+    {
+        ReplayCursor = 0;
+        HashCursor = 0;
+        StepsCompared = 0;
+        StepsDiverged = 0;
+        FirstDivergentStep = 0;
+        bReplayFinished = false;
+    }
+
+    // Anything that draws from the global stream (obstacle layouts, goals) repeats with the run
+    FMath::RandInit(RandomSeed);
+    FMath::SRandInit(RandomSeed);
+    return true;
+}
+
+void FCommandJournal::EndSession()
+{
+    if (!SessionWorld.IsValid() && !Writer)
+    {
+        return;
+    }
+
+    if (Writer)
+    {
+        Writer->Close();
+        Writer.Reset();
+        UE_LOG(LogTemp, Display, TEXT("CommandJournal: Recorded %llu steps"), Step);
+    }
+
+    if (Mode == EMode::Replay && !bReplayFinished)
+    {
+        FinishReplay();
+    }
+
+    SessionWorld = nullptr;
+}
+
+bool FCommandJournal::LoadReplay(const FString& Path)
+{
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *Path))
+    {
+        UE_LOG(LogTemp, Error, TEXT("CommandJournal: Could not read %s"), *Path);
+        return false;
+    }
+
+    FMemoryReader Reader(Bytes);
+
+    ANSICHAR Magic[8];
+    uint32 Version = 0;
+    Reader.Serialize(Magic, sizeof(Magic));
+    Reader << Version << FixedDeltaTime << RandomSeed;
+    if (Reader.IsError() || FMemory::Memcmp(Magic, JournalMagic, sizeof(Magic)) != 0 || Version != JournalVersion)
+    {
+        UE_LOG(LogTemp, Error, TEXT("CommandJournal: %s is not a version %u command journal"), *Path, JournalVersion);
+        return false;
+    }
+
+    while (!Reader.AtEnd() && !Reader.IsError())
+    {
+        uint8 Type = 0;
+        uint64 EntryStep = 0;
+        Reader << Type << EntryStep;
+
+        if (Type == static_cast<uint8>(EEntryType::Command))
+        {
+            FReplayCommand& Entry = ReplayCommands.AddDefaulted_GetRef();
+            Entry.Step = EntryStep;
+            Reader << Entry.Command.Target << Entry.Command.Name << Entry.Command.Data;
+        }
+        else if (Type == static_cast<uint8>(EEntryType::StateHash))
+        {
+            uint32 Hash = 0;
+            Reader << Hash;
+            RecordedHashes.Emplace(EntryStep, Hash);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Error, TEXT("CommandJournal: Corrupt entry in %s"), *Path);
+            return false;
+        }
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("CommandJournal: Loaded %d commands and %d state hashes from %s"),
+        ReplayCommands.Num(), RecordedHashes.Num(), *Path);
+    return true;
+}
+
+// ---------------------- World hooks ------------------------
+
+void FCommandJournal::OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+    // Only one world is journaled per run
+    if (World && World->IsGameWorld() && !SessionWorld.IsValid())
+    {
+        BeginSession(World);
+    }
+}
+
+void FCommandJournal::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    if (World && World == SessionWorld.Get())
+    {
+        EndSession();
+    }
+}
+
+void FCommandJournal::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != SessionWorld.Get() || TickType != LEVELTICK_All)
+    {
+        return;
+    }
+
+    Step++;
+
+    if (Mode == EMode::Record)
+    {
+        for (const FExternalCommand& Command : PendingCommands)
+        {
+            Dispatch(Command);
+        }
+        PendingCommands.Reset();
+    }
+    else
+    {
+        while (ReplayCursor < ReplayCommands.Num() && ReplayCommands[ReplayCursor].Step <= Step)
+        {
+            Dispatch(ReplayCommands[ReplayCursor].Command);
+            ReplayCursor++;
+        }
+    }
+}
+
+void FCommandJournal::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != SessionWorld.Get() || TickType != LEVELTICK_All)
+    {
+        return;
+    }
+
+    const uint32 Hash = ComputeStateHash(World);
+    if (Mode == EMode::Record)
+    {
+        WriteStateHash(Hash);
+    }
+    else if (!bReplayFinished)
+    {
+        CompareStateHash(Hash);
+        if (ReplayCursor == ReplayCommands.Num() && HashCursor == RecordedHashes.Num())
+        {
+            FinishReplay();
+        }
+    }
+}
+
+// ---------------------- Journal entries ------------------------
+
+void FCommandJournal::WriteCommand(uint64 CommandStep, FExternalCommand& Command)
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    uint8 Type = static_cast<uint8>(EEntryType::Command);
+    *Writer << Type << CommandStep << Command.Target << Command.Name << Command.Data;
+}
+
+void FCommandJournal::WriteStateHash(uint32 Hash)
+{
+    if (!Writer)
+    {
+        return;
+    }
+
+    uint8 Type = static_cast<uint8>(EEntryType::StateHash);
+    *Writer << Type << Step << Hash;
+}
+
+void FCommandJournal::CompareStateHash(uint32 Hash)
+{
+    while (HashCursor < RecordedHashes.Num() && RecordedHashes[HashCursor].Key < Step)
+    {
+        HashCursor++;
+    }
+    if (HashCursor >= RecordedHashes.Num() || RecordedHashes[HashCursor].Key != Step)
+    {
+        return;
+    }
+
+    const uint32 Recorded = RecordedHashes[HashCursor].Value;
+    HashCursor++;
+    StepsCompared++;
+
+    if (Hash == Recorded)
+    {
+        return;
+    }
+
+    if (StepsDiverged++ == 0)
+    {
+        FirstDivergentStep = Step;
+        UE_LOG(LogTemp, Warning, TEXT("CommandJournal: State diverged at step %llu (recorded %08x, replayed %08x)"), Step, Recorded, Hash);
+
+        if (FParse::Param(FCommandLine::Get(), TEXT("ReplayStopOnDivergence")))
+        {
+            FinishReplay();
+        }
+    }
+}
+
+void FCommandJournal::FinishReplay()
+{
+    bReplayFinished = true;
+
+    if (StepsDiverged == 0)
+    {
+        UE_LOG(LogTemp, Display, TEXT("CommandJournal: Replay matched the recording over %llu steps"), StepsCompared);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CommandJournal: Replay diverged on %llu of %llu steps, first at step %llu"),
+            StepsDiverged, StepsCompared, FirstDivergentStep);
+    }
+
+    const TCHAR* CommandLine = FCommandLine::Get();
+    if (FParse::Param(CommandLine, TEXT("ReplayExitWhenDone")) ||
+        (StepsDiverged > 0 && FParse::Param(CommandLine, TEXT("ReplayStopOnDivergence"))))
+    {
+        FPlatformMisc::RequestExit(false);
+    }
+}
+
+uint32 FCommandJournal::ComputeStateHash(UWorld* World)
+{
+    // Hash in DroneID order so the result does not depend on actor iteration order
+    TArray<AQuadPawn*> Drones;
+    for (TActorIterator<AQuadPawn> It(World); It; ++It)
+    {
+        Drones.Add(*It);
+    }
+    Drones.Sort([](const AQuadPawn& A, const AQuadPawn& B) { return A.DroneID < B.DroneID; });
+
+    uint32 Hash = 0;
+    for (const AQuadPawn* Drone : Drones)
+    {
+        const FTransform& Transform = Drone->GetActorTransform();
+        const FVector Location = Transform.GetLocation();
+        const FQuat Rotation = Transform.GetRotation();
+        const FVector Velocity = Drone->GetVelocity();
+
+        Hash = FCrc::MemCrc32(&Location, sizeof(Location), Hash);
+        Hash = FCrc::MemCrc32(&Rotation, sizeof(Rotation), Hash);
+        Hash = FCrc::MemCrc32(&Velocity, sizeof(Velocity), Hash);
+    }
+    return Hash;
+}
@@ -0,0 +1,107 @@
+// DomainRandomizer.cpp
+#include "Core/DomainRandomizer.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    // Accepts either a number or a [min, max] pair
+    void ParseRange(const FJsonObject& Object, const TCHAR* Field, FRandomRange& OutRange)
+    {
+        const TArray<TSharedPtr<FJsonValue>>* Pair;
+        if (Object.TryGetArrayField(Field, Pair) && Pair->Num() == 2)
+        {
+            OutRange = FRandomRange((*Pair)[0]->AsNumber(), (*Pair)[1]->AsNumber());
+            return;
+        }
+
+        float Value;
+        if (Object.TryGetNumberField(Field, Value))
+        {
+            OutRange = FRandomRange(Value);
+        }
+    }
+}
+
+bool FResetSpec::FromJson(const FString& Json, FResetSpec& OutSpec)
+{
+    TSharedPtr<FJsonObject> Object;
+    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+    if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("DomainRandomizer: Could not parse reset spec"));
+        return false;
+    }
+
+    OutSpec = FromJsonObject(*Object);
+    return true;
+}
+
+FResetSpec FResetSpec::FromJsonObject(const FJsonObject& Object)
+{
+    FResetSpec Spec;
+    Object.TryGetNumberField(TEXT("seed"), Spec.Seed);
+
+    const TSharedPtr<FJsonObject>* Spawn;
+    if (Object.TryGetObjectField(TEXT("spawn"), Spawn))
+    {
+        ParseRange(**Spawn, TEXT("x"), Spec.SpawnX);
+        ParseRange(**Spawn, TEXT("y"), Spec.SpawnY);
+        ParseRange(**Spawn, TEXT("z"), Spec.SpawnZ);
+        ParseRange(**Spawn, TEXT("yaw"), Spec.SpawnYaw);
+        ParseRange(**Spawn, TEXT("tilt"), Spec.SpawnTilt);
+    }
+
+    ParseRange(Object, TEXT("mass_scale"), Spec.MassScale);
+    ParseRange(Object, TEXT("inertia_scale"), Spec.InertiaScale);
+    ParseRange(Object, TEXT("motor_constant_scale"), Spec.MotorConstantScale);
+
+    const TSharedPtr<FJsonObject>* Wind;
+    if (Object.TryGetObjectField(TEXT("wind"), Wind))
+    {
+        ParseRange(**Wind, TEXT("acceleration"), Spec.WindAcceleration);
+        (*Wind)->TryGetNumberField(TEXT("gust_stddev"), Spec.WindGustStdDev);
+    }
+
+    const TSharedPtr<FJsonObject>* Noise;
+    if (Object.TryGetObjectField(TEXT("sensor_noise"), Noise))
+    {
+        (*Noise)->TryGetNumberField(TEXT("position"), Spec.PositionNoiseStdDev);
+        (*Noise)->TryGetNumberField(TEXT("velocity"), Spec.VelocityNoiseStdDev);
+    }
+
+    Object.TryGetNumberField(TEXT("obstacles"), Spec.ObstacleCount);
+    return Spec;
+}
+
+void FDomainRandomizer::SampleDrone(const FResetSpec& Spec, int32 DroneIndex, FDroneRandomization& OutDrone)
+{
+    FRandomStream Stream(static_cast<int32>(HashCombine(GetTypeHash(Spec.Seed), GetTypeHash(DroneIndex))));
+
+    OutDrone.SpawnLocation = FVector(Spec.SpawnX.Sample(Stream), Spec.SpawnY.Sample(Stream), Spec.SpawnZ.Sample(Stream));
+
+    const float Tilt = Spec.SpawnTilt.Sample(Stream);
+    const float TiltHeading = Stream.FRandRange(0.f, 2.f * PI);
+    OutDrone.SpawnRotation = FRotator(Tilt * FMath::Sin(TiltHeading), Spec.SpawnYaw.Sample(Stream), Tilt * FMath::Cos(TiltHeading));
+
+    OutDrone.MassScale = FMath::Max(Spec.MassScale.Sample(Stream), KINDA_SMALL_NUMBER);
+    OutDrone.InertiaScale = FMath::Max(Spec.InertiaScale.Sample(Stream), KINDA_SMALL_NUMBER);
+    OutDrone.MotorConstantScale = FMath::Max(Spec.MotorConstantScale.Sample(Stream), 0.f);
+
+    const float WindHeading = Stream.FRandRange(0.f, 2.f * PI);
+    OutDrone.WindAcceleration = FVector(FMath::Cos(WindHeading), FMath::Sin(WindHeading), 0.f) * Spec.WindAcceleration.Sample(Stream);
+    OutDrone.WindGustStdDev = Spec.WindGustStdDev;
+
+    OutDrone.PositionNoiseStdDev = Spec.PositionNoiseStdDev;
+    OutDrone.VelocityNoiseStdDev = Spec.VelocityNoiseStdDev;
+    OutDrone.GustSeed = Stream.RandHelper(MAX_int32);
+    OutDrone.NoiseSeed = Stream.RandHelper(MAX_int32);
+}
+
+float FDomainRandomizer::Gaussian(FRandomStream& Stream)
+{
+    const float U1 = FMath::Max(Stream.GetFraction(), SMALL_NUMBER);
+    const float U2 = Stream.GetFraction();
+    return FMath::Sqrt(-2.f * FMath::Loge(U1)) * FMath::Cos(2.f * PI * U2);
+}
@@ -1,14 +1,152 @@
-
 // DroneJSONConfig.cpp
 #include "Core/DroneJSONConfig.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "HAL/FileManager.h"
 
 UDroneJSONConfig* UDroneJSONConfig::Instance = nullptr;
 
+const FName FDroneConfigData::DefaultAirframeName(TEXT("default"));
+
+namespace
+{
+    const TCHAR* const AxisFieldNames[] = { TEXT("x"), TEXT("y"), TEXT("z"), TEXT("roll"), TEXT("pitch"), TEXT("yaw") };
+    static_assert(UE_ARRAY_COUNT(AxisFieldNames) == static_cast<int32>(EPIDAxis::Count), "Axis names out of sync with EPIDAxis");
+
+    void ParseFlightParams(const FJsonObject& Object, FDroneConfigData::FFlightParameters& Params)
+    {
+        Object.TryGetNumberField(TEXT("max_velocity"), Params.MaxVelocity);
+        Object.TryGetNumberField(TEXT("max_angle"), Params.MaxAngle);
+        Object.TryGetNumberField(TEXT("max_pid_output"), Params.MaxPIDOutput);
+        Object.TryGetNumberField(TEXT("altitude_threshold"), Params.AltitudeThreshold);
+        Object.TryGetNumberField(TEXT("min_altitude_local"), Params.MinAltitudeLocal);
+        Object.TryGetNumberField(TEXT("acceptable_distance"), Params.AcceptableDistance);
+    }
+
+    // Gains are written as [p, i, d]
+    bool ParseGainTriple(const TArray<TSharedPtr<FJsonValue>>& Values, FPIDGains& OutGains)
+    {
+        if (Values.Num() != 3)
+        {
+            return false;
+        }
+        OutGains = FPIDGains(Values[0]->AsNumber(), Values[1]->AsNumber(), Values[2]->AsNumber());
+        return true;
+    }
+
+    void ParseProfile(const FJsonObject& Object, FDroneConfigData::FAirframeProfile& Profile)
+    {
+        const TSharedPtr<FJsonObject>* FlightParams;
+        if (Object.TryGetObjectField(TEXT("flight_parameters"), FlightParams))
+        {
+            ParseFlightParams(**FlightParams, Profile.FlightParams);
+        }
+
+        Object.TryGetNumberField(TEXT("nominal_battery_voltage"), Profile.NominalBatteryVoltage);
+
+        const TSharedPtr<FJsonObject>* Gains;
+        if (Object.TryGetObjectField(TEXT("gains"), Gains))
+        {
+            for (int32 Axis = 0; Axis < static_cast<int32>(EPIDAxis::Count); Axis++)
+            {
+                const TArray<TSharedPtr<FJsonValue>>* Triple;
+                if ((*Gains)->TryGetArrayField(AxisFieldNames[Axis], Triple) && !ParseGainTriple(*Triple, Profile.Gains[Axis]))
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("DroneJSONConfig: %s gains for %s must be [p, i, d]"), AxisFieldNames[Axis], *Profile.Name.ToString());
+                }
+            }
+        }
+
+        const TSharedPtr<FJsonObject>* Schedules;
+        if (Object.TryGetObjectField(TEXT("gain_schedules"), Schedules))
+        {
+            for (int32 Axis = 0; Axis < static_cast<int32>(EPIDAxis::Count); Axis++)
+            {
+                const TSharedPtr<FJsonObject>* Schedule;
+                if (!(*Schedules)->TryGetObjectField(AxisFieldNames[Axis], Schedule))
+                {
+                    continue;
+                }
+
+                FString VariableName;
+                (*Schedule)->TryGetStringField(TEXT("variable"), VariableName);
+
+                TArray<float> Breakpoints;
+                TArray<FPIDGains> Points;
+                const TArray<TSharedPtr<FJsonValue>>* BreakpointValues;
+                const TArray<TSharedPtr<FJsonValue>>* GainValues;
+                if ((*Schedule)->TryGetArrayField(TEXT("breakpoints"), BreakpointValues) &&
+                    (*Schedule)->TryGetArrayField(TEXT("gains"), GainValues))
+                {
+                    for (const TSharedPtr<FJsonValue>& Value : *BreakpointValues)
+                    {
+                        Breakpoints.Add(Value->AsNumber());
+                    }
+                    for (const TSharedPtr<FJsonValue>& Value : *GainValues)
+                    {
+                        FPIDGains Point;
+                        if (ParseGainTriple(Value->AsArray(), Point))
+                        {
+                            Points.Add(Point);
+                        }
+                    }
+                }
+
+                if (!Profile.Schedules[Axis].Build(FGainScheduleTable::ParseVariable(VariableName), Breakpoints, Points))
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("DroneJSONConfig: Ignoring invalid %s gain schedule for %s"), AxisFieldNames[Axis], *Profile.Name.ToString());
+                }
+            }
+        }
+    }
+}
+
+FDroneConfigData::FDroneConfigData()
+{
+    // Built-in airframe, tuned for the stock quad
+    FAirframeProfile& Default = Airframes.Add(DefaultAirframeName);
+    Default.Name = DefaultAirframeName;
+    Default.FlightParams = FlightParams;
+    Default.Gains[static_cast<int32>(EPIDAxis::X)] = FPIDGains(1.f, 0.f, 0.1f);
+    Default.Gains[static_cast<int32>(EPIDAxis::Y)] = FPIDGains(1.f, 0.f, 0.1f);
+    Default.Gains[static_cast<int32>(EPIDAxis::Z)] = FPIDGains(5.f, 1.f, 0.1f);
+    Default.Gains[static_cast<int32>(EPIDAxis::Roll)] = FPIDGains(4.75f, 0.3f, 2.347f);
+    Default.Gains[static_cast<int32>(EPIDAxis::Pitch)] = FPIDGains(4.75f, 0.3f, 2.347f);
+    Default.Gains[static_cast<int32>(EPIDAxis::Yaw)] = FPIDGains(0.f, 0.f, 0.f);
+}
+
+bool FDroneConfigData::FAirframeProfile::HasSchedules() const
+{
+    for (const FGainScheduleTable& Schedule : Schedules)
+    {
+        if (Schedule.IsActive())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+const FDroneConfigData::FAirframeProfile& FDroneConfigData::GetProfile(const FString& DroneID) const
+{
+    if (const FAirframeProfile* Profile = DroneProfiles.Find(DroneID))
+    {
+        return *Profile;
+    }
+    return Airframes.FindChecked(DefaultAirframeName);
+}
+
 UDroneJSONConfig::UDroneJSONConfig()
 {
-    LoadConfig();
+    // Always have a valid snapshot, even if the file is missing or malformed
+    Snapshots.Add(MakeUnique<FDroneConfigData>());
+    CurrentConfig.store(Snapshots.Last().Get(), std::memory_order_release);
+
+    // The file is read by the instance made in Get(), not by the class default object
+    if (!HasAnyFlags(RF_ClassDefaultObject))
+    {
+        LoadConfig();
+    }
 }
 
 UDroneJSONConfig& UDroneJSONConfig::Get()
@@ -16,11 +154,22 @@ UDroneJSONConfig& UDroneJSONConfig::Get()
     if (!Instance)
     {
         Instance = NewObject<UDroneJSONConfig>();
-        Instance->AddToRoot(); 
+        Instance->AddToRoot();
+        Instance->StartFileWatcher();
     }
     return *Instance;
 }
 
+const FDroneConfigData& UDroneJSONConfig::GetConfigFor(const UObject& Object)
+{
+    if (Object.HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+    {
+        static const FDroneConfigData Defaults;
+        return Defaults;
+    }
+    return Get().GetConfig();
+}
+
 FString UDroneJSONConfig::GetConfigFilePath() const
 {
     return FPaths::ProjectConfigDir() / TEXT("DroneConfig.json");
@@ -28,31 +177,95 @@ FString UDroneJSONConfig::GetConfigFilePath() const
 
 bool UDroneJSONConfig::LoadConfig()
 {
+    const FString FilePath = GetConfigFilePath();
     FString JsonString;
-    if (!FFileHelper::LoadFileToString(JsonString, *GetConfigFilePath()))
+    if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
     {
         return false;
     }
+    LastFileTimestamp = IFileManager::Get().GetTimeStamp(*FilePath);
 
     TSharedPtr<FJsonObject> JsonObject;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
 
     if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
     {
+        UE_LOG(LogTemp, Warning, TEXT("DroneJSONConfig: Failed to parse %s, keeping version %u"), *FilePath, GetVersion());
         return false;
     }
 
+    // Build the new snapshot off to the side; fields missing from the file keep their previous value
+    TUniquePtr<FDroneConfigData> NewConfig = MakeUnique<FDroneConfigData>(GetConfig());
+    FDroneConfigData& Config = *NewConfig;
+    Config.Version = GetVersion() + 1;
+
     const TSharedPtr<FJsonObject>* FlightParams;
     if (JsonObject->TryGetObjectField(TEXT("flight_parameters"), FlightParams))
     {
-        (*FlightParams)->TryGetNumberField(TEXT("max_velocity"), Config.FlightParams.MaxVelocity);
-        (*FlightParams)->TryGetNumberField(TEXT("max_angle"), Config.FlightParams.MaxAngle);
-        (*FlightParams)->TryGetNumberField(TEXT("max_pid_output"), Config.FlightParams.MaxPIDOutput);
-        (*FlightParams)->TryGetNumberField(TEXT("altitude_threshold"), Config.FlightParams.AltitudeThreshold);
-        (*FlightParams)->TryGetNumberField(TEXT("min_altitude_local"), Config.FlightParams.MinAltitudeLocal);
-        (*FlightParams)->TryGetNumberField(TEXT("acceptable_distance"), Config.FlightParams.AcceptableDistance);
+        ParseFlightParams(**FlightParams, Config.FlightParams);
     }
-    
+
+    // Airframes and per-drone profiles are rebuilt from scratch so removed entries disappear.
+    // The top-level flight parameters seed the default airframe, which every other profile inherits.
+    {
+        const FDroneConfigData BuiltIn;
+        Config.Airframes = BuiltIn.Airframes;
+        Config.DroneProfiles.Reset();
+    }
+    Config.Airframes[FDroneConfigData::DefaultAirframeName].FlightParams = Config.FlightParams;
+
+    const TSharedPtr<FJsonObject>* Airframes;
+    if (JsonObject->TryGetObjectField(TEXT("airframes"), Airframes))
+    {
+        // Parse the default first so the others can inherit its overrides
+        const TSharedPtr<FJsonObject>* DefaultAirframe;
+        if ((*Airframes)->TryGetObjectField(FDroneConfigData::DefaultAirframeName.ToString(), DefaultAirframe))
+        {
+            ParseProfile(**DefaultAirframe, Config.Airframes[FDroneConfigData::DefaultAirframeName]);
+        }
+
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*Airframes)->Values)
+        {
+            const FName AirframeName(*Entry.Key);
+            const TSharedPtr<FJsonObject>* AirframeObject;
+            if (AirframeName == FDroneConfigData::DefaultAirframeName || !Entry.Value->TryGetObject(AirframeObject))
+            {
+                continue;
+            }
+
+            FDroneConfigData::FAirframeProfile Profile = Config.Airframes[FDroneConfigData::DefaultAirframeName];
+            Profile.Name = AirframeName;
+            ParseProfile(**AirframeObject, Profile);
+            Config.Airframes.Add(AirframeName, MoveTemp(Profile));
+        }
+    }
+
+    const TSharedPtr<FJsonObject>* Drones;
+    if (JsonObject->TryGetObjectField(TEXT("drones"), Drones))
+    {
+        for (const TPair<FString, TSharedPtr<FJsonValue>>& Entry : (*Drones)->Values)
+        {
+            const TSharedPtr<FJsonObject>* DroneObject;
+            if (!Entry.Value->TryGetObject(DroneObject))
+            {
+                continue;
+            }
+
+            FString AirframeName = FDroneConfigData::DefaultAirframeName.ToString();
+            (*DroneObject)->TryGetStringField(TEXT("airframe"), AirframeName);
+            const FDroneConfigData::FAirframeProfile* Airframe = Config.Airframes.Find(FName(*AirframeName));
+            if (!Airframe)
+            {
+                UE_LOG(LogTemp, Warning, TEXT("DroneJSONConfig: Drone %s references unknown airframe %s, using default"), *Entry.Key, *AirframeName);
+                Airframe = &Config.Airframes[FDroneConfigData::DefaultAirframeName];
+            }
+
+            FDroneConfigData::FAirframeProfile Profile = *Airframe;
+            ParseProfile(**DroneObject, Profile);
+            Config.DroneProfiles.Add(Entry.Key, MoveTemp(Profile));
+        }
+    }
+
     const TSharedPtr<FJsonObject>* ControllerParams;
     if (JsonObject->TryGetObjectField(TEXT("controller"), ControllerParams))
     {
@@ -60,7 +273,7 @@ bool UDroneJSONConfig::LoadConfig()
         (*ControllerParams)->TryGetNumberField(TEXT("yaw_rate"), Config.ControllerParams.YawRate);
         (*ControllerParams)->TryGetNumberField(TEXT("min_velocity_for_yaw"), Config.ControllerParams.MinVelocityForYaw);
     }
-    
+
     const TSharedPtr<FJsonObject>* ObstacleParams;
     if (JsonObject->TryGetObjectField(TEXT("obstacle_parameters"), ObstacleParams))
     {
@@ -68,10 +281,84 @@ bool UDroneJSONConfig::LoadConfig()
         (*ObstacleParams)->TryGetNumberField(TEXT("inner_boundary"), Config.ObstacleParams.InnerBoundarySize);
         (*ObstacleParams)->TryGetNumberField(TEXT("spawn_height"), Config.ObstacleParams.SpawnHeight);
     }
+
+    const TSharedPtr<FJsonObject>* FlightRecorderParams;
+    if (JsonObject->TryGetObjectField(TEXT("flight_recorder"), FlightRecorderParams))
+    {
+        (*FlightRecorderParams)->TryGetBoolField(TEXT("enabled"), Config.FlightRecorderParams.bEnabled);
+        (*FlightRecorderParams)->TryGetStringField(TEXT("directory"), Config.FlightRecorderParams.Directory);
+    }
+
+    const TSharedPtr<FJsonObject>* HotReloadParams;
+    if (JsonObject->TryGetObjectField(TEXT("hot_reload"), HotReloadParams))
+    {
+        (*HotReloadParams)->TryGetBoolField(TEXT("enabled"), Config.HotReloadParams.bEnabled);
+        (*HotReloadParams)->TryGetNumberField(TEXT("poll_interval"), Config.HotReloadParams.PollInterval);
+    }
+
+    // Publish: readers see either the old or the new snapshot, never a partially written one
+    const bool bWatcherSettingsChanged =
+        Config.HotReloadParams.bEnabled != GetConfig().HotReloadParams.bEnabled ||
+        Config.HotReloadParams.PollInterval != GetConfig().HotReloadParams.PollInterval;
+
+    Snapshots.Add(MoveTemp(NewConfig));
+    CurrentConfig.store(Snapshots.Last().Get(), std::memory_order_release);
+
+    UE_LOG(LogTemp, Display, TEXT("DroneJSONConfig: Published config version %u"), GetVersion());
+
+    if (bWatcherSettingsChanged && FileWatcherHandle.IsValid())
+    {
+        StopFileWatcher();
+        StartFileWatcher();
+    }
+
+    ConfigChanged.Broadcast(GetConfig());
     return true;
 }
 
 bool UDroneJSONConfig::ReloadConfig()
 {
     return LoadConfig();
-}
\ No newline at end of file
+}
+
+void UDroneJSONConfig::StartFileWatcher()
+{
+    const FDroneConfigData::FHotReloadParameters& Params = GetConfig().HotReloadParams;
+    if (!Params.bEnabled || FileWatcherHandle.IsValid())
+    {
+        return;
+    }
+
+    // Polling the timestamp works in every build configuration, unlike the editor-only DirectoryWatcher
+    FileWatcherHandle = FTSTicker::GetCoreTicker().AddTicker(
+        FTickerDelegate::CreateUObject(this, &UDroneJSONConfig::PollConfigFile),
+        FMath::Max(Params.PollInterval, 0.1f));
+}
+
+void UDroneJSONConfig::StopFileWatcher()
+{
+    if (FileWatcherHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(FileWatcherHandle);
+        FileWatcherHandle.Reset();
+    }
+}
+
+bool UDroneJSONConfig::PollConfigFile(float DeltaTime)
+{
+    const FDateTime Timestamp = IFileManager::Get().GetTimeStamp(*GetConfigFilePath());
+    if (Timestamp != FDateTime::MinValue() && Timestamp != LastFileTimestamp)
+    {
+        UE_LOG(LogTemp, Display, TEXT("DroneJSONConfig: Detected change to %s, reloading"), *GetConfigFilePath());
+        // Record the timestamp even if parsing fails so a half-saved file isn't retried every poll
+        LastFileTimestamp = Timestamp;
+        LoadConfig();
+    }
+    return true;
+}
+
+void UDroneJSONConfig::BeginDestroy()
+{
+    StopFileWatcher();
+    Super::BeginDestroy();
+}
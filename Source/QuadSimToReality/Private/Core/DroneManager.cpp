@@ -1,6 +1,17 @@
 #include "Core/DroneManager.h"
 #include "Pawns/QuadPawn.h"
 #include "Controllers/ROS2Controller.h" // Replace ZMQController include
+#include "Controllers/ROS2Bridge.h"
+#include "Controllers/QuadDroneController.h"
+#include "Utility/ObstacleManager.h"
+#include "UI/AsyncHud.h"
+#include "UI/ImGuiUtil.h"
+#include "UI/CameraMosaicComponent.h"
+#include "UI/PerfHud.h"
+#include "Utility/SimProfiler.h"
+#include "Core/SimClock.h"
+#include "Core/CommandJournal.h"
+#include "Core/RunProfile.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "imgui.h"
@@ -10,6 +21,8 @@ ADroneManager::ADroneManager()
 {
     PrimaryActorTick.bCanEverTick = true;
     SelectedDroneIndex = 0;
+
+    CameraMosaic = CreateDefaultSubobject<UCameraMosaicComponent>(TEXT("CameraMosaic"));
 }
 
 void ADroneManager::BeginPlay()
@@ -34,13 +47,26 @@ void ADroneManager::BeginPlay()
     {
         if (AQuadPawn* Pawn = Cast<AQuadPawn>(Actor))
         {
-            AllDrones.Add(Pawn);
+            AddDrone(Pawn);
         }
     }
+
+    // One bridge serves every drone; it picks up the ones registered above when it begins play
+    if (bSpawnROS2Bridge && FRunProfile::Get().WantsROS2() && !UGameplayStatics::GetActorOfClass(GetWorld(), AROS2Bridge::StaticClass()))
+    {
+        UClass* BridgeClass = ROS2BridgeClass ? ROS2BridgeClass.Get() : AROS2Bridge::StaticClass();
+        GetWorld()->SpawnActor<AROS2Bridge>(BridgeClass, FTransform::Identity);
+    }
+
+    FAsyncHud::Get().Register(GetWorld());
+    FSimProfiler::Get().BindPhysics(GetWorld());
 }
 
 void ADroneManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+    FAsyncHud::Get().Unregister(GetWorld());
+    FSimProfiler::Get().UnbindPhysics(GetWorld());
+
     if (UWorld* World = GetWorld())
     {
         World->RemoveOnActorSpawnedHandler(OnActorSpawnedHandle);
@@ -52,7 +78,23 @@ void ADroneManager::OnActorSpawned(AActor* SpawnedActor)
 {
     if (AQuadPawn* Pawn = Cast<AQuadPawn>(SpawnedActor))
     {
-        AllDrones.Add(Pawn);
+        AddDrone(Pawn);
+    }
+}
+
+void ADroneManager::AddDrone(AQuadPawn* Pawn)
+{
+    AllDrones.Add(Pawn);
+    Pawn->OnEndPlay.AddUniqueDynamic(this, &ADroneManager::OnDroneEndPlay);
+    DroneAddedEvent.Broadcast(Pawn);
+}
+
+void ADroneManager::OnDroneEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+    if (AQuadPawn* Pawn = Cast<AQuadPawn>(Actor))
+    {
+        AllDrones.Remove(Pawn);
+        DroneRemovedEvent.Broadcast(Pawn);
     }
 }
 
@@ -88,6 +130,35 @@ void ADroneManager::Tick(float DeltaTime)
         }
     }
 
+    if (SelectedDroneIndex >= AllDrones.Num())
+    {
+        SelectedDroneIndex = 0;
+    }
+
+    // Only the game thread HUD's perf window turns the profiler on or off; without it nobody reads the
+    // timers, so stop paying for them (a capture in flight still finishes)
+    const bool bGameThreadHud = UImGuiUtil::IsUIActive() && !FAsyncHud::IsEnabled();
+    if (!bGameThreadHud)
+    {
+        FSimProfiler& Profiler = FSimProfiler::Get();
+        Profiler.SetEnabled(Profiler.IsCapturing());
+    }
+
+    // Headless runs and worlds without an ImGui viewport skip the HUD entirely
+    if (!UImGuiUtil::IsUIActive())
+    {
+        PossessSelectedDrone();
+        return;
+    }
+
+    // ImGui runs on a worker in this mode; the game thread only hands it a copy of the sim state
+    if (FAsyncHud::IsEnabled())
+    {
+        PublishHudSnapshot();
+        PossessSelectedDrone();
+        return;
+    }
+
     // // Build a quick lookup map from drone (AQuadPawn*) to its ROS2 controller.
     // TMap<AQuadPawn*, AROS2Controller*> DroneToROS2Map;
     // for (const TWeakObjectPtr<AROS2Controller>& ControllerWeak : AllROS2Controllers)
@@ -101,52 +172,32 @@ void ADroneManager::Tick(float DeltaTime)
     //     }
     // }
 
+    FSimScopedTimer UITimer(ESimPhase::UI);
+
     // Prepare the drone labels for the ImGui interface.
     ImGui::Begin("Global Drone Manager");
     ImGui::Text("Select which drone to possess:");
 
-    TArray<const char*> DroneLabels;
-    DroneLabels.Reset();
+    // Labels are kept as FStrings and converted where ImGui reads them, so no pointer outlives its conversion
+    TArray<FString> DroneLabels;
+    DroneLabels.Reserve(AllDrones.Num());
 
     for (int32 i = 0; i < AllDrones.Num(); i++)
     {
         AQuadPawn* Drone = AllDrones[i].Get();
-        FString DroneID;
-
-        if (Drone)
-        {
-            // AROS2Controller* ROS2ControllerForDrone = DroneToROS2Map.FindRef(Drone);
-            // if (ROS2ControllerForDrone)
-            // {
-            //     DroneID = ROS2ControllerForDrone->GetConfiguration().DroneID;
-            // }
-            // else
-            // {
-            //     DroneID = FString::Printf(TEXT("Drone%d"), i + 1);
-            // }
-        }
-        else
-        {
-            DroneID = FString::Printf(TEXT("Drone%d"), i + 1);
-        }
-        FString Label = FString::Printf(TEXT("%s##%d"), *DroneID, i);
-        DroneLabels.Add(TCHAR_TO_UTF8(*Label));
+        const FString DroneID = Drone && !Drone->DroneID.IsEmpty() ? Drone->DroneID : FString::Printf(TEXT("Drone%d"), i + 1);
+        DroneLabels.Add(FString::Printf(TEXT("%s##%d"), *DroneID, i));
     }
 
     if (DroneLabels.Num() > 0)
     {
-        if (SelectedDroneIndex >= DroneLabels.Num())
-        {
-            SelectedDroneIndex = 0;
-        }
-
-        if (ImGui::BeginCombo("Active Drone", DroneLabels[SelectedDroneIndex]))
+        if (ImGui::BeginCombo("Active Drone", TCHAR_TO_UTF8(*DroneLabels[SelectedDroneIndex])))
         {
             for (int32 i = 0; i < DroneLabels.Num(); i++)
             {
                 ImGui::PushID(i);
                 bool bSelected = (SelectedDroneIndex == i);
-                if (ImGui::Selectable(DroneLabels[i], bSelected))
+                if (ImGui::Selectable(TCHAR_TO_UTF8(*DroneLabels[i]), bSelected))
                 {
                     SelectedDroneIndex = i;
                 }
@@ -159,45 +210,132 @@ void ADroneManager::Tick(float DeltaTime)
             ImGui::EndCombo();
         }
 
-        // Possess the selected drone.
-        APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
-        if (PC && AllDrones.IsValidIndex(SelectedDroneIndex))
-        {
-            AQuadPawn* SelectedPawn = AllDrones[SelectedDroneIndex].Get();
-            if (SelectedPawn && PC->GetPawn() != SelectedPawn)
-            {
-                PC->Possess(SelectedPawn);
-            }
-        }
+        PossessSelectedDrone();
 
         if (ImGui::Button("Spawn Drone"))
         {
-            if (AllDrones.IsValidIndex(SelectedDroneIndex))
-            {
-                AQuadPawn* SelectedPawn = AllDrones[SelectedDroneIndex].Get();
-                if (SelectedPawn)
-                {
-                    const float SpawnOffsetDistance = 200.f;
-                    FVector RightOffset = SelectedPawn->GetActorRightVector() * SpawnOffsetDistance;
-                    FVector SpawnLocation = SelectedPawn->GetActorLocation() + RightOffset;
-                    FRotator SpawnRotation = SelectedPawn->GetActorRotation();
-
-                    // Spawn a new drone (and its corresponding ROS2Controller).
-                    AQuadPawn* NewDrone = SpawnDrone(SpawnLocation, SpawnRotation);
-                    if (NewDrone)
-                    {
-                        UE_LOG(LogTemp, Display, TEXT("Spawned new drone at %s"), *SpawnLocation.ToString());
-                    }
-                }
-            }
+            SpawnDroneNextToSelected();
         }
+
+        ImGui::SameLine();
+        ImGui::Checkbox("Camera Mosaic", &CameraMosaic->bShowWindow);
+
+        ImGui::SameLine();
+        ImGui::Checkbox("Performance", &bShowPerfHud);
     }
     else
     {
         ImGui::Text("No drones spawned yet.");
     }
 
+    FSimClock& Clock = FSimClock::Get();
+    ImGui::Separator();
+    ImGui::Text("Sim time %.2f s, tick %llu, %.2fx real time", Clock.GetSimSeconds(), static_cast<unsigned long long>(Clock.GetTick()), Clock.GetRealTimeFactor());
+
+    // The command journal owns the pacing while it records or replays
+    ImGui::BeginDisabled(FCommandJournal::Get().GetMode() != FCommandJournal::EMode::Off);
+    bool bMaxSpeed = Clock.IsMaxSpeed();
+    if (ImGui::Checkbox("Max speed", &bMaxSpeed))
+    {
+        Clock.SetMaxSpeed(bMaxSpeed);
+    }
+    ImGui::EndDisabled();
+
+    if (!bMaxSpeed)
+    {
+        ImGui::SameLine();
+        ImGui::SetNextItemWidth(150.0f);
+        float Dilation = Clock.GetDilation();
+        if (ImGui::SliderFloat("Time dilation", &Dilation, 0.05f, 4.0f, "%.2fx", ImGuiSliderFlags_Logarithmic))
+        {
+            Clock.SetDilation(Dilation);
+        }
+    }
+
     ImGui::End();
+
+    if (CameraMosaic->bShowWindow)
+    {
+        CameraMosaic->SetDrones(GetDroneList());
+        CameraMosaic->DrawWindow(SelectedDroneIndex);
+    }
+
+    FPerfHud::Draw(bShowPerfHud);
+}
+
+void ADroneManager::PossessSelectedDrone()
+{
+    APlayerController* PC = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+    if (PC && AllDrones.IsValidIndex(SelectedDroneIndex))
+    {
+        AQuadPawn* SelectedPawn = AllDrones[SelectedDroneIndex].Get();
+        if (SelectedPawn && PC->GetPawn() != SelectedPawn)
+        {
+            PC->Possess(SelectedPawn);
+        }
+    }
+}
+
+void ADroneManager::SpawnDroneNextToSelected()
+{
+    if (!AllDrones.IsValidIndex(SelectedDroneIndex))
+    {
+        return;
+    }
+
+    AQuadPawn* SelectedPawn = AllDrones[SelectedDroneIndex].Get();
+    if (SelectedPawn)
+    {
+        const float SpawnOffsetDistance = 200.f;
+        FVector RightOffset = SelectedPawn->GetActorRightVector() * SpawnOffsetDistance;
+        FVector SpawnLocation = SelectedPawn->GetActorLocation() + RightOffset;
+        FRotator SpawnRotation = SelectedPawn->GetActorRotation();
+
+        // Spawn a new drone (and its corresponding ROS2Controller).
+        AQuadPawn* NewDrone = SpawnDrone(SpawnLocation, SpawnRotation);
+        if (NewDrone)
+        {
+            UE_LOG(LogTemp, Display, TEXT("Spawned new drone at %s"), *SpawnLocation.ToString());
+        }
+    }
+}
+
+void ADroneManager::PublishHudSnapshot()
+{
+    FSimHudSnapshot& Snapshot = FAsyncHud::Get().BeginPublish();
+    Snapshot.FrameNumber = GFrameCounter;
+    Snapshot.SimTime = FSimClock::Get().GetSimSeconds();
+    Snapshot.SelectedDrone = SelectedDroneIndex;
+    Snapshot.Manager = this;
+
+    // Reuses the buffer's allocations from the last time it was written
+    Snapshot.Drones.SetNum(AllDrones.Num(), EAllowShrinking::No);
+    for (int32 i = 0; i < AllDrones.Num(); i++)
+    {
+        FDroneHudState& State = Snapshot.Drones[i];
+        AQuadPawn* Drone = AllDrones[i].Get();
+        State.Pawn = Drone;
+        State.DroneID = Drone && !Drone->DroneID.IsEmpty() ? Drone->DroneID : FString::Printf(TEXT("Drone%d"), i + 1);
+        if (!Drone)
+        {
+            continue;
+        }
+
+        State.Position = Drone->GetActorLocation();
+        State.Velocity = Drone->GetVelocity();
+        State.Rotation = Drone->GetActorRotation();
+
+        if (UQuadDroneController* Controller = Drone->QuadController)
+        {
+            State.DesiredVelocity = Controller->GetDesiredVelocity();
+            for (int32 t = 0; t < 4; t++)
+            {
+                State.Thrusts[t] = Controller->Thrusts.IsValidIndex(t) ? Controller->Thrusts[t] : 0.f;
+            }
+        }
+    }
+
+    FAsyncHud::Get().Publish();
 }
 
 AQuadPawn* ADroneManager::SpawnDrone(const FVector& SpawnLocation, const FRotator& SpawnRotation)
@@ -252,4 +390,37 @@ TArray<AQuadPawn*> ADroneManager::GetDroneList() const
         }
     }
     return DroneList;
-}
\ No newline at end of file
+}
+
+void ADroneManager::ResetDrone(AQuadPawn* Drone, const FResetSpec& Spec)
+{
+    if (!Drone || !Drone->QuadController)
+    {
+        return;
+    }
+
+    // Order by DroneID so each drone keeps its random stream regardless of spawn order
+    TArray<AQuadPawn*> Drones = GetDroneList();
+    Drones.Sort([](const AQuadPawn& A, const AQuadPawn& B) { return A.DroneID < B.DroneID; });
+    const int32 DroneIndex = Drones.Find(Drone);
+    if (DroneIndex == INDEX_NONE)
+    {
+        return;
+    }
+
+    if (Spec.ObstacleCount >= 0 && (Spec.Seed != LastObstacleSeed || Spec.ObstacleCount != LastObstacleCount))
+    {
+        if (AObstacleManager* ObstacleManager = Cast<AObstacleManager>(UGameplayStatics::GetActorOfClass(GetWorld(), AObstacleManager::StaticClass())))
+        {
+            ObstacleManager->CreateObstaclesWithSeed(Spec.ObstacleCount, Spec.Seed, EGoalPosition::Random, false);
+            LastObstacleSeed = Spec.Seed;
+            LastObstacleCount = Spec.ObstacleCount;
+        }
+    }
+
+    FDroneRandomization Randomization;
+    FDomainRandomizer::SampleDrone(Spec, DroneIndex, Randomization);
+    Drone->QuadController->ApplyRandomization(Randomization);
+
+    UE_LOG(LogTemp, Display, TEXT("DroneManager: Reset %s with seed %d"), *Drone->DroneID, Spec.Seed);
+}
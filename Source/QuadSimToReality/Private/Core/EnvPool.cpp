@@ -0,0 +1,148 @@
+// EnvPool.cpp
+#include "Core/EnvPool.h"
+#include "Core/SimClock.h"
+#include "Core/RunProfile.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    // Ports and names have to be settled before the first controller binds
+    FDelayedAutoRegisterHelper EnvPoolAutoRegister(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+    {
+        FEnvPool::Get();
+    });
+}
+
+FEnvPool& FEnvPool::Get()
+{
+    static FEnvPool Instance;
+    return Instance;
+}
+
+FEnvPool::FEnvPool()
+{
+    const TCHAR* CommandLine = FCommandLine::Get();
+    if (!FParse::Value(CommandLine, TEXT("EnvIndex="), EnvIndex) || EnvIndex < 0)
+    {
+        EnvIndex = -1;
+        return;
+    }
+
+    FParse::Value(CommandLine, TEXT("EnvPortStride="), PortStride);
+    PortStride = FMath::Max(PortStride, 1);
+
+    if (!FParse::Value(CommandLine, TEXT("ReadyFile="), ReadyFilePath))
+    {
+        ReadyFilePath = FPaths::ProjectSavedDir() / TEXT("EnvPool") / FString::Printf(TEXT("env_%d.json"), EnvIndex);
+    }
+    ReadyFilePath = FPaths::ConvertRelativePathToFull(ReadyFilePath);
+
+    // A file left over from an earlier run would announce this instance before it is up
+    RemoveReadyFile();
+
+    FWorldDelegates::OnWorldTickStart.AddRaw(this, &FEnvPool::OnWorldTickStart);
+    FCoreDelegates::OnPreExit.AddRaw(this, &FEnvPool::RemoveReadyFile);
+
+    UE_LOG(LogTemp, Display, TEXT("EnvPool: instance %d, ports offset by %d, ready file %s"),
+        EnvIndex, EnvIndex * PortStride, *ReadyFilePath);
+}
+
+FString FEnvPool::QualifyName(const FString& Name) const
+{
+    return IsPooled() ? FString::Printf(TEXT("env%d_%s"), EnvIndex, *Name) : Name;
+}
+
+void FEnvPool::ReportEndpoint(const FString& Owner, const FString& Kind, const FString& Endpoint)
+{
+    Endpoints.FindOrAdd(Owner).Add(Kind, Endpoint);
+    FRunProfile::Get().MarkMilestone(TEXT("SocketsBound"));
+}
+
+void FEnvPool::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (bReadyWritten || !World || !World->IsGameWorld() || !World->HasBegunPlay())
+    {
+        return;
+    }
+
+    // Controllers bind during BeginPlay or on one of their first ticks, so the file waits until a whole
+    // tick has passed without a new endpoint. Writing at the first one would leave the late binders out.
+    int32 EndpointCount = 0;
+    for (const TPair<FString, TMap<FString, FString>>& Owner : Endpoints)
+    {
+        EndpointCount += Owner.Value.Num();
+    }
+
+    if (EndpointCount == 0 || EndpointCount != SettledEndpointCount)
+    {
+        SettledEndpointCount = EndpointCount;
+        return;
+    }
+
+    WriteReadyFile(World);
+}
+
+void FEnvPool::WriteReadyFile(UWorld* World)
+{
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetNumberField(TEXT("env_index"), EnvIndex);
+    Root->SetNumberField(TEXT("pid"), FPlatformProcess::GetCurrentProcessId());
+    Root->SetNumberField(TEXT("port_stride"), PortStride);
+    Root->SetNumberField(TEXT("startup_seconds"), FPlatformTime::Seconds() - GStartTime);
+    Root->SetNumberField(TEXT("sim_tick"), static_cast<double>(FSimClock::Get().GetTick()));
+    Root->SetStringField(TEXT("map"), World->GetMapName());
+    Root->SetStringField(TEXT("run_profile"), FRunProfile::Get().GetProfileName());
+
+    TSharedRef<FJsonObject> MilestoneObject = MakeShared<FJsonObject>();
+    for (const TPair<FString, double>& Milestone : FRunProfile::Get().GetMilestones())
+    {
+        MilestoneObject->SetNumberField(Milestone.Key, Milestone.Value);
+    }
+    Root->SetObjectField(TEXT("milestones"), MilestoneObject);
+
+    TSharedRef<FJsonObject> EndpointObject = MakeShared<FJsonObject>();
+    for (const TPair<FString, TMap<FString, FString>>& Owner : Endpoints)
+    {
+        TSharedRef<FJsonObject> OwnerObject = MakeShared<FJsonObject>();
+        for (const TPair<FString, FString>& Endpoint : Owner.Value)
+        {
+            OwnerObject->SetStringField(Endpoint.Key, Endpoint.Value);
+        }
+        EndpointObject->SetObjectField(Owner.Key, OwnerObject);
+    }
+    Root->SetObjectField(TEXT("endpoints"), EndpointObject);
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Root, Writer);
+
+    // Written aside and renamed, so a launcher polling for the file never reads half of it
+    const FString TempPath = ReadyFilePath + TEXT(".tmp");
+    if (!FFileHelper::SaveStringToFile(Json, *TempPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM) ||
+        !IFileManager::Get().Move(*ReadyFilePath, *TempPath, true))
+    {
+        UE_LOG(LogTemp, Error, TEXT("EnvPool: Failed to write ready file %s"), *ReadyFilePath);
+        return;
+    }
+
+    bReadyWritten = true;
+    UE_LOG(LogTemp, Display, TEXT("EnvPool: instance %d ready after %.2f s"), EnvIndex, FPlatformTime::Seconds() - GStartTime);
+}
+
+void FEnvPool::RemoveReadyFile()
+{
+    if (!ReadyFilePath.IsEmpty())
+    {
+        IFileManager::Get().Delete(*ReadyFilePath, false, false, true);
+        bReadyWritten = false;
+    }
+}
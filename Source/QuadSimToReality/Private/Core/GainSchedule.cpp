@@ -0,0 +1,90 @@
+// GainSchedule.cpp
+#include "Core/GainSchedule.h"
+
+bool FGainScheduleTable::Build(EGainScheduleVariable InVariable, const TArray<float>& Breakpoints, const TArray<FPIDGains>& Gains, int32 NumSamples)
+{
+    Samples.Reset();
+    Variable = EGainScheduleVariable::None;
+
+    if (InVariable == EGainScheduleVariable::None || Breakpoints.Num() == 0 || Breakpoints.Num() != Gains.Num())
+    {
+        return false;
+    }
+
+    for (int32 i = 1; i < Breakpoints.Num(); i++)
+    {
+        if (Breakpoints[i] <= Breakpoints[i - 1])
+        {
+            UE_LOG(LogTemp, Warning, TEXT("GainSchedule: Breakpoints must be strictly increasing"));
+            return false;
+        }
+    }
+
+    NumSamples = FMath::Max(NumSamples, 2);
+    MinInput = Breakpoints[0];
+    const float Range = Breakpoints.Last() - Breakpoints[0];
+    const float Step = Range > 0.f ? Range / (NumSamples - 1) : 1.f;
+    InvStep = Range > 0.f ? 1.f / Step : 0.f;
+
+    // Resample the piecewise-linear curve through the breakpoints onto the uniform grid
+    Samples.SetNum(NumSamples);
+    int32 Segment = 0;
+    for (int32 s = 0; s < NumSamples; s++)
+    {
+        const float Input = MinInput + s * Step;
+        while (Segment < Breakpoints.Num() - 2 && Input > Breakpoints[Segment + 1])
+        {
+            Segment++;
+        }
+
+        if (Breakpoints.Num() == 1)
+        {
+            Samples[s] = Gains[0];
+            continue;
+        }
+
+        const float X0 = Breakpoints[Segment];
+        const float X1 = Breakpoints[Segment + 1];
+        const float Alpha = FMath::Clamp((Input - X0) / (X1 - X0), 0.f, 1.f);
+        const FPIDGains& A = Gains[Segment];
+        const FPIDGains& B = Gains[Segment + 1];
+        Samples[s] = FPIDGains(FMath::Lerp(A.P, B.P, Alpha), FMath::Lerp(A.I, B.I, Alpha), FMath::Lerp(A.D, B.D, Alpha));
+    }
+
+    Variable = InVariable;
+    return true;
+}
+
+EGainScheduleVariable FGainScheduleTable::ParseVariable(const FString& Name)
+{
+    if (Name.Equals(TEXT("ground_speed"), ESearchCase::IgnoreCase))
+    {
+        return EGainScheduleVariable::GroundSpeed;
+    }
+    if (Name.Equals(TEXT("airspeed"), ESearchCase::IgnoreCase))
+    {
+        // Older configs; the input never accounted for wind
+        UE_LOG(LogTemp, Warning, TEXT("GainSchedule: 'airspeed' is ground speed, use 'ground_speed'"));
+        return EGainScheduleVariable::GroundSpeed;
+    }
+    if (Name.Equals(TEXT("altitude"), ESearchCase::IgnoreCase))
+    {
+        return EGainScheduleVariable::Altitude;
+    }
+    if (Name.Equals(TEXT("battery_voltage"), ESearchCase::IgnoreCase))
+    {
+        return EGainScheduleVariable::BatteryVoltage;
+    }
+    return EGainScheduleVariable::None;
+}
+
+const TCHAR* FGainScheduleTable::GetVariableName(EGainScheduleVariable Variable)
+{
+    switch (Variable)
+    {
+    case EGainScheduleVariable::GroundSpeed: return TEXT("ground_speed");
+    case EGainScheduleVariable::Altitude: return TEXT("altitude");
+    case EGainScheduleVariable::BatteryVoltage: return TEXT("battery_voltage");
+    default: return TEXT("none");
+    }
+}
@@ -0,0 +1,105 @@
+// RunProfile.cpp
+#include "Core/RunProfile.h"
+#include "Core/EnvPool.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DelayedAutoRegister.h"
+
+namespace
+{
+    FDelayedAutoRegisterHelper RunProfileAutoRegister(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+    {
+        FRunProfile::Get().MarkMilestone(TEXT("EngineInit"));
+    });
+}
+
+FRunProfile& FRunProfile::Get()
+{
+    static FRunProfile Instance;
+    return Instance;
+}
+
+FRunProfile::FRunProfile()
+{
+    FString Name;
+    if (FParse::Value(FCommandLine::Get(), TEXT("RunProfile="), Name))
+    {
+        if (Name == TEXT("training"))
+        {
+            Profile = ERunProfile::Training;
+        }
+        else if (Name == TEXT("ros"))
+        {
+            Profile = ERunProfile::ROSBridge;
+        }
+        else if (Name != TEXT("operator"))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("RunProfile: Unknown profile '%s', using operator"), *Name);
+        }
+    }
+    else if (FEnvPool::Get().IsPooled() || !FApp::CanEverRender())
+    {
+        Profile = ERunProfile::Training;
+    }
+
+    FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FRunProfile::OnPostWorldInitialization);
+    FWorldDelegates::OnWorldTickStart.AddRaw(this, &FRunProfile::OnWorldTickStart);
+
+    UE_LOG(LogTemp, Display, TEXT("RunProfile: %s (UI %s, debug draw %s, ROS2 %s)"), GetProfileName(),
+        WantsUI() ? TEXT("on") : TEXT("off"), WantsDebugDraw() ? TEXT("on") : TEXT("off"), WantsROS2() ? TEXT("on") : TEXT("off"));
+}
+
+const TCHAR* FRunProfile::GetProfileName() const
+{
+    switch (Profile)
+    {
+    case ERunProfile::Training: return TEXT("training");
+    case ERunProfile::ROSBridge: return TEXT("ros");
+    default: return TEXT("operator");
+    }
+}
+
+void FRunProfile::MarkMilestone(const TCHAR* Name)
+{
+    if (Milestones.ContainsByPredicate([Name](const TPair<FString, double>& Milestone) { return Milestone.Key == Name; }))
+    {
+        return;
+    }
+
+    const double Seconds = FPlatformTime::Seconds() - GStartTime;
+    Milestones.Emplace(Name, Seconds);
+    UE_LOG(LogTemp, Display, TEXT("RunProfile: %s after %.2f s"), Name, Seconds);
+
+    // The first step is what a trainer waits for, so that is where time-to-ready is complete
+    if (FCString::Strcmp(Name, TEXT("FirstStep")) == 0)
+    {
+        LogSummary();
+    }
+}
+
+void FRunProfile::OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+    if (World && World->IsGameWorld())
+    {
+        MarkMilestone(TEXT("WorldInit"));
+    }
+}
+
+void FRunProfile::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World && World->IsGameWorld() && World->HasBegunPlay())
+    {
+        MarkMilestone(TEXT("FirstTick"));
+        FWorldDelegates::OnWorldTickStart.RemoveAll(this);
+    }
+}
+
+void FRunProfile::LogSummary() const
+{
+    FString Summary;
+    for (const TPair<FString, double>& Milestone : Milestones)
+    {
+        Summary += FString::Printf(TEXT(" %s=%.2fs"), *Milestone.Key, Milestone.Value);
+    }
+    UE_LOG(LogTemp, Display, TEXT("RunProfile: time to ready (%s):%s"), GetProfileName(), *Summary);
+}
@@ -0,0 +1,232 @@
+// SimClock.cpp
+#include "Core/SimClock.h"
+#include "Engine/Engine.h"
+#include "GameFramework/WorldSettings.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DelayedAutoRegister.h"
+
+namespace
+{
+    // Pacing has to be in place before the first world ticks
+    FDelayedAutoRegisterHelper SimClockAutoRegister(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+    {
+        FSimClock::Get();
+    });
+
+    void SetConsoleInt(const TCHAR* Name, int32 Value)
+    {
+        if (IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name))
+        {
+            Variable->Set(Value, ECVF_SetByCode);
+        }
+    }
+
+    int32 GetConsoleInt(const TCHAR* Name, int32 Fallback)
+    {
+        const IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(Name);
+        return Variable ? Variable->GetInt() : Fallback;
+    }
+}
+
+FSimClock& FSimClock::Get()
+{
+    static FSimClock Instance;
+    return Instance;
+}
+
+FSimClock::FSimClock()
+{
+    const TCHAR* CommandLine = FCommandLine::Get();
+
+    float StepHz = 0.f;
+    FParse::Value(CommandLine, TEXT("FixedStepHz="), StepHz);
+    bMaxSpeed = FParse::Param(CommandLine, TEXT("MaxSpeed"));
+    if (bMaxSpeed && StepHz <= 0.f)
+    {
+        StepHz = 60.f;
+    }
+    FixedDeltaTime = StepHz > 0.f ? 1.f / StepHz : 0.f;
+
+    float CommandLineDilation = 1.f;
+    if (FParse::Value(CommandLine, TEXT("TimeDilation="), CommandLineDilation))
+    {
+        Dilation = FMath::Clamp(CommandLineDilation, 0.01f, 20.f);
+    }
+
+    if (FixedDeltaTime > 0.f || Dilation != 1.f)
+    {
+        ApplyPacing();
+    }
+
+    FWorldDelegates::OnPostWorldInitialization.AddRaw(this, &FSimClock::OnPostWorldInitialization);
+    FWorldDelegates::OnWorldCleanup.AddRaw(this, &FSimClock::OnWorldCleanup);
+    FWorldDelegates::OnWorldTickStart.AddRaw(this, &FSimClock::OnWorldTickStart);
+}
+
+void FSimClock::SetFixedStep(float DeltaTime, bool bInMaxSpeed)
+{
+    FixedDeltaTime = DeltaTime;
+    bMaxSpeed = bInMaxSpeed;
+    ApplyPacing();
+}
+
+void FSimClock::SetMaxSpeed(bool bInMaxSpeed)
+{
+    if (bMaxSpeed == bInMaxSpeed)
+    {
+        return;
+    }
+
+    // Running unpaced on a variable dt would just produce huge steps, so max speed implies a fixed one
+    bMaxSpeed = bInMaxSpeed;
+    if (bMaxSpeed && FixedDeltaTime <= 0.f)
+    {
+        FixedDeltaTime = 1.f / 60.f;
+    }
+    ApplyPacing();
+}
+
+void FSimClock::SetDilation(float InDilation)
+{
+    Dilation = FMath::Clamp(InDilation, 0.01f, 20.f);
+    ApplyPacing();
+}
+
+void FSimClock::ApplyPacing()
+{
+    if (bMaxSpeed)
+    {
+        // What max speed overrides is kept so turning it off puts the user's settings back
+        if (!bFrameLimitsSaved)
+        {
+            SavedVSync = GetConsoleInt(TEXT("r.VSync"), 0);
+            SavedMaxFPS = GetConsoleInt(TEXT("t.MaxFPS"), 0);
+            bSavedSmoothFrameRate = GEngine ? GEngine->bSmoothFrameRate : false;
+            bFrameLimitsSaved = true;
+        }
+
+        // The engine does not idle between frames on a fixed time step; vsync and the frame cap still would
+        FApp::SetUseFixedTimeStep(true);
+        FApp::SetFixedDeltaTime(FixedDeltaTime);
+        if (GEngine)
+        {
+            GEngine->bUseFixedFrameRate = false;
+            GEngine->bSmoothFrameRate = false;
+        }
+        SetConsoleInt(TEXT("r.VSync"), 0);
+        SetConsoleInt(TEXT("t.MaxFPS"), 0);
+    }
+    else
+    {
+        if (bFrameLimitsSaved)
+        {
+            SetConsoleInt(TEXT("r.VSync"), SavedVSync);
+            SetConsoleInt(TEXT("t.MaxFPS"), SavedMaxFPS);
+            if (GEngine)
+            {
+                GEngine->bSmoothFrameRate = bSavedSmoothFrameRate;
+            }
+            bFrameLimitsSaved = false;
+        }
+
+        FApp::SetUseFixedTimeStep(false);
+        if (GEngine)
+        {
+            // Paced fixed step: ticks come at Dilation / dt per wall second, so each engine delta is
+            // dt / Dilation and the world dilation below scales it back to exactly dt
+            GEngine->bUseFixedFrameRate = FixedDeltaTime > 0.f;
+            if (FixedDeltaTime > 0.f)
+            {
+                GEngine->FixedFrameRate = Dilation / FixedDeltaTime;
+            }
+        }
+    }
+
+    if (UWorld* World = ClockWorld.Get())
+    {
+        ApplyWorldDilation(World);
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("SimClock: %s, dt %s, dilation %.2f"),
+        bMaxSpeed ? TEXT("max speed") : TEXT("paced"),
+        FixedDeltaTime > 0.f ? *FString::Printf(TEXT("%.4f s"), FixedDeltaTime) : TEXT("variable"), Dilation);
+}
+
+void FSimClock::ApplyWorldDilation(UWorld* World) const
+{
+    AWorldSettings* Settings = World->GetWorldSettings();
+    if (!Settings)
+    {
+        return;
+    }
+
+    // Paced, the dilation stretches a variable dt and restores a fixed one to dt (the engine delta is
+    // dt / Dilation there); max speed runs dt as is
+    const float WorldDilation = bMaxSpeed ? 1.f : Dilation;
+    Settings->MinGlobalTimeDilation = FMath::Min(Settings->MinGlobalTimeDilation, WorldDilation);
+    Settings->MaxGlobalTimeDilation = FMath::Max(Settings->MaxGlobalTimeDilation, WorldDilation);
+    Settings->SetTimeDilation(WorldDilation);
+}
+
+void FSimClock::OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+    if (!World || !World->IsGameWorld() || ClockWorld.IsValid())
+    {
+        return;
+    }
+
+    ClockWorld = World;
+    Tick.store(0, std::memory_order_relaxed);
+    SimSeconds.store(0.0, std::memory_order_relaxed);
+    LastWallTime = FPlatformTime::Seconds();
+    RealTimeFactor = 1.f;
+}
+
+void FSimClock::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+    if (World == ClockWorld.Get())
+    {
+        ClockWorld.Reset();
+    }
+}
+
+void FSimClock::OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+    if (World != ClockWorld.Get())
+    {
+        return;
+    }
+
+    if (World->IsPaused())
+    {
+        return;
+    }
+
+    // Settings only exist once the level is loaded, so the dilation is (re)applied from here
+    AWorldSettings* Settings = World->GetWorldSettings();
+    if (Tick.load(std::memory_order_relaxed) == 0)
+    {
+        ApplyWorldDilation(World);
+    }
+
+    // DeltaSeconds is the engine's; dilate and clamp it the way UWorld::Tick is about to, so SimSeconds
+    // matches the delta actors see this tick
+    float WorldDelta = DeltaSeconds;
+    if (Settings)
+    {
+        WorldDelta = Settings->FixupDeltaSeconds(DeltaSeconds * Settings->GetEffectiveTimeDilation(), DeltaSeconds);
+    }
+
+    Tick.fetch_add(1, std::memory_order_relaxed);
+    SimSeconds.store(SimSeconds.load(std::memory_order_relaxed) + WorldDelta, std::memory_order_relaxed);
+
+    const double WallTime = FPlatformTime::Seconds();
+    const double WallDelta = WallTime - LastWallTime;
+    LastWallTime = WallTime;
+    if (WallDelta > 0.0)
+    {
+        RealTimeFactor = FMath::Lerp(RealTimeFactor, static_cast<float>(WorldDelta / WallDelta), 0.05f);
+    }
+}
@@ -0,0 +1,264 @@
+// SimEnvironmentManager.cpp
+#include "Core/SimEnvironmentManager.h"
+#include "Pawns/QuadPawn.h"
+#include "Controllers/QuadDroneController.h"
+#include "Utility/ObstacleManager.h"
+#include "Core/CommandJournal.h"
+#include "Core/SimClock.h"
+#include "Core/EnvPool.h"
+#include "Engine/World.h"
+#include "Misc/CommandLine.h"
+
+namespace
+{
+    // Where drones start and aim for, relative to their environment's origin; the same as a ZMQ reset
+    const FVector EnvironmentStart(0.0f, 0.0f, 10.0f);
+    const FVector EnvironmentGoal(0.0f, 0.0f, 1000.0f);
+}
+
+ASimEnvironmentManager::ASimEnvironmentManager()
+{
+    PrimaryActorTick.bCanEverTick = true;
+
+    // Clear of the per-drone ZMQ controllers' default RpcPort
+    StepConfiguration.RpcPort = 5600;
+}
+
+void ASimEnvironmentManager::BeginPlay()
+{
+    Super::BeginPlay();
+
+    FParse::Value(FCommandLine::Get(), TEXT("NumEnvs="), NumEnvironments);
+    NumEnvironments = FMath::Clamp(NumEnvironments, 1, 256);
+
+    if (!QuadPawnClass)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SimEnvironmentManager: QuadPawnClass not set; no environments spawned"));
+        return;
+    }
+
+    Environments.SetNum(NumEnvironments);
+    for (int32 EnvIndex = 0; EnvIndex < NumEnvironments; EnvIndex++)
+    {
+        SpawnEnvironment(EnvIndex);
+    }
+
+    if (StepServer.Bind(StepConfiguration))
+    {
+        for (int32 EnvIndex = 0; EnvIndex < Environments.Num(); EnvIndex++)
+        {
+            FZMQStepTarget Target;
+            Target.CommandTarget = Environments[EnvIndex].CommandTarget;
+            Target.GetState = [this, EnvIndex]() { return MakeStepState(EnvIndex); };
+            Target.HasControlSteps = [this, EnvIndex]() { return Environments[EnvIndex].BoundController.IsValid(); };
+            StepServer.SetTarget(static_cast<uint8>(EnvIndex), MoveTemp(Target));
+        }
+        FEnvPool::Get().ReportEndpoint(TEXT("environments"), TEXT("rpc"), AZMQController::MakeEndpoint(StepConfiguration, StepConfiguration.RpcPort, false));
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("SimEnvironmentManager: %d environments, %.0f cm apart, step endpoint %s"),
+        Environments.Num(), EnvironmentSpacing, *AZMQController::MakeEndpoint(StepConfiguration, StepConfiguration.RpcPort, true));
+}
+
+void ASimEnvironmentManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    StepServer.Close();
+
+    FCommandJournal& Journal = FCommandJournal::Get();
+    for (FEnvironment& Environment : Environments)
+    {
+        Journal.UnregisterTarget(Environment.CommandTarget);
+        if (UQuadDroneController* Controller = Environment.BoundController.Get())
+        {
+            Controller->OnControlStep().Remove(Environment.ControlStepHandle);
+        }
+    }
+    Environments.Reset();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ASimEnvironmentManager::SpawnEnvironment(int32 EnvIndex)
+{
+    FEnvironment& Environment = Environments[EnvIndex];
+
+    // Square grid around the manager
+    const int32 Columns = FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumEnvironments)));
+    Environment.Origin = GetActorLocation() + FVector((EnvIndex % Columns) * EnvironmentSpacing, (EnvIndex / Columns) * EnvironmentSpacing, 0.0f);
+    Environment.Goal = Environment.Origin + EnvironmentGoal;
+    Environment.CommandTarget = FString::Printf(TEXT("Env%d"), EnvIndex);
+
+    FActorSpawnParameters SpawnParams;
+    SpawnParams.Owner = this;
+    SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+    if (ObstacleManagerClass)
+    {
+        // Obstacles are laid out around the manager's own location, so each one covers its environment
+        Environment.Obstacles = GetWorld()->SpawnActor<AObstacleManager>(ObstacleManagerClass, Environment.Origin, FRotator::ZeroRotator, SpawnParams);
+    }
+    Environment.Drone = GetWorld()->SpawnActor<AQuadPawn>(QuadPawnClass, Environment.Origin + EnvironmentStart, FRotator::ZeroRotator, SpawnParams);
+
+    FCommandJournal::Get().RegisterTarget(Environment.CommandTarget,
+        FOnExternalCommand::CreateUObject(this, &ASimEnvironmentManager::DispatchCommand, EnvIndex));
+}
+
+void ASimEnvironmentManager::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    BindControllers();
+    StepServer.Poll(StepConfiguration.MaxCommandsPerTick);
+}
+
+void ASimEnvironmentManager::BindControllers()
+{
+    for (int32 EnvIndex = 0; EnvIndex < Environments.Num(); EnvIndex++)
+    {
+        FEnvironment& Environment = Environments[EnvIndex];
+        AQuadPawn* Drone = Environment.Drone.Get();
+        UQuadDroneController* Controller = Drone ? Drone->QuadController : nullptr;
+        if (Controller == Environment.BoundController.Get())
+        {
+            continue;
+        }
+
+        if (UQuadDroneController* Previous = Environment.BoundController.Get())
+        {
+            Previous->OnControlStep().Remove(Environment.ControlStepHandle);
+        }
+        Environment.BoundController = Controller;
+        Environment.bHasSample = false;
+        if (Controller)
+        {
+            Environment.ControlStepHandle = Controller->OnControlStep().AddUObject(this, &ASimEnvironmentManager::HandleControlStep, EnvIndex);
+        }
+    }
+}
+
+AQuadPawn* ASimEnvironmentManager::GetEnvironmentDrone(int32 EnvIndex) const
+{
+    return Environments.IsValidIndex(EnvIndex) ? Environments[EnvIndex].Drone.Get() : nullptr;
+}
+
+void ASimEnvironmentManager::HandleControlStep(const FDroneStateSample& Sample, int32 EnvIndex)
+{
+    FEnvironment& Environment = Environments[EnvIndex];
+    Environment.LastSample = Sample;
+    Environment.bHasSample = true;
+    StepServer.OnControlStep(static_cast<uint8>(EnvIndex));
+}
+
+void ASimEnvironmentManager::DispatchCommand(const FExternalCommand& Command, int32 EnvIndex)
+{
+    if (!Environments.IsValidIndex(EnvIndex))
+    {
+        return;
+    }
+
+    UQuadDroneController* Controller = Environments[EnvIndex].BoundController.Get();
+    if (Command.Name == TEXT("VELOCITY"))
+    {
+        if (Controller && Command.Data.Num() == sizeof(float) * 3)
+        {
+            float Velocity[3];
+            FMemory::Memcpy(Velocity, Command.Data.GetData(), sizeof(Velocity));
+            Controller->SetDesiredVelocity(FVector(Velocity[0], Velocity[1], Velocity[2]));
+        }
+    }
+    else if (Command.Name == TEXT("RESET"))
+    {
+        ResetEnvironment(EnvIndex, nullptr);
+    }
+    else if (Command.Name == TEXT("RESET_RANDOMIZED"))
+    {
+        const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Command.Data.GetData()), Command.Data.Num());
+        FResetSpec Spec;
+        if (FResetSpec::FromJson(FString(Converted.Length(), Converted.Get()), Spec))
+        {
+            ResetEnvironment(EnvIndex, &Spec);
+        }
+    }
+    else if (Command.Name == TEXT("INTEGRAL_RESET") && Controller)
+    {
+        Controller->ResetDroneIntegral();
+    }
+}
+
+void ASimEnvironmentManager::ResetEnvironment(int32 EnvIndex, const FResetSpec* Spec)
+{
+    FEnvironment& Environment = Environments[EnvIndex];
+    UQuadDroneController* Controller = Environment.BoundController.Get();
+    if (!Controller)
+    {
+        return;
+    }
+
+    if (!Spec)
+    {
+        Controller->ResetDroneTo(Environment.Origin + EnvironmentStart, FRotator::ZeroRotator);
+        return;
+    }
+
+    // One seed covers every environment; offsetting it by the index gives each its own draw and layout
+    FResetSpec EnvironmentSpec = *Spec;
+    EnvironmentSpec.Seed = Spec->Seed + EnvIndex;
+
+    if (EnvironmentSpec.ObstacleCount >= 0)
+    {
+        if (AObstacleManager* Obstacles = Environment.Obstacles.Get())
+        {
+            Obstacles->CreateObstaclesWithSeed(EnvironmentSpec.ObstacleCount, EnvironmentSpec.Seed, EGoalPosition::Random, false);
+        }
+    }
+
+    FDroneRandomization Randomization;
+    FDomainRandomizer::SampleDrone(EnvironmentSpec, 0, Randomization);
+    Randomization.SpawnLocation += Environment.Origin;
+    Controller->ApplyRandomization(Randomization);
+}
+
+FZMQStepState ASimEnvironmentManager::MakeStepState(int32 EnvIndex) const
+{
+    // Positions are relative to the environment's origin, so every environment looks the same to a policy
+    const FEnvironment& Environment = Environments[EnvIndex];
+    const AQuadPawn* Drone = Environment.Drone.Get();
+
+    FZMQStepState State = {};
+    FVector Position = Drone ? Drone->GetActorLocation() : Environment.Origin;
+    FVector Velocity = Drone ? Drone->GetVelocity() : FVector::ZeroVector;
+    FQuat Orientation = Drone ? Drone->GetActorQuat() : FQuat::Identity;
+    FVector AngularVelocity = FVector::ZeroVector;
+
+    if (Environment.bHasSample)
+    {
+        State.Step = Environment.LastSample.Step;
+        State.SimTime = Environment.LastSample.SimTime;
+        Position = Environment.LastSample.Position;
+        Velocity = Environment.LastSample.Velocity;
+        Orientation = Environment.LastSample.Orientation;
+        AngularVelocity = Environment.LastSample.AngularVelocity;
+    }
+    else
+    {
+        // Step counts control steps, not world ticks, even before the first sample
+        const UQuadDroneController* Controller = Environment.BoundController.Get();
+        State.Step = Controller ? Controller->GetControlStep() : 0;
+        State.SimTime = FSimClock::Get().GetSimSeconds();
+    }
+
+    const FVector LocalPosition = Position - Environment.Origin;
+    const FVector LocalGoal = Environment.Goal - Environment.Origin;
+    for (int32 i = 0; i < 3; i++)
+    {
+        State.Position[i] = LocalPosition[i];
+        State.Velocity[i] = Velocity[i];
+        State.AngularVelocity[i] = AngularVelocity[i];
+        State.Goal[i] = LocalGoal[i];
+    }
+    State.Orientation[0] = Orientation.X;
+    State.Orientation[1] = Orientation.Y;
+    State.Orientation[2] = Orientation.Z;
+    State.Orientation[3] = Orientation.W;
+    return State;
+}
@@ -0,0 +1,196 @@
+// AsyncHud.cpp
+#include "UI/AsyncHud.h"
+#include "Async/Async.h"
+#include "Core/DroneManager.h"
+#include "Controllers/QuadDroneController.h"
+#include "Pawns/QuadPawn.h"
+#include "Utility/SimProfiler.h"
+#include "ImGuiDelegates.h"
+#include "ImGuiModule.h"
+#include "imgui.h"
+#include "implot.h"
+
+FAsyncHud& FAsyncHud::Get()
+{
+    static FAsyncHud Instance;
+    return Instance;
+}
+
+bool FAsyncHud::IsEnabled()
+{
+    // Async frames are a startup option of the ImGui module, so this never changes during a run
+    static const bool bEnabled = FImGuiModule::IsAvailable() && FImGuiModule::Get().GetProperties().IsAsyncFramesEnabled();
+    return bEnabled;
+}
+
+void FAsyncHud::Register(UWorld* World)
+{
+    if (World && IsEnabled())
+    {
+        FImGuiDelegates::OnWorldDebug(World).AddRaw(this, &FAsyncHud::Draw);
+    }
+}
+
+void FAsyncHud::Unregister(UWorld* World)
+{
+    // A frame already in flight may still call Draw; that is safe since the HUD outlives every world
+    if (World && IsEnabled())
+    {
+        FImGuiDelegates::OnWorldDebug(World).RemoveAll(this);
+    }
+}
+
+void FAsyncHud::Draw()
+{
+    FSimScopedTimer Timer(ESimPhase::UI);
+
+    if (Snapshots.IsDirty())
+    {
+        Snapshots.SwapReadBuffers();
+    }
+    const FSimHudSnapshot& Snapshot = Snapshots.Read();
+
+    RecordHistory(Snapshot);
+    DrawManagerWindow(Snapshot);
+
+    if (Snapshot.Drones.IsValidIndex(Snapshot.SelectedDrone))
+    {
+        DrawDroneWindow(Snapshot, Snapshot.Drones[Snapshot.SelectedDrone]);
+    }
+}
+
+void FAsyncHud::RecordHistory(const FSimHudSnapshot& Snapshot)
+{
+    for (const FDroneHudState& Drone : Snapshot.Drones)
+    {
+        TUniquePtr<FDroneHistory>& History = Histories.FindOrAdd(Drone.DroneID);
+        if (!History)
+        {
+            History = MakeUnique<FDroneHistory>();
+        }
+
+        // The worker can draw the same snapshot twice when the sim is slower than the UI
+        if (History->LastFrame == Snapshot.FrameNumber)
+        {
+            continue;
+        }
+        History->LastFrame = Snapshot.FrameNumber;
+
+        History->Samples.Push(Snapshot.SimTime,
+            Drone.Thrusts[0], Drone.Thrusts[1], Drone.Thrusts[2], Drone.Thrusts[3],
+            Drone.Velocity.Size(), Drone.Position.Z);
+    }
+}
+
+void FAsyncHud::DrawManagerWindow(const FSimHudSnapshot& Snapshot)
+{
+    ImGui::Begin("Global Drone Manager");
+    ImGui::Text("Sim time: %.2f s (frame %llu)", Snapshot.SimTime, static_cast<unsigned long long>(Snapshot.FrameNumber));
+
+    if (Snapshot.Drones.Num() == 0)
+    {
+        ImGui::Text("No drones spawned yet.");
+        ImGui::End();
+        return;
+    }
+
+    const int32 Selected = Snapshot.Drones.IsValidIndex(Snapshot.SelectedDrone) ? Snapshot.SelectedDrone : 0;
+    const FTCHARToUTF8 SelectedLabel(*Snapshot.Drones[Selected].DroneID);
+
+    if (ImGui::BeginCombo("Active Drone", SelectedLabel.Get()))
+    {
+        for (int32 i = 0; i < Snapshot.Drones.Num(); i++)
+        {
+            ImGui::PushID(i);
+            const FTCHARToUTF8 Label(*Snapshot.Drones[i].DroneID);
+            if (ImGui::Selectable(Label.Get(), i == Selected) && i != Selected)
+            {
+                AsyncTask(ENamedThreads::GameThread, [Manager = Snapshot.Manager, i]()
+                {
+                    if (ADroneManager* DroneManager = Manager.Get())
+                    {
+                        DroneManager->SelectedDroneIndex = i;
+                    }
+                });
+            }
+            ImGui::PopID();
+        }
+        ImGui::EndCombo();
+    }
+
+    if (ImGui::Button("Spawn Drone"))
+    {
+        AsyncTask(ENamedThreads::GameThread, [Manager = Snapshot.Manager]()
+        {
+            if (ADroneManager* DroneManager = Manager.Get())
+            {
+                DroneManager->SpawnDroneNextToSelected();
+            }
+        });
+    }
+
+    ImGui::End();
+}
+
+void FAsyncHud::DrawDroneWindow(const FSimHudSnapshot& Snapshot, const FDroneHudState& Drone)
+{
+    const FString WindowName = FString::Printf(TEXT("Drone Monitor##%s"), *Drone.DroneID);
+
+    ImGui::SetNextWindowPos(ImVec2(420, 10), ImGuiCond_FirstUseEver);
+    ImGui::SetNextWindowSize(ImVec2(500, 600), ImGuiCond_FirstUseEver);
+    ImGui::Begin(TCHAR_TO_UTF8(*WindowName));
+
+    ImGui::Text("Drone ID: %s", TCHAR_TO_UTF8(*Drone.DroneID));
+    ImGui::Separator();
+    ImGui::Text("Position X, Y, Z: %.2f, %.2f, %.2f", Drone.Position.X, Drone.Position.Y, Drone.Position.Z);
+    ImGui::Text("Velocity X, Y, Z: %.2f, %.2f, %.2f", Drone.Velocity.X, Drone.Velocity.Y, Drone.Velocity.Z);
+    ImGui::Text("Desired Velocity X, Y, Z: %.2f, %.2f, %.2f", Drone.DesiredVelocity.X, Drone.DesiredVelocity.Y, Drone.DesiredVelocity.Z);
+    ImGui::Text("Roll, Pitch, Yaw: %.2f, %.2f, %.2f", Drone.Rotation.Roll, Drone.Rotation.Pitch, Drone.Rotation.Yaw);
+    ImGui::Text("Thrusts FL, FR, BL, BR: %.1f, %.1f, %.1f, %.1f", Drone.Thrusts[0], Drone.Thrusts[1], Drone.Thrusts[2], Drone.Thrusts[3]);
+
+    if (ImGui::Button("Reset Drone"))
+    {
+        AsyncTask(ENamedThreads::GameThread, [Pawn = Drone.Pawn]()
+        {
+            AQuadPawn* QuadPawn = Pawn.Get();
+            if (QuadPawn && QuadPawn->QuadController)
+            {
+                QuadPawn->QuadController->ResetDroneOrigin();
+            }
+        });
+    }
+
+    ImGui::Separator();
+    ImGui::SliderFloat("Window (s)", &PlotWindow, 1.0f, 4.0f * 3600.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+
+    const TUniquePtr<FDroneHistory>* History = Histories.Find(Drone.DroneID);
+    if (History && *History)
+    {
+        const TTelemetryHistory<double, 1 << 14, 6>& Samples = (*History)->Samples;
+        const double WindowEnd = Snapshot.SimTime;
+        const double WindowStart = WindowEnd - PlotWindow;
+        const ImVec2 PlotSize(-1, (ImGui::GetContentRegionAvail().y - 10) * 0.5f);
+
+        if (ImPlot::BeginPlot("Thrust", PlotSize))
+        {
+            ImPlot::SetupAxes("Time (s)", "Thrust (N)");
+            ImPlot::SetupAxisLimits(ImAxis_X1, WindowStart, WindowEnd, ImPlotCond_Always);
+            Samples.PlotLine("Front Left", 0);
+            Samples.PlotLine("Front Right", 1);
+            Samples.PlotLine("Back Left", 2);
+            Samples.PlotLine("Back Right", 3);
+            ImPlot::EndPlot();
+        }
+
+        if (ImPlot::BeginPlot("Speed and Altitude", PlotSize))
+        {
+            ImPlot::SetupAxes("Time (s)", "cm/s, cm");
+            ImPlot::SetupAxisLimits(ImAxis_X1, WindowStart, WindowEnd, ImPlotCond_Always);
+            Samples.PlotLine("Speed", 4);
+            Samples.PlotLine("Altitude", 5);
+            ImPlot::EndPlot();
+        }
+    }
+
+    ImGui::End();
+}
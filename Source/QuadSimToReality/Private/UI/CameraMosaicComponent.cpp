@@ -0,0 +1,283 @@
+// CameraMosaicComponent.cpp
+#include "UI/CameraMosaicComponent.h"
+#include "UI/ImGuiUtil.h"
+#include "Pawns/QuadPawn.h"
+#include "Algo/Sort.h"
+#include "Camera/CameraComponent.h"
+#include "Components/SceneCaptureComponent2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "ImGuiModule.h"
+#include "RHICommandList.h"
+#include "RenderingThread.h"
+#include "imgui.h"
+
+UCameraMosaicComponent::UCameraMosaicComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+}
+
+void UCameraMosaicComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (AtlasHandle.IsValid() && FImGuiModule::IsAvailable())
+    {
+        FImGuiModule::Get().ReleaseTexture(AtlasHandle);
+    }
+    AtlasHandle = FImGuiTextureHandle();
+
+    if (Capture)
+    {
+        Capture->DestroyComponent();
+        Capture = nullptr;
+    }
+    Super::EndPlay(EndPlayReason);
+}
+
+void UCameraMosaicComponent::SetDrones(const TArray<AQuadPawn*>& Drones)
+{
+    const int32 OldNum = Tiles.Num();
+    Tiles.SetNum(Drones.Num());
+    for (int32 i = 0; i < Drones.Num(); i++)
+    {
+        FTile& Tile = Tiles[i];
+        if (i >= OldNum || Tile.Drone.Get() != Drones[i])
+        {
+            Tile.Drone = Drones[i];
+            Tile.LastCaptureTime = -1.0e9;
+        }
+    }
+}
+
+void UCameraMosaicComponent::SetTileRefreshRate(int32 TileIndex, float Hz)
+{
+    if (Tiles.IsValidIndex(TileIndex))
+    {
+        Tiles[TileIndex].RefreshHz = Hz;
+    }
+}
+
+FIntPoint UCameraMosaicComponent::GetTileOrigin(int32 TileIndex) const
+{
+    return FIntPoint((TileIndex % AtlasColumns) * TileWidth, (TileIndex / AtlasColumns) * TileHeight);
+}
+
+bool UCameraMosaicComponent::EnsureResources()
+{
+    if (!Capture)
+    {
+        Capture = NewObject<USceneCaptureComponent2D>(GetOwner());
+        Capture->bCaptureEveryFrame = false;
+        Capture->bCaptureOnMovement = false;
+        Capture->CaptureSource = ESceneCaptureSource::SCS_FinalColorLDR;
+        Capture->PrimitiveRenderMode = ESceneCapturePrimitiveRenderMode::PRM_LegacySceneCapture;
+        Capture->RegisterComponent();
+    }
+
+    if (!TileTarget || TileTarget->SizeX != TileWidth || TileTarget->SizeY != TileHeight)
+    {
+        if (!TileTarget)
+        {
+            TileTarget = NewObject<UTextureRenderTarget2D>(this);
+        }
+        TileTarget->InitCustomFormat(TileWidth, TileHeight, PF_B8G8R8A8, false);
+        TileTarget->UpdateResourceImmediate(true);
+        Capture->TextureTarget = TileTarget;
+    }
+
+    // Roughly square grid, rebuilt only when the drone count outgrows it or the tile size changes
+    const int32 Columns = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(FMath::Max(Tiles.Num(), 1)))), 1);
+    const int32 Rows = FMath::DivideAndRoundUp(FMath::Max(Tiles.Num(), 1), Columns);
+    const bool bGridFits = Atlas && AtlasColumns * AtlasRows >= Tiles.Num()
+        && Atlas->SizeX == AtlasColumns * TileWidth && Atlas->SizeY == AtlasRows * TileHeight;
+
+    if (!bGridFits)
+    {
+        if (!Atlas)
+        {
+            Atlas = NewObject<UTextureRenderTarget2D>(this);
+        }
+        AtlasColumns = Columns;
+        AtlasRows = Rows;
+        Atlas->ClearColor = FLinearColor::Black;
+        Atlas->InitCustomFormat(AtlasColumns * TileWidth, AtlasRows * TileHeight, PF_B8G8R8A8, false);
+        Atlas->UpdateResourceImmediate(true);
+
+        // Registering under the same name keeps the ImGui texture id; the owner's name keeps mosaics on
+        // different managers from replacing each other's atlas
+        const FName TextureName(*FString::Printf(TEXT("DroneCameraMosaic_%s_%s"), *GetOwner()->GetName(), *GetName()));
+        AtlasHandle = FImGuiModule::Get().RegisterTexture(TextureName, Atlas);
+
+        // Every cell moved, so recapture all of them
+        for (FTile& Tile : Tiles)
+        {
+            Tile.LastCaptureTime = -1.0e9;
+        }
+    }
+
+    return AtlasHandle.IsValid();
+}
+
+void UCameraMosaicComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (!bShowWindow || Tiles.Num() == 0 || !UImGuiUtil::IsUIActive() || !EnsureResources())
+    {
+        return;
+    }
+
+    // Rank due tiles by how many of their own periods they are late, so slow tiles are not starved by fast ones
+    const double Now = GetWorld()->GetRealTimeSeconds();
+    DueTiles.Reset();
+    for (int32 i = 0; i < Tiles.Num(); i++)
+    {
+        const FTile& Tile = Tiles[i];
+        if (!Tile.Drone.IsValid())
+        {
+            continue;
+        }
+
+        const double Period = 1.0 / FMath::Max(Tile.RefreshHz > 0.f ? Tile.RefreshHz : TileRefreshHz, 0.1f);
+        const double Lateness = (Now - Tile.LastCaptureTime - Period) / Period;
+        if (Lateness >= 0.0)
+        {
+            DueTiles.Emplace(Lateness, i);
+        }
+    }
+
+    const int32 Budget = FMath::Min(TilesPerFrame, DueTiles.Num());
+    if (Budget < DueTiles.Num())
+    {
+        Algo::Sort(DueTiles, [](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key > B.Key; });
+    }
+
+    for (int32 i = 0; i < Budget; i++)
+    {
+        const int32 TileIndex = DueTiles[i].Value;
+        CaptureTile(TileIndex);
+        Tiles[TileIndex].LastCaptureTime = Now;
+    }
+}
+
+void UCameraMosaicComponent::CaptureTile(int32 TileIndex)
+{
+    AQuadPawn* Drone = Tiles[TileIndex].Drone.Get();
+    if (!Drone || !Drone->CameraFPV)
+    {
+        return;
+    }
+
+    Capture->FOVAngle = Drone->CameraFPV->FieldOfView;
+    Capture->SetWorldLocationAndRotation(Drone->CameraFPV->GetComponentLocation(), Drone->CameraFPV->GetComponentRotation());
+    Capture->CaptureScene();
+
+    // Runs after the capture on the render thread, so the tile target can be reused for the next drone right away
+    FTextureRenderTargetResource* Source = TileTarget->GameThread_GetRenderTargetResource();
+    FTextureRenderTargetResource* Destination = Atlas->GameThread_GetRenderTargetResource();
+    const FIntPoint Origin = GetTileOrigin(TileIndex);
+
+    ENQUEUE_RENDER_COMMAND(CopyMosaicTile)(
+        [Source, Destination, Origin](FRHICommandListImmediate& RHICmdList)
+        {
+            FRHITexture* SourceTexture = Source ? Source->GetRenderTargetTexture() : nullptr;
+            FRHITexture* DestinationTexture = Destination ? Destination->GetRenderTargetTexture() : nullptr;
+            if (!SourceTexture || !DestinationTexture)
+            {
+                return;
+            }
+
+            FRHICopyTextureInfo CopyInfo;
+            CopyInfo.Size = SourceTexture->GetSizeXYZ();
+            CopyInfo.DestPosition = FIntVector(Origin.X, Origin.Y, 0);
+
+            RHICmdList.Transition({
+                FRHITransitionInfo(SourceTexture, ERHIAccess::Unknown, ERHIAccess::CopySrc),
+                FRHITransitionInfo(DestinationTexture, ERHIAccess::Unknown, ERHIAccess::CopyDest) });
+            RHICmdList.CopyTexture(SourceTexture, DestinationTexture, CopyInfo);
+            RHICmdList.Transition({
+                FRHITransitionInfo(SourceTexture, ERHIAccess::CopySrc, ERHIAccess::SRVMask),
+                FRHITransitionInfo(DestinationTexture, ERHIAccess::CopyDest, ERHIAccess::SRVMask) });
+        });
+}
+
+void UCameraMosaicComponent::DrawWindow(int32& InOutSelectedDrone)
+{
+    if (!bShowWindow)
+    {
+        return;
+    }
+
+    ImGui::SetNextWindowSize(ImVec2(800, 500), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Camera Mosaic", &bShowWindow))
+    {
+        ImGui::End();
+        return;
+    }
+
+    ImGui::SetNextItemWidth(150.0f);
+    ImGui::SliderFloat("Refresh (Hz)", &TileRefreshHz, 0.5f, 60.0f, "%.1f");
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(150.0f);
+    ImGui::SliderInt("Captures / frame", &TilesPerFrame, 1, 16);
+
+    // The selected drone's tile can run at its own rate; zero follows the default above
+    if (Tiles.IsValidIndex(InOutSelectedDrone))
+    {
+        float TileHz = Tiles[InOutSelectedDrone].RefreshHz;
+        ImGui::SetNextItemWidth(150.0f);
+        if (ImGui::SliderFloat("Selected tile (Hz)", &TileHz, 0.0f, 60.0f, TileHz > 0.f ? "%.1f" : "default"))
+        {
+            SetTileRefreshRate(InOutSelectedDrone, TileHz);
+        }
+        ImGui::SameLine();
+        if (ImGui::Button("Use default"))
+        {
+            SetTileRefreshRate(InOutSelectedDrone, 0.f);
+        }
+    }
+
+    if (!AtlasHandle.IsValid() || AtlasColumns == 0)
+    {
+        ImGui::Text("No camera feeds yet.");
+        ImGui::End();
+        return;
+    }
+
+    // Fit the grid to the window width, keeping the tile aspect ratio
+    const float Spacing = ImGui::GetStyle().ItemSpacing.x;
+    const float Available = ImGui::GetContentRegionAvail().x;
+    const float ThumbWidth = FMath::Max((Available - Spacing * (AtlasColumns - 1)) / AtlasColumns, 32.0f);
+    const ImVec2 ThumbSize(ThumbWidth, ThumbWidth * TileHeight / TileWidth);
+    const float AtlasWidth = static_cast<float>(AtlasColumns * TileWidth);
+    const float AtlasHeight = static_cast<float>(AtlasRows * TileHeight);
+
+    for (int32 i = 0; i < Tiles.Num(); i++)
+    {
+        if (i % AtlasColumns != 0)
+        {
+            ImGui::SameLine();
+        }
+
+        const FIntPoint Origin = GetTileOrigin(i);
+        const ImVec2 UV0(Origin.X / AtlasWidth, Origin.Y / AtlasHeight);
+        const ImVec2 UV1((Origin.X + TileWidth) / AtlasWidth, (Origin.Y + TileHeight) / AtlasHeight);
+        const ImVec4 Border = i == InOutSelectedDrone ? ImVec4(1.0f, 0.8f, 0.0f, 1.0f) : ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+
+        ImGui::PushID(i);
+        ImGui::PushStyleColor(ImGuiCol_Button, Border);
+        if (ImGui::ImageButton("Tile", AtlasHandle, ThumbSize, UV0, UV1))
+        {
+            InOutSelectedDrone = i;
+        }
+        ImGui::PopStyleColor();
+
+        if (ImGui::IsItemHovered())
+        {
+            AQuadPawn* Drone = Tiles[i].Drone.Get();
+            const float TileHz = Tiles[i].RefreshHz > 0.f ? Tiles[i].RefreshHz : TileRefreshHz;
+            ImGui::SetTooltip("%s (%.1f Hz)", Drone ? TCHAR_TO_UTF8(*Drone->DroneID) : "Drone destroyed", TileHz);
+        }
+        ImGui::PopID();
+    }
+
+    ImGui::End();
+}
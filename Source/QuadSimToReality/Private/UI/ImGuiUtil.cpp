@@ -1,4 +1,5 @@
 #include "UI/ImGuiUtil.h"
+#include "ImGuiModule.h"
 #include "imgui.h"
 #include "implot.h"
 #include "Pawns/QuadPawn.h"
@@ -13,14 +14,19 @@
 UImGuiUtil::UImGuiUtil()
 	: DronePawn(nullptr)
 	, Controller(nullptr)
-	, CumulativeTime(0.0f)
+	, CumulativeTime(0.0)
 	, MaxPlotTime(10.0f)
+	, PIDHistory(FPaths::ProjectDir() + TEXT("PIDGains.csv"))
+	, PIDHistoryFilterColumn(0)
+	, PIDHistoryFilter{}
 {
-	const auto& Config = UDroneJSONConfig::Get().Config;
 	PrimaryComponentTick.bCanEverTick = true;
-	maxVelocity = Config.FlightParams.MaxVelocity;
-	maxAngle = Config.FlightParams.MaxAngle;
+	ApplyConfig(UDroneJSONConfig::GetConfigFor(*this));
+}
 
+bool UImGuiUtil::IsUIActive()
+{
+    return FImGuiModule::IsAvailable() && FImGuiModule::Get().IsUIActive();
 }
 
 void UImGuiUtil::Initialize(AQuadPawn* InPawn, UQuadDroneController* InController)
@@ -32,6 +38,19 @@ void UImGuiUtil::Initialize(AQuadPawn* InPawn, UQuadDroneController* InControlle
 void UImGuiUtil::BeginPlay()
 {
     Super::BeginPlay();
+    ConfigChangedHandle = UDroneJSONConfig::Get().OnConfigChanged().AddUObject(this, &UImGuiUtil::ApplyConfig);
+}
+
+void UImGuiUtil::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    UDroneJSONConfig::Get().OnConfigChanged().Remove(ConfigChangedHandle);
+    Super::EndPlay(EndPlayReason);
+}
+
+void UImGuiUtil::ApplyConfig(const FDroneConfigData& Config)
+{
+	maxVelocity = Config.FlightParams.MaxVelocity;
+	maxAngle = Config.FlightParams.MaxAngle;
 }
 
 void UImGuiUtil::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -47,6 +66,11 @@ void UImGuiUtil::VelocityHud(TArray<float>& ThrustsVal,
                                   const FVector& currentVelocity,
                                   float xOutput, float yOutput, float zOutput, float deltaTime)
 {
+	if (!IsUIActive())
+	{
+		return;
+	}
+
 	// Set up window position and size
 	ImGui::SetNextWindowPos(ImVec2(420, 10), ImGuiCond_FirstUseEver);
 	ImGui::SetNextWindowSize(ImVec2(500, 500), ImGuiCond_FirstUseEver);
@@ -196,19 +220,15 @@ void UImGuiUtil::VelocityHud(TArray<float>& ThrustsVal,
 
 void UImGuiUtil::RenderImPlot(const TArray<float>& ThrustsVal, const FVector& desiredForwardVector, const FVector& currentForwardVector, float deltaTime)
 {
-    if (ThrustsVal.Num() < 4)
+    if (ThrustsVal.Num() < 4 || !IsUIActive())
     {
         return;
     }
 
     CumulativeTime += deltaTime;
-    TimeData.Add(CumulativeTime);
     
     // Add thruster data
-    Thrust0Data.Add(ThrustsVal[0]);
-    Thrust1Data.Add(ThrustsVal[1]);
-    Thrust2Data.Add(ThrustsVal[2]);
-    Thrust3Data.Add(ThrustsVal[3]);
+    ThrustHistory.Push(CumulativeTime, ThrustsVal[0], ThrustsVal[1], ThrustsVal[2], ThrustsVal[3]);
     
     // Extract heading angles from forward vectors (ignoring Z component)
     // Using atan2 to get the yaw angle in degrees
@@ -230,41 +250,20 @@ void UImGuiUtil::RenderImPlot(const TArray<float>& ThrustsVal, const FVector& de
     while (rawErrorAngle > 180.0f) rawErrorAngle -= 360.0f;
     while (rawErrorAngle < -180.0f) rawErrorAngle += 360.0f;
     
-    // Add the heading data to our arrays
-    DesiredHeadingData.Add(desiredHeading);
-    CurrentHeadingData.Add(currentHeading);
-    VectorErrorData.Add(rawErrorAngle);
-
-    // Clean up old data points for all arrays
-    while (TimeData.Num() > 0 && (CumulativeTime - TimeData[0] > MaxPlotTime))
-    {
-        TimeData.RemoveAt(0);
-        Thrust0Data.RemoveAt(0);
-        Thrust1Data.RemoveAt(0);
-        Thrust2Data.RemoveAt(0);
-        Thrust3Data.RemoveAt(0);
-        DesiredHeadingData.RemoveAt(0);
-        CurrentHeadingData.RemoveAt(0);
-        VectorErrorData.RemoveAt(0);
-    }
-
-    while (TimeData.Num() > MaxDataPoints)
-    {
-        TimeData.RemoveAt(0);
-        Thrust0Data.RemoveAt(0);
-        Thrust1Data.RemoveAt(0);
-        Thrust2Data.RemoveAt(0);
-        Thrust3Data.RemoveAt(0);
-        DesiredHeadingData.RemoveAt(0);
-        CurrentHeadingData.RemoveAt(0);
-        VectorErrorData.RemoveAt(0);
-    }
+    // Add the heading data to the history
+    HeadingHistory.Push(CumulativeTime, desiredHeading, currentHeading, rawErrorAngle);
 
     ImGui::SetNextWindowPos(ImVec2(850, 10), ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowSize(ImVec2(600, 600), ImGuiCond_FirstUseEver);
 
     ImGui::Begin("Drone Analysis", nullptr, ImGuiWindowFlags_NoCollapse);
 
+    ImGui::SliderFloat("Window (s)", &MaxPlotTime, 1.0f, 4.0f * 3600.0f, "%.0f", ImGuiSliderFlags_Logarithmic);
+
+    // Scroll with the newest sample; wide windows are drawn from the min/max pyramid
+    const double windowEnd = CumulativeTime;
+    const double windowStart = windowEnd - MaxPlotTime;
+
     ImVec2 windowSize = ImGui::GetContentRegionAvail();
     float plotHeight = windowSize.y * 0.5f;  // Split window for two plots
     ImVec2 plotSize(windowSize.x, plotHeight - 10);
@@ -275,6 +274,7 @@ void UImGuiUtil::RenderImPlot(const TArray<float>& ThrustsVal, const FVector& de
     if (ImPlot::BeginPlot("Thrust Values Over Time", plotSize, plotFlags))
     {
         ImPlot::SetupAxes("Time (s)", "Thrust (N)", axisFlags, axisFlags);
+        ImPlot::SetupAxisLimits(ImAxis_X1, windowStart, windowEnd, ImPlotCond_Always);
 
         const ImVec4 FL_COLOR(1.0f, 0.2f, 0.2f, 1.0f);  // Red
         const ImVec4 FR_COLOR(0.2f, 1.0f, 0.2f, 1.0f);  // Green
@@ -282,16 +282,16 @@ void UImGuiUtil::RenderImPlot(const TArray<float>& ThrustsVal, const FVector& de
         const ImVec4 BR_COLOR(1.0f, 0.8f, 0.0f, 1.0f);  // Yellow
 
         ImPlot::SetNextLineStyle(FL_COLOR, 2.0f);
-        ImPlot::PlotLine("Front Left", TimeData.GetData(), Thrust0Data.GetData(), TimeData.Num());
+        ThrustHistory.PlotLine("Front Left", 0);
 
         ImPlot::SetNextLineStyle(FR_COLOR, 2.0f);
-        ImPlot::PlotLine("Front Right", TimeData.GetData(), Thrust1Data.GetData(), TimeData.Num());
+        ThrustHistory.PlotLine("Front Right", 1);
 
         ImPlot::SetNextLineStyle(BL_COLOR, 2.0f);
-        ImPlot::PlotLine("Back Left", TimeData.GetData(), Thrust2Data.GetData(), TimeData.Num());
+        ThrustHistory.PlotLine("Back Left", 2);
 
         ImPlot::SetNextLineStyle(BR_COLOR, 2.0f);
-        ImPlot::PlotLine("Back Right", TimeData.GetData(), Thrust3Data.GetData(), TimeData.Num());
+        ThrustHistory.PlotLine("Back Right", 3);
 
         ImPlot::EndPlot();
     }
@@ -302,6 +302,7 @@ void UImGuiUtil::RenderImPlot(const TArray<float>& ThrustsVal, const FVector& de
     if (ImPlot::BeginPlot("Heading Comparison", plotSize, plotFlags))
     {
         ImPlot::SetupAxes("Time (s)", "Heading (degrees)", axisFlags, axisFlags);
+        ImPlot::SetupAxisLimits(ImAxis_X1, windowStart, windowEnd, ImPlotCond_Always);
         ImPlot::SetupAxisLimits(ImAxis_Y1, -180, 180, ImPlotCond_Once);
 
         const ImVec4 DESIRED_COLOR(0.2f, 0.7f, 0.9f, 1.0f);  // Blue for desired
@@ -309,13 +310,13 @@ void UImGuiUtil::RenderImPlot(const TArray<float>& ThrustsVal, const FVector& de
         const ImVec4 ERROR_COLOR(0.8f, 0.4f, 0.9f, 1.0f);    // Purple for error
 
         ImPlot::SetNextLineStyle(DESIRED_COLOR, 2.0f);
-        ImPlot::PlotLine("Desired Heading", TimeData.GetData(), DesiredHeadingData.GetData(), TimeData.Num());
+        HeadingHistory.PlotLine("Desired Heading", 0);
 
         ImPlot::SetNextLineStyle(CURRENT_COLOR, 2.0f);
-        ImPlot::PlotLine("Current Heading", TimeData.GetData(), CurrentHeadingData.GetData(), TimeData.Num());
+        HeadingHistory.PlotLine("Current Heading", 1);
 
         ImPlot::SetNextLineStyle(ERROR_COLOR, 1.5f);
-        ImPlot::PlotLine("Heading Error", TimeData.GetData(), VectorErrorData.GetData(), TimeData.Num());
+        HeadingHistory.PlotLine("Heading Error", 2);
 
         ImPlot::EndPlot();
     }
@@ -330,6 +331,10 @@ void UImGuiUtil::DisplayDroneInfo()
 	{
 		float droneMass = DronePawn->GetMass();
 		ImGui::Text("Drone Mass: %.2f kg", droneMass);
+		if (Controller)
+		{
+			ImGui::Text("Airframe: %s", TCHAR_TO_UTF8(*Controller->GetAirframeName().ToString()));
+		}
 	}
 	else
 	{
@@ -369,10 +374,30 @@ void UImGuiUtil::DisplayPIDSettings(const char* headerLabel, bool& synchronizeXY
 			ImGui::PopItemWidth();
 		};
 
+		// Gains a schedule owns are rewritten every control step, so those axes are shown read-only
+		auto BeginAxis = [this](const char* Name, EPIDAxis Axis, EPIDAxis LinkedAxis, bool bLinked)
+		{
+			EGainScheduleVariable Variable = Controller->GetGainScheduleVariable(Axis);
+			if (Variable == EGainScheduleVariable::None && bLinked)
+			{
+				Variable = Controller->GetGainScheduleVariable(LinkedAxis);
+			}
+
+			if (Variable != EGainScheduleVariable::None)
+			{
+				ImGui::Text("%s (scheduled on %s)", Name, TCHAR_TO_UTF8(FGainScheduleTable::GetVariableName(Variable)));
+			}
+			else
+			{
+				ImGui::Text("%s", Name);
+			}
+			ImGui::BeginDisabled(Variable != EGainScheduleVariable::None);
+		};
+
 		ImGui::Text("Position PID Gains");
 		ImGui::Checkbox("Synchronize X and Y Axis Gains", &synchronizeXYGains);
 		ImGui::Indent();
-		ImGui::Text("X Axis");
+		BeginAxis("X Axis", EPIDAxis::X, EPIDAxis::Y, synchronizeXYGains);
 		if (synchronizeXYGains && PIDSet->XPID && PIDSet->YPID)
 		{
 			DrawPIDGainControl("X P", &PIDSet->XPID->ProportionalGain, 0.0f, 10.0f);
@@ -388,10 +413,11 @@ void UImGuiUtil::DisplayPIDSettings(const char* headerLabel, bool& synchronizeXY
 			DrawPIDGainControl("X I", &PIDSet->XPID->IntegralGain, 0.0f, 10.0f);
 			DrawPIDGainControl("X D", &PIDSet->XPID->DerivativeGain, 0.0f, 10.0f);
 		}
+		ImGui::EndDisabled();
 		ImGui::Unindent();
 
 		ImGui::Indent();
-		ImGui::Text("Y Axis");
+		BeginAxis("Y Axis", EPIDAxis::Y, EPIDAxis::X, synchronizeXYGains);
 		if (synchronizeXYGains && PIDSet->YPID && PIDSet->XPID)
 		{
 			DrawPIDGainControl("Y P", &PIDSet->YPID->ProportionalGain, 0.0f, 10.0f);
@@ -407,16 +433,18 @@ void UImGuiUtil::DisplayPIDSettings(const char* headerLabel, bool& synchronizeXY
 			DrawPIDGainControl("Y I", &PIDSet->YPID->IntegralGain, 0.0f, 10.0f);
 			DrawPIDGainControl("Y D", &PIDSet->YPID->DerivativeGain, 0.0f, 10.0f);
 		}
+		ImGui::EndDisabled();
 		ImGui::Unindent();
 
 		ImGui::Indent();
-		ImGui::Text("Z Axis");
+		BeginAxis("Z Axis", EPIDAxis::Z, EPIDAxis::Z, false);
 		if (PIDSet->ZPID)
 		{
 			DrawPIDGainControl("Z P", &PIDSet->ZPID->ProportionalGain, 0.0f, 10.0f);
 			DrawPIDGainControl("Z I", &PIDSet->ZPID->IntegralGain, 0.0f, 10.0f);
 			DrawPIDGainControl("Z D", &PIDSet->ZPID->DerivativeGain, 0.0f, 10.0f);
 		}
+		ImGui::EndDisabled();
 		ImGui::Unindent();
 
 		ImGui::Separator();
@@ -424,7 +452,7 @@ void UImGuiUtil::DisplayPIDSettings(const char* headerLabel, bool& synchronizeXY
 		ImGui::Text("Attitude PID Gains");
 		ImGui::Checkbox("Synchronize Roll and Pitch Gains", &synchronizeGains);
 		ImGui::Indent();
-		ImGui::Text("Roll");
+		BeginAxis("Roll", EPIDAxis::Roll, EPIDAxis::Pitch, synchronizeGains);
 		if (synchronizeGains && PIDSet->RollPID && PIDSet->PitchPID)
 		{
 			DrawPIDGainControl("Roll P", &PIDSet->RollPID->ProportionalGain, 0.0f, 20.0f);
@@ -440,10 +468,11 @@ void UImGuiUtil::DisplayPIDSettings(const char* headerLabel, bool& synchronizeXY
 			DrawPIDGainControl("Roll I", &PIDSet->RollPID->IntegralGain, 0.0f, 20.0f);
 			DrawPIDGainControl("Roll D", &PIDSet->RollPID->DerivativeGain, 0.0f, 20.0f);
 		}
+		ImGui::EndDisabled();
 		ImGui::Unindent();
 
 		ImGui::Indent();
-		ImGui::Text("Pitch");
+		BeginAxis("Pitch", EPIDAxis::Pitch, EPIDAxis::Roll, synchronizeGains);
 		if (synchronizeGains && PIDSet->PitchPID && PIDSet->RollPID)
 		{
 			DrawPIDGainControl("Pitch P", &PIDSet->PitchPID->ProportionalGain, 0.0f, 20.0f);
@@ -459,23 +488,25 @@ void UImGuiUtil::DisplayPIDSettings(const char* headerLabel, bool& synchronizeXY
 			DrawPIDGainControl("Pitch I", &PIDSet->PitchPID->IntegralGain, 0.0f, 20.0f);
 			DrawPIDGainControl("Pitch D", &PIDSet->PitchPID->DerivativeGain, 0.0f, 20.0f);
 		}
+		ImGui::EndDisabled();
 		ImGui::Unindent();
 
 		ImGui::Indent();
-		ImGui::Text("Yaw");
+		BeginAxis("Yaw", EPIDAxis::Yaw, EPIDAxis::Yaw, false);
 		if (PIDSet->YawPID)
 		{
 			DrawPIDGainControl("Yaw P", &PIDSet->YawPID->ProportionalGain, 0.0f, 2.0f);
 			DrawPIDGainControl("Yaw I", &PIDSet->YawPID->IntegralGain, 0.0f, 2.0f);
 			DrawPIDGainControl("Yaw D", &PIDSet->YawPID->DerivativeGain, 0.0f, 2.0f);
 		}
+		ImGui::EndDisabled();
 		ImGui::Unindent();
 
 		ImGui::Separator();
 
 		if (ImGui::Button("Save PID Gains", ImVec2(200, 50)))
 		{
-			FString FilePath = FPaths::ProjectDir() + "PIDGains.csv";
+			const FString& FilePath = PIDHistory.GetFilePath();
 			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
 			bool bFileExists = PlatformFile.FileExists(*FilePath);
 			FString Header = TEXT("Timestamp,xP,xI,xD,yP,yI,yD,zP,zI,zD,rollP,rollI,rollD,pitchP,pitchI,pitchD,yawP,yawI,yawD\n");
@@ -510,6 +541,7 @@ void UImGuiUtil::DisplayPIDSettings(const char* headerLabel, bool& synchronizeXY
 				GainData += FString::Printf(TEXT("%.3f,%.3f,%.3f"), PIDSet->YawPID->ProportionalGain, PIDSet->YawPID->IntegralGain, PIDSet->YawPID->DerivativeGain);
 			}
 			FFileHelper::SaveStringToFile(GainData + TEXT("\n"), *FilePath, FFileHelper::EEncodingOptions::AutoDetect, &IFileManager::Get(), EFileWrite::FILEWRITE_Append);
+			PIDHistory.MarkDirty();
 		}
 	}
 }
@@ -702,96 +734,115 @@ void UImGuiUtil::DisplayPIDHistoryWindow()
 		return;
 	}
 
-	// Path to the CSV file
-	FString FilePath = FPaths::ProjectDir() + "PIDGains.csv";
+	// Only stats the file about once a second; the parse happens when it actually changed
+	PIDHistory.Refresh();
 
-	// Check if file exists
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	if (!PlatformFile.FileExists(*FilePath))
+	if (!PIDHistory.FileExists())
 	{
-		ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "PID history file not found: %s", TCHAR_TO_UTF8(*FilePath));
+		ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "PID history file not found: %s", TCHAR_TO_UTF8(*PIDHistory.GetFilePath()));
 		ImGui::End();
 		return;
 	}
 
-	// Read the CSV file
-	FString FileContent;
-	if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+	const TArray<FString>& Headers = PIDHistory.GetHeaders();
+	if (Headers.Num() == 0 || PIDHistory.NumRowsInFile() == 0)
 	{
-		ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Failed to read PID history file");
+		ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "PID history file is empty or invalid");
 		ImGui::End();
 		return;
 	}
 
-	// Parse the CSV content
-	TArray<FString> Lines;
-	FileContent.ParseIntoArrayLines(Lines, false);
+	const int32 NumColumns = FMath::Min(Headers.Num(), FPIDGainRow::NumGains + 1);
 
-	if (Lines.Num() < 2) // Need at least header and one data row
+	// Filter by the text shown in one column
+	bool bFilterChanged = false;
+	ImGui::SetNextItemWidth(120.0f);
+	if (ImGui::BeginCombo("##FilterColumn", TCHAR_TO_UTF8(*Headers[FMath::Min(PIDHistoryFilterColumn, NumColumns - 1)])))
 	{
-		ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "PID history file is empty or invalid");
-		ImGui::End();
-		return;
+		for (int32 ColIdx = 0; ColIdx < NumColumns; ColIdx++)
+		{
+			if (ImGui::Selectable(TCHAR_TO_UTF8(*Headers[ColIdx]), ColIdx == PIDHistoryFilterColumn))
+			{
+				PIDHistoryFilterColumn = ColIdx;
+				bFilterChanged = true;
+			}
+		}
+		ImGui::EndCombo();
 	}
+	ImGui::SameLine();
+	ImGui::SetNextItemWidth(200.0f);
+	bFilterChanged |= ImGui::InputTextWithHint("##Filter", "Filter", PIDHistoryFilter, sizeof(PIDHistoryFilter));
+	if (bFilterChanged)
+	{
+		PIDHistory.SetFilter(PIDHistoryFilterColumn, UTF8_TO_TCHAR(PIDHistoryFilter));
+	}
+	ImGui::SameLine();
+	ImGui::Text("%d / %d rows", PIDHistory.NumVisibleRows(), PIDHistory.NumRowsInFile());
 
 	// Set up table
 	static ImGuiTableFlags TableFlags =
 		ImGuiTableFlags_Borders |
 		ImGuiTableFlags_RowBg |
 		ImGuiTableFlags_ScrollY |
-		ImGuiTableFlags_SizingFixedFit;
+		ImGuiTableFlags_SizingFixedFit |
+		ImGuiTableFlags_Sortable;
 
-	if (ImGui::BeginTable("PIDHistoryTable", 19, TableFlags, ImVec2(0, 0), 0.0f))
+	if (ImGui::BeginTable("PIDHistoryTable", NumColumns, TableFlags, ImVec2(0, 0), 0.0f))
 	{
-		// Parse header
-		TArray<FString> Headers;
-		Lines[0].ParseIntoArray(Headers, TEXT(","), true);
-
 		// Add headers to table
 		ImGui::TableSetupScrollFreeze(1, 1); // Freeze header row
-		for (int32 ColIdx = 0; ColIdx < Headers.Num(); ColIdx++)
+		for (int32 ColIdx = 0; ColIdx < NumColumns; ColIdx++)
 		{
-			ImGui::TableSetupColumn(TCHAR_TO_UTF8(*Headers[ColIdx]), ImGuiTableColumnFlags_WidthFixed);
+			const ImGuiTableColumnFlags ColumnFlags = ColIdx == 0
+				? ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort
+				: ImGuiTableColumnFlags_WidthFixed;
+			ImGui::TableSetupColumn(TCHAR_TO_UTF8(*Headers[ColIdx]), ColumnFlags);
 		}
 		ImGui::TableHeadersRow();
 
-		// Process data rows
-		for (int32 RowIdx = 1; RowIdx < Lines.Num(); RowIdx++)
+		// Sorting reorders the cached view, it does not touch the file
+		if (ImGuiTableSortSpecs* SortSpecs = ImGui::TableGetSortSpecs())
 		{
-			// Skip empty lines
-			if (Lines[RowIdx].IsEmpty())
-				continue;
-
-			ImGui::TableNextRow();
-
-			TArray<FString> Values;
-			Lines[RowIdx].ParseIntoArray(Values, TEXT(","), true);
+			if (SortSpecs->SpecsDirty && SortSpecs->SpecsCount > 0)
+			{
+				const ImGuiTableColumnSortSpecs& Spec = SortSpecs->Specs[0];
+				PIDHistory.SetSort(Spec.ColumnIndex, Spec.SortDirection == ImGuiSortDirection_Ascending);
+			}
+			SortSpecs->SpecsDirty = false;
+		}
 
-			// Fill in row data
-			for (int32 ColIdx = 0; ColIdx < Values.Num() && ColIdx < Headers.Num(); ColIdx++)
+		// Only the rows in view are submitted
+		ImGuiListClipper Clipper;
+		Clipper.Begin(PIDHistory.NumVisibleRows());
+		while (Clipper.Step())
+		{
+			for (int32 RowIdx = Clipper.DisplayStart; RowIdx < Clipper.DisplayEnd; RowIdx++)
 			{
-				ImGui::TableSetColumnIndex(ColIdx);
+				const FPIDGainRow& Row = PIDHistory.GetVisibleRow(RowIdx);
+				ImGui::TableNextRow();
+				ImGui::PushID(Row.FileOrder);
 
-				// For timestamp column (0), just display the value
-				if (ColIdx == 0)
-				{
-					ImGui::TextUnformatted(TCHAR_TO_UTF8(*Values[ColIdx]));
+				ImGui::TableSetColumnIndex(0);
+				ImGui::TextUnformatted(TCHAR_TO_UTF8(*Row.Timestamp));
 
-					// Add Load button in the first column
+				// Add Load button in the first column
+				if (Row.IsComplete())
+				{
 					ImGui::SameLine();
-					FString ButtonLabel = "Load##" + FString::FromInt(RowIdx);
-					if (ImGui::SmallButton(TCHAR_TO_UTF8(*ButtonLabel)))
+					if (ImGui::SmallButton("Load"))
 					{
 						// When clicked, load these PID values
-						LoadPIDValues(Values);
+						LoadPIDValues(Row);
 					}
 				}
-				else
+
+				for (int32 GainIdx = 0; GainIdx < Row.NumValues && GainIdx + 1 < NumColumns; GainIdx++)
 				{
-					// For numeric columns, align right and convert to float for display
-					float Value = FCString::Atof(*Values[ColIdx]);
-					ImGui::Text("%6.3f", Value);
+					ImGui::TableSetColumnIndex(GainIdx + 1);
+					ImGui::Text("%6.3f", Row.Gains[GainIdx]);
 				}
+
+				ImGui::PopID();
 			}
 		}
 
@@ -802,65 +853,65 @@ void UImGuiUtil::DisplayPIDHistoryWindow()
 }
 
 // Helper method to load PID values from a row
-void UImGuiUtil::LoadPIDValues(const TArray<FString>& Values)
+void UImGuiUtil::LoadPIDValues(const FPIDGainRow& Row)
 {
-	if (!Controller || Values.Num() < 19) // Ensure we have all values (timestamp + 18 PID values)
+	if (!Controller || !Row.IsComplete()) // Ensure we have all 18 PID values
 		return;
 
 	FFullPIDSet* PIDSet = Controller->GetPIDSet();
 	if (!PIDSet)
 		return;
 
-	// Values order: timestamp, xP, xI, xD, yP, yI, yD, zP, zI, zD, rollP, rollI, rollD, pitchP, pitchI, pitchD, yawP, yawI, yawD
+	// Gains order: xP, xI, xD, yP, yI, yD, zP, zI, zD, rollP, rollI, rollD, pitchP, pitchI, pitchD, yawP, yawI, yawD
 
 	// Load X PID
 	if (PIDSet->XPID)
 	{
-		PIDSet->XPID->ProportionalGain = FCString::Atof(*Values[1]);
-		PIDSet->XPID->IntegralGain = FCString::Atof(*Values[2]);
-		PIDSet->XPID->DerivativeGain = FCString::Atof(*Values[3]);
+		PIDSet->XPID->ProportionalGain = Row.Gains[0];
+		PIDSet->XPID->IntegralGain = Row.Gains[1];
+		PIDSet->XPID->DerivativeGain = Row.Gains[2];
 	}
 
 	// Load Y PID
 	if (PIDSet->YPID)
 	{
-		PIDSet->YPID->ProportionalGain = FCString::Atof(*Values[4]);
-		PIDSet->YPID->IntegralGain = FCString::Atof(*Values[5]);
-		PIDSet->YPID->DerivativeGain = FCString::Atof(*Values[6]);
+		PIDSet->YPID->ProportionalGain = Row.Gains[3];
+		PIDSet->YPID->IntegralGain = Row.Gains[4];
+		PIDSet->YPID->DerivativeGain = Row.Gains[5];
 	}
 
 	// Load Z PID
 	if (PIDSet->ZPID)
 	{
-		PIDSet->ZPID->ProportionalGain = FCString::Atof(*Values[7]);
-		PIDSet->ZPID->IntegralGain = FCString::Atof(*Values[8]);       
-		PIDSet->ZPID->DerivativeGain = FCString::Atof(*Values[9]);
+		PIDSet->ZPID->ProportionalGain = Row.Gains[6];
+		PIDSet->ZPID->IntegralGain = Row.Gains[7];       
+		PIDSet->ZPID->DerivativeGain = Row.Gains[8];
 	}
 
 	// Load Roll PID
 	if (PIDSet->RollPID)
 	{
-		PIDSet->RollPID->ProportionalGain = FCString::Atof(*Values[10]);
-		PIDSet->RollPID->IntegralGain = FCString::Atof(*Values[11]);
-		PIDSet->RollPID->DerivativeGain = FCString::Atof(*Values[12]);
+		PIDSet->RollPID->ProportionalGain = Row.Gains[9];
+		PIDSet->RollPID->IntegralGain = Row.Gains[10];
+		PIDSet->RollPID->DerivativeGain = Row.Gains[11];
 	}
 
 	// Load Pitch PID
 	if (PIDSet->PitchPID)
 	{
-		PIDSet->PitchPID->ProportionalGain = FCString::Atof(*Values[13]);
-		PIDSet->PitchPID->IntegralGain = FCString::Atof(*Values[14]);
-		PIDSet->PitchPID->DerivativeGain = FCString::Atof(*Values[15]);
+		PIDSet->PitchPID->ProportionalGain = Row.Gains[12];
+		PIDSet->PitchPID->IntegralGain = Row.Gains[13];
+		PIDSet->PitchPID->DerivativeGain = Row.Gains[14];
 	}
 
 	// Load Yaw PID
 	if (PIDSet->YawPID)
 	{
-		PIDSet->YawPID->ProportionalGain = FCString::Atof(*Values[16]);
-		PIDSet->YawPID->IntegralGain = FCString::Atof(*Values[17]);
-		PIDSet->YawPID->DerivativeGain = FCString::Atof(*Values[18]);
+		PIDSet->YawPID->ProportionalGain = Row.Gains[15];
+		PIDSet->YawPID->IntegralGain = Row.Gains[16];
+		PIDSet->YawPID->DerivativeGain = Row.Gains[17];
 	}
 
 	// Notify of successful load
-	UE_LOG(LogTemp, Display, TEXT("Loaded PID configuration from %s"), *Values[0]);
+	UE_LOG(LogTemp, Display, TEXT("Loaded PID configuration from %s"), *Row.Timestamp);
 }
\ No newline at end of file
@@ -0,0 +1,159 @@
+// PIDGainHistory.cpp
+#include "UI/PIDGainHistory.h"
+#include "Algo/StableSort.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+
+FPIDGainHistory::FPIDGainHistory(const FString& InFilePath)
+    : FilePath(InFilePath)
+{
+}
+
+void FPIDGainHistory::Refresh()
+{
+    const double Now = FPlatformTime::Seconds();
+    if (!bDirty && Now < NextPollTime)
+    {
+        return;
+    }
+    NextPollTime = Now + RefreshInterval;
+
+    const FFileStatData Stat = IFileManager::Get().GetStatData(*FilePath);
+    bFileExists = Stat.bIsValid && !Stat.bIsDirectory;
+    if (!bFileExists)
+    {
+        if (Rows.Num() > 0 || Headers.Num() > 0)
+        {
+            Headers.Reset();
+            Rows.Reset();
+            View.Reset();
+        }
+        LoadedSize = -1;
+        bDirty = false;
+        return;
+    }
+
+    if (bDirty || Stat.FileSize != LoadedSize || Stat.ModificationTime != LoadedTimeStamp)
+    {
+        LoadedSize = Stat.FileSize;
+        LoadedTimeStamp = Stat.ModificationTime;
+        bDirty = false;
+        Load();
+    }
+}
+
+void FPIDGainHistory::Load()
+{
+    Headers.Reset();
+    Rows.Reset();
+
+    FString FileContent;
+    if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PIDGainHistory: Failed to read %s"), *FilePath);
+        RebuildView();
+        return;
+    }
+
+    TArray<FString> Lines;
+    FileContent.ParseIntoArrayLines(Lines, true);
+    if (Lines.Num() == 0)
+    {
+        RebuildView();
+        return;
+    }
+
+    Lines[0].ParseIntoArray(Headers, TEXT(","), true);
+
+    Rows.Reserve(Lines.Num() - 1);
+    TArray<FString> Values;
+    for (int32 LineIdx = 1; LineIdx < Lines.Num(); LineIdx++)
+    {
+        Lines[LineIdx].ParseIntoArray(Values, TEXT(","), true);
+        if (Values.Num() == 0)
+        {
+            continue;
+        }
+
+        FPIDGainRow& Row = Rows.AddDefaulted_GetRef();
+        Row.Timestamp = MoveTemp(Values[0]);
+        Row.NumValues = FMath::Min(Values.Num() - 1, FPIDGainRow::NumGains);
+        Row.FileOrder = Rows.Num() - 1;
+        for (int32 GainIdx = 0; GainIdx < Row.NumValues; GainIdx++)
+        {
+            Row.Gains[GainIdx] = FCString::Atof(*Values[GainIdx + 1]);
+        }
+    }
+
+    RebuildView();
+}
+
+void FPIDGainHistory::SetSort(int32 Column, bool bAscending)
+{
+    if (Column != SortColumn || bAscending != bSortAscending)
+    {
+        SortColumn = Column;
+        bSortAscending = bAscending;
+        RebuildView();
+    }
+}
+
+void FPIDGainHistory::SetFilter(int32 Column, const FString& Text)
+{
+    if (Column != FilterColumn || !Text.Equals(FilterText, ESearchCase::CaseSensitive))
+    {
+        FilterColumn = Column;
+        FilterText = Text;
+        RebuildView();
+    }
+}
+
+void FPIDGainHistory::RebuildView()
+{
+    View.Reset(Rows.Num());
+
+    // Numeric cells are matched against the same text the table shows
+    for (int32 RowIdx = 0; RowIdx < Rows.Num(); RowIdx++)
+    {
+        const FPIDGainRow& Row = Rows[RowIdx];
+        if (!FilterText.IsEmpty())
+        {
+            if (FilterColumn == 0)
+            {
+                if (!Row.Timestamp.Contains(FilterText))
+                {
+                    continue;
+                }
+            }
+            else if (FilterColumn > Row.NumValues
+                || !FString::Printf(TEXT("%.3f"), Row.Gains[FilterColumn - 1]).Contains(FilterText))
+            {
+                continue;
+            }
+        }
+        View.Add(RowIdx);
+    }
+
+    const int32 Column = SortColumn;
+    const bool bAscending = bSortAscending;
+    Algo::StableSort(View, [this, Column, bAscending](int32 A, int32 B)
+    {
+        const FPIDGainRow& RowA = Rows[A];
+        const FPIDGainRow& RowB = Rows[B];
+
+        // Missing values sort last either way
+        if (Column > 0 && (Column > RowA.NumValues || Column > RowB.NumValues))
+        {
+            return Column <= RowA.NumValues && Column > RowB.NumValues;
+        }
+
+        if (Column == 0)
+        {
+            return bAscending ? RowA.FileOrder < RowB.FileOrder : RowB.FileOrder < RowA.FileOrder;
+        }
+        const float KeyA = RowA.Gains[Column - 1];
+        const float KeyB = RowB.Gains[Column - 1];
+        return bAscending ? KeyA < KeyB : KeyB < KeyA;
+    });
+}
@@ -0,0 +1,115 @@
+// PerfHud.cpp
+#include "UI/PerfHud.h"
+#include "Utility/SimProfiler.h"
+#include "imgui.h"
+#include "implot.h"
+
+void FPerfHud::Draw(bool& bInOutOpen)
+{
+    FSimProfiler& Profiler = FSimProfiler::Get();
+
+    // Keep measuring while a capture runs, even if the window was closed meanwhile
+    Profiler.SetEnabled(bInOutOpen || Profiler.IsCapturing());
+    if (!bInOutOpen)
+    {
+        return;
+    }
+
+    // Window length is shared between the plot and the percentile table
+    static float WindowSeconds = 5.0f;
+
+    ImGui::SetNextWindowSize(ImVec2(700, 600), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Performance", &bInOutOpen))
+    {
+        ImGui::End();
+        return;
+    }
+
+    const FSimProfiler::FHistory& History = Profiler.GetHistory();
+
+    ImGui::SetNextItemWidth(150.0f);
+    ImGui::SliderFloat("Window (s)", &WindowSeconds, 1.0f, 30.0f, "%.0f");
+    ImGui::SameLine();
+    if (Profiler.IsCapturing())
+    {
+        ImGui::ProgressBar(Profiler.GetCaptureProgress(), ImVec2(150.0f, 0.0f), "Capturing...");
+    }
+    else if (ImGui::Button("Capture 10 s"))
+    {
+        Profiler.StartCapture(CaptureSeconds);
+    }
+    if (!Profiler.GetLastReportPath().IsEmpty())
+    {
+        ImGui::TextDisabled("Last report: %s", TCHAR_TO_UTF8(*Profiler.GetLastReportPath()));
+    }
+
+    const double WindowEnd = History.GetLatestTime();
+    const double WindowStart = WindowEnd - WindowSeconds;
+
+    if (ImPlot::BeginPlot("Frame Phases", ImVec2(-1, 250)))
+    {
+        ImPlot::SetupAxes("Time (s)", "ms", ImPlotAxisFlags_None, ImPlotAxisFlags_AutoFit);
+        ImPlot::SetupAxisLimits(ImAxis_X1, WindowStart, WindowEnd, ImPlotCond_Always);
+        ImPlot::SetupLegend(ImPlotLocation_NorthWest, ImPlotLegendFlags_Outside);
+
+        for (int32 p = 0; p < FSimProfiler::NumPhases; p++)
+        {
+            History.PlotLine(TCHAR_TO_UTF8(FSimProfiler::GetPhaseName(static_cast<ESimPhase>(p))), p);
+        }
+        History.PlotLine("Frame", FSimProfiler::FrameChannel);
+
+        ImPlot::EndPlot();
+    }
+
+    // Percentiles over the frames currently plotted
+    const int32 WindowFrames = History.Num() - History.LowerBound(WindowStart);
+    const ImGuiTableFlags TableFlags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingStretchProp;
+    if (ImGui::BeginTable("PhasePercentiles", 4, TableFlags))
+    {
+        ImGui::TableSetupColumn("Phase");
+        ImGui::TableSetupColumn("p50 (ms)");
+        ImGui::TableSetupColumn("p95 (ms)");
+        ImGui::TableSetupColumn("p99 (ms)");
+        ImGui::TableHeadersRow();
+
+        for (int32 c = 0; c < FSimProfiler::NumChannels; c++)
+        {
+            float P50, P95, P99;
+            Profiler.GetPercentiles(c, WindowFrames, P50, P95, P99);
+
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(c == FSimProfiler::FrameChannel ? "Frame" : TCHAR_TO_UTF8(FSimProfiler::GetPhaseName(static_cast<ESimPhase>(c))));
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", P50);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", P95);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", P99);
+        }
+        ImGui::EndTable();
+    }
+
+    const int32 NumDrones = Profiler.NumDroneSlots();
+    if (NumDrones > 0 && ImGui::CollapsingHeader("Per drone", ImGuiTreeNodeFlags_DefaultOpen))
+    {
+        if (ImGui::BeginTable("DroneCosts", 2, TableFlags))
+        {
+            ImGui::TableSetupColumn("Drone");
+            ImGui::TableSetupColumn("ms / frame");
+            ImGui::TableHeadersRow();
+
+            for (int32 d = 0; d < NumDrones; d++)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(TCHAR_TO_UTF8(*Profiler.GetDroneID(d)));
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", Profiler.GetDroneMs(d));
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    ImGui::End();
+}
@@ -69,12 +69,6 @@ void SZMQImageWidget::Tick(const FGeometry& AllottedGeometry, const double InCur
 		DeltaTimeAccumulator = 0.0f;
 		FrameCount = 0;
 	}
-
-	// (Optional) Refresh the brush resource if needed so that the latest render target image is shown.
-	if (RenderTarget && ImageBrush.IsValid())
-	{
-		ImageBrush->SetResourceObject(RenderTarget);
-	}
 }
 
 void SZMQImageWidget::SetRenderTarget(UTextureRenderTarget2D* InRenderTarget)
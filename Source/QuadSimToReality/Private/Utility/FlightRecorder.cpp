@@ -0,0 +1,434 @@
+// FlightRecorder.cpp
+#include "Utility/FlightRecorder.h"
+#include "Core/DroneJSONConfig.h"
+#include "Core/EnvPool.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/Paths.h"
+#include "Engine/World.h"
+
+#if PLATFORM_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// ---------------------- Mapped file ------------------------
+
+#if PLATFORM_UNIX
+
+bool FMappedAppendFile::Open(const FString& Path, int64 InDataOffset)
+{
+    Close();
+    check(InDataOffset < SegmentSize);
+
+    DataOffset = InDataOffset;
+    Appended = 0;
+
+    FileDescriptor = ::open(TCHAR_TO_UTF8(*Path), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (FileDescriptor < 0)
+    {
+        return false;
+    }
+    return MapSegment(0);
+}
+
+bool FMappedAppendFile::MapSegment(int64 NewSegmentStart)
+{
+    if (Segment)
+    {
+        ::munmap(Segment, SegmentSize);
+        Segment = nullptr;
+    }
+
+    // Grow the file a whole segment at a time so the kernel only sees one resize per 64 MB
+    if (::ftruncate(FileDescriptor, NewSegmentStart + SegmentSize) != 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FlightRecorder: Failed to grow log file to %lld bytes"), NewSegmentStart + SegmentSize);
+        return false;
+    }
+
+    void* Mapped = ::mmap(nullptr, SegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, FileDescriptor, NewSegmentStart);
+    if (Mapped == MAP_FAILED)
+    {
+        UE_LOG(LogTemp, Error, TEXT("FlightRecorder: Failed to map log segment at %lld"), NewSegmentStart);
+        return false;
+    }
+
+    Segment = static_cast<uint8*>(Mapped);
+    SegmentStart = NewSegmentStart;
+    return true;
+}
+
+void FMappedAppendFile::Append(const void* Data, int64 Size)
+{
+    const uint8* Source = static_cast<const uint8*>(Data);
+    while (Size > 0 && Segment)
+    {
+        const int64 FileOffset = DataOffset + Appended;
+        if (FileOffset >= SegmentStart + SegmentSize && !MapSegment(SegmentStart + SegmentSize))
+        {
+            return;
+        }
+
+        const int64 SegmentOffset = FileOffset - SegmentStart;
+        const int64 Count = FMath::Min(Size, SegmentSize - SegmentOffset);
+        FMemory::Memcpy(Segment + SegmentOffset, Source, Count);
+
+        Source += Count;
+        Size -= Count;
+        Appended += Count;
+    }
+}
+
+void FMappedAppendFile::WriteAt(int64 Offset, const void* Data, int64 Size)
+{
+    if (FileDescriptor >= 0)
+    {
+        ::pwrite(FileDescriptor, Data, Size, Offset);
+    }
+}
+
+void FMappedAppendFile::Close()
+{
+    if (Segment)
+    {
+        ::munmap(Segment, SegmentSize);
+        Segment = nullptr;
+    }
+    if (FileDescriptor >= 0)
+    {
+        // Drop the unused tail of the last segment
+        ::ftruncate(FileDescriptor, DataOffset + Appended);
+        ::close(FileDescriptor);
+        FileDescriptor = -1;
+    }
+}
+
+bool FMappedAppendFile::IsOpen() const
+{
+    return FileDescriptor >= 0;
+}
+
+#else
+
+bool FMappedAppendFile::Open(const FString& Path, int64 InDataOffset)
+{
+    Close();
+
+    DataOffset = InDataOffset;
+    Appended = 0;
+
+    Handle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenWrite(*Path, false, true));
+    if (!Handle)
+    {
+        return false;
+    }
+
+    TArray<uint8> Reserved;
+    Reserved.SetNumZeroed(DataOffset);
+    return Handle->Write(Reserved.GetData(), Reserved.Num());
+}
+
+void FMappedAppendFile::Append(const void* Data, int64 Size)
+{
+    FScopeLock Lock(&HandleLock);
+    if (Handle && Handle->Write(static_cast<const uint8*>(Data), Size))
+    {
+        Appended += Size;
+    }
+}
+
+void FMappedAppendFile::WriteAt(int64 Offset, const void* Data, int64 Size)
+{
+    FScopeLock Lock(&HandleLock);
+    if (Handle)
+    {
+        const int64 Position = Handle->Tell();
+        Handle->Seek(Offset);
+        Handle->Write(static_cast<const uint8*>(Data), Size);
+        Handle->Seek(Position);
+    }
+}
+
+void FMappedAppendFile::Close()
+{
+    FScopeLock Lock(&HandleLock);
+    Handle.Reset();
+}
+
+bool FMappedAppendFile::IsOpen() const
+{
+    return Handle.IsValid();
+}
+
+#endif
+
+// ---------------------- Recorder ------------------------
+
+FFlightRecorder& FFlightRecorder::Get()
+{
+    static FFlightRecorder Instance;
+    return Instance;
+}
+
+FFlightRecorder::FFlightRecorder()
+{
+    FMemory::Memzero(Header);
+
+    // One log per play session
+    FWorldDelegates::OnWorldCleanup.AddLambda([this](UWorld* World, bool bSessionEnded, bool bCleanupResources)
+    {
+        if (World && World->IsGameWorld())
+        {
+            StopSession();
+        }
+    });
+    FCoreDelegates::OnPreExit.AddRaw(this, &FFlightRecorder::StopSession);
+}
+
+FFlightRecorder::~FFlightRecorder()
+{
+    StopSession();
+
+    for (const TUniquePtr<FThreadBuffer>& Buffer : ThreadBuffers)
+    {
+        delete Buffer->Current;
+    }
+    while (FChunk* Chunk = FreeChunks.Pop())
+    {
+        delete Chunk;
+    }
+}
+
+bool FFlightRecorder::IsEnabled() const
+{
+    return UDroneJSONConfig::Get().GetConfig().FlightRecorderParams.bEnabled ||
+        FParse::Param(FCommandLine::Get(), TEXT("FlightRecord"));
+}
+
+uint32 FFlightRecorder::RegisterDrone(const FString& DroneID)
+{
+    if (!IsRecording() && IsEnabled())
+    {
+        StartSession();
+    }
+
+    FScopeLock Lock(&DroneLock);
+    if (const uint32* Existing = DroneIndices.Find(DroneID))
+    {
+        return *Existing;
+    }
+
+    const uint32 Index = DroneIndices.Num();
+    DroneIndices.Add(DroneID, Index);
+
+    if (Index < FFlightLogHeader::MaxDrones)
+    {
+        FCStringAnsi::Strncpy(Header.DroneNames[Index], TCHAR_TO_UTF8(*DroneID), FFlightLogHeader::MaxDroneNameLength);
+        Header.NumDrones = Index + 1;
+        if (IsRecording())
+        {
+            // Keep the name table current so a log from a crashed session is still readable
+            WriteHeader();
+        }
+    }
+    return Index;
+}
+
+FFlightRecorder::FThreadBuffer& FFlightRecorder::GetThreadBuffer()
+{
+    static thread_local FThreadBuffer* ThreadBuffer = nullptr;
+    if (!ThreadBuffer)
+    {
+        FScopeLock Lock(&BufferRegistryLock);
+        ThreadBuffer = ThreadBuffers.Add_GetRef(MakeUnique<FThreadBuffer>()).Get();
+    }
+    return *ThreadBuffer;
+}
+
+FFlightRecorder::FChunk* FFlightRecorder::AcquireChunk()
+{
+    FChunk* Chunk = FreeChunks.Pop();
+    if (!Chunk)
+    {
+        Chunk = new FChunk();
+    }
+    Chunk->NumRecords = 0;
+    return Chunk;
+}
+
+void FFlightRecorder::Record(const FFlightRecord& Record)
+{
+    if (!IsRecording())
+    {
+        return;
+    }
+
+    FThreadBuffer& Buffer = GetThreadBuffer();
+    if (!Buffer.Current)
+    {
+        Buffer.Current = AcquireChunk();
+    }
+
+    Buffer.Current->Records[Buffer.Current->NumRecords++] = Record;
+
+    // A flush request hands the partial chunk over; the writer never touches a chunk a producer owns
+    const bool bFlush = Buffer.bFlushRequested.load(std::memory_order_relaxed) && Buffer.bFlushRequested.exchange(false);
+    if (Buffer.Current->NumRecords == ChunkCapacity || bFlush)
+    {
+        FullChunks.Enqueue(Buffer.Current);
+        Buffer.Current = nullptr;
+        WakeEvent->Trigger();
+    }
+}
+
+bool FFlightRecorder::StartSession()
+{
+    if (IsRecording())
+    {
+        return true;
+    }
+
+    FString Directory = UDroneJSONConfig::Get().GetConfig().FlightRecorderParams.Directory;
+    if (FPaths::IsRelative(Directory))
+    {
+        Directory = FPaths::ProjectSavedDir() / Directory;
+    }
+    IFileManager::Get().MakeDirectory(*Directory, true);
+
+    FilePath = Directory / FEnvPool::Get().QualifyName(FString::Printf(TEXT("flight_%s.qsfl"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S"))));
+    if (!File.Open(FilePath, FFlightLogHeader::HeaderSize))
+    {
+        UE_LOG(LogTemp, Error, TEXT("FlightRecorder: Could not open %s"), *FilePath);
+        return false;
+    }
+
+    {
+        FScopeLock Lock(&DroneLock);
+        FMemory::Memzero(Header);
+        FMemory::Memcpy(Header.Magic, "QSFLTLOG", sizeof(Header.Magic));
+        Header.Version = FFlightLogHeader::FormatVersion;
+        Header.RecordSize = sizeof(FFlightRecord);
+        Header.HeaderBytes = FFlightLogHeader::HeaderSize;
+        Header.StartUnixTimeMs = (FDateTime::UtcNow() - FDateTime(1970, 1, 1)).GetTotalMilliseconds();
+        DroneIndices.Reset();
+        WriteHeader();
+    }
+
+    bStopWriter = false;
+    WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+    WriterThread = FRunnableThread::Create(this, TEXT("FlightRecorderWriter"), 0, TPri_BelowNormal);
+    bRecording = true;
+
+    UE_LOG(LogTemp, Display, TEXT("FlightRecorder: Recording to %s"), *FilePath);
+    return true;
+}
+
+void FFlightRecorder::StopSession()
+{
+    if (!IsRecording())
+    {
+        return;
+    }
+    bRecording = false;
+
+    if (WriterThread)
+    {
+        WriterThread->Kill(true);
+        delete WriterThread;
+        WriterThread = nullptr;
+    }
+    FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+    WakeEvent = nullptr;
+
+    // The writer has exited, so this thread is now the only consumer
+    DrainQueue();
+    {
+        FScopeLock Lock(&BufferRegistryLock);
+        for (const TUniquePtr<FThreadBuffer>& Buffer : ThreadBuffers)
+        {
+            if (Buffer->Current && Buffer->Current->NumRecords > 0)
+            {
+                WriteChunk(Buffer->Current);
+                Buffer->Current = nullptr;
+            }
+        }
+    }
+
+    {
+        FScopeLock Lock(&DroneLock);
+        Header.NumRecords = File.GetAppendedBytes() / sizeof(FFlightRecord);
+        WriteHeader();
+    }
+    File.Close();
+
+    UE_LOG(LogTemp, Display, TEXT("FlightRecorder: Wrote %llu records to %s"), Header.NumRecords, *FilePath);
+}
+
+void FFlightRecorder::Stop()
+{
+    bStopWriter = true;
+    if (WakeEvent)
+    {
+        WakeEvent->Trigger();
+    }
+}
+
+uint32 FFlightRecorder::Run()
+{
+    while (!bStopWriter)
+    {
+        // Wake for full chunks; after an idle period, ask producers for their partial ones
+        if (!WakeEvent->Wait(100))
+        {
+            RequestFlush();
+        }
+        DrainQueue();
+    }
+    DrainQueue();
+    return 0;
+}
+
+void FFlightRecorder::DrainQueue()
+{
+    bool bWrote = false;
+    FChunk* Chunk = nullptr;
+    while (FullChunks.Dequeue(Chunk))
+    {
+        WriteChunk(Chunk);
+        bWrote = true;
+    }
+
+    // The file grows a segment at a time, so after a crash only this count tells records from the zeroed tail
+    if (bWrote)
+    {
+        FScopeLock Lock(&DroneLock);
+        Header.NumRecords = File.GetAppendedBytes() / sizeof(FFlightRecord);
+        File.WriteAt(STRUCT_OFFSET(FFlightLogHeader, NumRecords), &Header.NumRecords, sizeof(Header.NumRecords));
+    }
+}
+
+void FFlightRecorder::RequestFlush()
+{
+    FScopeLock Lock(&BufferRegistryLock);
+    for (const TUniquePtr<FThreadBuffer>& Buffer : ThreadBuffers)
+    {
+        Buffer->bFlushRequested.store(true, std::memory_order_relaxed);
+    }
+}
+
+void FFlightRecorder::WriteChunk(FChunk* Chunk)
+{
+    File.Append(Chunk->Records, static_cast<int64>(Chunk->NumRecords) * sizeof(FFlightRecord));
+    Chunk->NumRecords = 0;
+    FreeChunks.Push(Chunk);
+}
+
+void FFlightRecorder::WriteHeader()
+{
+    File.WriteAt(0, &Header, sizeof(Header));
+}
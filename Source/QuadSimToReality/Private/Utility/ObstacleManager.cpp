@@ -2,9 +2,11 @@
 
 #include "Utility/ObstacleManager.h"
 #include "Core/DroneJSONConfig.h"
+#include "Core/RunProfile.h"
 #include "DrawDebugHelpers.h"
 #include "Kismet/GameplayStatics.h"
 #include "Pawns/QuadPawn.h"
+#include "Utility/SimProfiler.h"
 
 
 AObstacleManager::AObstacleManager() {
@@ -15,7 +17,8 @@ AObstacleManager::AObstacleManager() {
     VisualMarker->SetCollisionEnabled(ECollisionEnabled::NoCollision);
     VisualMarker->SetVisibility(false); // Hide by default
     
-    const auto& Config = UDroneJSONConfig::Get().Config;
+    // BeginPlay applies the loaded config again, so class defaults can stay on the built-in values
+    const FDroneConfigData& Config = UDroneJSONConfig::GetConfigFor(*this);
     OuterBoundarySize = Config.ObstacleParams.OuterBoundarySize;
     InnerBoundarySize = Config.ObstacleParams.InnerBoundarySize;
     ObstacleSpawnHeight = Config.ObstacleParams.SpawnHeight;
@@ -25,8 +28,27 @@ AObstacleManager::AObstacleManager() {
 
 void AObstacleManager::BeginPlay() {
     Super::BeginPlay();
-    
-    VisualizeSpawnBoundaries(true);
+
+    UDroneJSONConfig& ConfigObject = UDroneJSONConfig::Get();
+    ConfigChangedHandle = ConfigObject.OnConfigChanged().AddUObject(this, &AObstacleManager::ApplyConfig);
+    ApplyConfig(ConfigObject.GetConfig());
+}
+
+void AObstacleManager::EndPlay(const EEndPlayReason::Type EndPlayReason) {
+    UDroneJSONConfig::Get().OnConfigChanged().Remove(ConfigChangedHandle);
+    Super::EndPlay(EndPlayReason);
+}
+
+void AObstacleManager::ApplyConfig(const FDroneConfigData& Config) {
+    OuterBoundarySize = Config.ObstacleParams.OuterBoundarySize;
+    InnerBoundarySize = Config.ObstacleParams.InnerBoundarySize;
+    ObstacleSpawnHeight = Config.ObstacleParams.SpawnHeight;
+
+    // Boundaries are drawn as persistent lines, so redraw them at the new size
+    if (FRunProfile::Get().WantsDebugDraw()) {
+        FlushPersistentDebugLines(GetWorld());
+        VisualizeSpawnBoundaries(true);
+    }
 }
 
 void AObstacleManager::VisualizeSpawnBoundaries(bool bPersistentLines) {
@@ -72,8 +94,8 @@ FVector AObstacleManager::GetRandomInnerPoint() {
     float HalfInnerSize = InnerBoundarySize * 0.5f;
     
     // Random position within inner boundary
-    float X = FMath::RandRange(-HalfInnerSize, HalfInnerSize);
-    float Y = FMath::RandRange(-HalfInnerSize, HalfInnerSize);
+    float X = RandomStream.FRandRange(-HalfInnerSize, HalfInnerSize);
+    float Y = RandomStream.FRandRange(-HalfInnerSize, HalfInnerSize);
     
     // Return center-relative point
     return CenterPoint + FVector(X, Y, ObstacleSpawnHeight);
@@ -93,7 +115,7 @@ AActor* AObstacleManager::SpawnObstacle() {
            *SpawnLocation.ToString(), InnerBoundarySize);
     
     // Random rotation around Z axis only
-    FRotator SpawnRotation(0.0f, FMath::RandRange(0.0f, 360.0f), 0.0f);
+    FRotator SpawnRotation(0.0f, RandomStream.FRandRange(0.0f, 360.0f), 0.0f);
     
     // Spawn parameters
     FActorSpawnParameters SpawnParams;
@@ -121,7 +143,7 @@ AActor* AObstacleManager::SpawnGoal(EGoalPosition Position) {
 
     // Default to a random position if specified
     if (Position == EGoalPosition::Random) {
-        Position = static_cast<EGoalPosition>(FMath::RandRange(0, 3));
+        Position = static_cast<EGoalPosition>(RandomStream.RandRange(0, 3));
     }
     
     // Calculate spawn location based on selected boundary face
@@ -172,6 +194,14 @@ AActor* AObstacleManager::SpawnGoal(EGoalPosition Position) {
 }
 
 void AObstacleManager::CreateObstacles(int32 NumObstacles, EGoalPosition GoalPos) {
+    // Drawn from the global stream so seeded runs still reproduce the layout
+    CreateObstaclesWithSeed(NumObstacles, FMath::Rand(), GoalPos, true);
+}
+
+void AObstacleManager::CreateObstaclesWithSeed(int32 NumObstacles, int32 Seed, EGoalPosition GoalPos, bool bMoveDrone) {
+    FSimScopedTimer Timer(ESimPhase::Obstacles);
+    RandomStream.Initialize(Seed);
+
     // Clear any existing obstacles first
     ClearObstacles();
     
@@ -186,20 +216,26 @@ void AObstacleManager::CreateObstacles(int32 NumObstacles, EGoalPosition GoalPos
     // Handle Random goal position here, before spawning the goal
     EGoalPosition ActualGoalPos = GoalPos;
     if (ActualGoalPos == EGoalPosition::Random) {
-        ActualGoalPos = static_cast<EGoalPosition>(FMath::RandRange(0, 3));
+        ActualGoalPos = static_cast<EGoalPosition>(RandomStream.RandRange(0, 3));
     }
     
     // Spawn goal with the actual position
     SpawnedGoal = SpawnGoal(ActualGoalPos);
     
     // Move drone to opposite of the actual goal position
-    MoveDroneToOppositeOfGoal(ActualGoalPos);
+    if (bMoveDrone) {
+        MoveDroneToOppositeOfGoal(ActualGoalPos);
+    }
     
-    VisualizeSpawnBoundaries(true);
+    if (FRunProfile::Get().WantsDebugDraw()) {
+        VisualizeSpawnBoundaries(true);
+    }
 
     UE_LOG(LogTemp, Display, TEXT("Created %d obstacles and 1 goal, drone placed opposite"), NumObstacles);
 }
 void AObstacleManager::ClearObstacles() {
+    FSimScopedTimer Timer(ESimPhase::Obstacles);
+
     // Clear any existing debug drawings first
     FlushPersistentDebugLines(GetWorld());
     
@@ -265,7 +301,7 @@ FVector AObstacleManager::GetPositionLocation(EGoalPosition Position) {
 void AObstacleManager::MoveDroneToOppositeOfGoal(EGoalPosition GoalPos) {
     // If random was selected, pick one of the four positions
     if (GoalPos == EGoalPosition::Random) {
-        GoalPos = static_cast<EGoalPosition>(FMath::RandRange(0, 3));
+        GoalPos = static_cast<EGoalPosition>(RandomStream.RandRange(0, 3));
     }
     
     // Calculate center point
@@ -8,6 +8,9 @@ QuadPIDController::QuadPIDController()
     , DerivativeGain(0.0f)
     , prevError(0.0f)
     , lastOutput(0.0f)
+    , lastPTerm(0.0f)
+    , lastITerm(0.0f)
+    , lastDTerm(0.0f)
     , absoluteTime(0.0f)
     , currentBufferSum(0.0f)
     , minOutput(0.0f)
@@ -81,6 +84,9 @@ double QuadPIDController::Calculate(float error, float dt)
     
     prevError = error;
     lastOutput = output;
+    lastPTerm = p_term;
+    lastITerm = i_term;
+    lastDTerm = d_term;
 
     // Debug logging
     UE_LOG(LogTemp, VeryVerbose, TEXT("Time: %.3f, Buffer Size: %d, Sum: %.4f, Raw D: %.4f, Filtered D: %.4f"), 
@@ -0,0 +1,126 @@
+// SharedFrameRing.cpp
+#include "Utility/SharedFrameRing.h"
+
+#if PLATFORM_UNIX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+bool FSharedFrameRing::Open(const FString& InName, int32 InWidth, int32 InHeight, int32 InNumSlots)
+{
+    Close();
+
+#if PLATFORM_UNIX
+    if (InWidth <= 0 || InHeight <= 0 || InNumSlots <= 0)
+    {
+        return false;
+    }
+
+    const int64 PixelBytes = static_cast<int64>(InWidth) * InHeight * sizeof(FColor);
+    const int64 SlotBytes = Align(FSharedFrameRingHeader::SlotHeaderSize + PixelBytes, 64);
+    const int64 TotalBytes = FSharedFrameRingHeader::HeaderSize + SlotBytes * InNumSlots;
+    const FTCHARToUTF8 ShmName(*(TEXT("/") + InName));
+
+    // A segment left over from a crashed run may have another size, so always start from a fresh one
+    ::shm_unlink(ShmName.Get());
+    const int Descriptor = ::shm_open(ShmName.Get(), O_CREAT | O_RDWR, 0600);
+    if (Descriptor < 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SharedFrameRing: shm_open(%s) failed: %d"), *InName, errno);
+        return false;
+    }
+
+    void* Mapped = MAP_FAILED;
+    if (::ftruncate(Descriptor, TotalBytes) == 0)
+    {
+        Mapped = ::mmap(nullptr, TotalBytes, PROT_READ | PROT_WRITE, MAP_SHARED, Descriptor, 0);
+    }
+    ::close(Descriptor);
+
+    if (Mapped == MAP_FAILED)
+    {
+        UE_LOG(LogTemp, Error, TEXT("SharedFrameRing: Could not map %lld bytes for %s: %d"), TotalBytes, *InName, errno);
+        ::shm_unlink(ShmName.Get());
+        return false;
+    }
+
+    // ftruncate zero-fills, so every slot starts with an even (complete, empty) sequence
+    Header = static_cast<FSharedFrameRingHeader*>(Mapped);
+    Header->Version = FSharedFrameRingHeader::FormatVersion;
+    Header->NumSlots = InNumSlots;
+    Header->SlotBytes = static_cast<uint32>(SlotBytes);
+    Header->Width = InWidth;
+    Header->Height = InHeight;
+    Header->BytesPerPixel = sizeof(FColor);
+    Header->LatestFrame.store(0, std::memory_order_relaxed);
+
+    // Readers check the magic last, so publish it after the rest of the header
+    std::atomic_thread_fence(std::memory_order_release);
+    FMemory::Memcpy(Header->Magic, "QSFRAMES", sizeof(Header->Magic));
+
+    Name = InName;
+    MappedBytes = TotalBytes;
+    NumSlots = InNumSlots;
+    Width = InWidth;
+    Height = InHeight;
+    NextFrameId = 1;
+
+    UE_LOG(LogTemp, Display, TEXT("SharedFrameRing: /dev/shm/%s, %d slots of %dx%d"), *Name, NumSlots, Width, Height);
+    return true;
+#else
+    UE_LOG(LogTemp, Warning, TEXT("SharedFrameRing: Shared memory frames are only supported on Unix"));
+    return false;
+#endif
+}
+
+void FSharedFrameRing::Close()
+{
+#if PLATFORM_UNIX
+    if (Header)
+    {
+        ::munmap(Header, MappedBytes);
+        ::shm_unlink(FTCHARToUTF8(*(TEXT("/") + Name)).Get());
+    }
+#endif
+    Header = nullptr;
+    MappedBytes = 0;
+    NumSlots = 0;
+}
+
+FSharedFrameSlot* FSharedFrameRing::GetSlot(int32 Index) const
+{
+    uint8* Base = reinterpret_cast<uint8*>(Header) + FSharedFrameRingHeader::HeaderSize;
+    return reinterpret_cast<FSharedFrameSlot*>(Base + static_cast<int64>(Header->SlotBytes) * Index);
+}
+
+uint64 FSharedFrameRing::Write(const FColor* Pixels, int32 InWidth, int32 InHeight, double SimTime)
+{
+    if (!Header || InWidth != Width || InHeight != Height)
+    {
+        return 0;
+    }
+
+    const uint64 FrameId = NextFrameId++;
+    FSharedFrameSlot* Slot = GetSlot(static_cast<int32>((FrameId - 1) % NumSlots));
+
+    // Odd while writing; the fence keeps the pixel stores from moving above the odd sequence
+    const uint32 Sequence = Slot->Sequence.load(std::memory_order_relaxed);
+    Slot->Sequence.store(Sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Slot->FrameId = FrameId;
+    Slot->SimTime = SimTime;
+    Slot->Width = Width;
+    Slot->Height = Height;
+    FMemory::Memcpy(reinterpret_cast<uint8*>(Slot) + FSharedFrameRingHeader::SlotHeaderSize, Pixels, static_cast<int64>(Width) * Height * sizeof(FColor));
+
+    Slot->Sequence.store(Sequence + 2, std::memory_order_release);
+    Header->LatestFrame.store(FrameId, std::memory_order_release);
+    return FrameId;
+}
+
+FString FSharedFrameRing::MakeDescriptor(uint64 FrameId) const
+{
+    return FString::Printf(TEXT("SHM:%s,%llu,%d,%d,%d"), *Name, FrameId, NumSlots > 0 ? static_cast<int32>((FrameId - 1) % NumSlots) : 0, Width, Height);
+}
@@ -0,0 +1,385 @@
+// SimProfiler.cpp
+#include "Utility/SimProfiler.h"
+#include "Algo/Sort.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+std::atomic<bool> FSimProfiler::bEnabled{ false };
+
+namespace
+{
+    // Smoothing of the per-drone readout; roughly the last 20 frames
+    constexpr float DroneMsSmoothing = 0.05f;
+
+    // Innermost running timer on this thread
+    thread_local FSimScopedTimer* CurrentTimer = nullptr;
+
+    float Percentile(const TArray<float>& Sorted, float Fraction)
+    {
+        if (Sorted.Num() == 0)
+        {
+            return 0.f;
+        }
+        const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+        return Sorted[Index];
+    }
+}
+
+FSimProfiler& FSimProfiler::Get()
+{
+    static FSimProfiler Instance;
+    return Instance;
+}
+
+const TCHAR* FSimProfiler::GetPhaseName(ESimPhase Phase)
+{
+    switch (Phase)
+    {
+    case ESimPhase::Control:       return TEXT("Control");
+    case ESimPhase::Physics:       return TEXT("Physics");
+    case ESimPhase::ZMQ:           return TEXT("ZMQ I/O");
+    case ESimPhase::ROS2:          return TEXT("ROS2 publish");
+    case ESimPhase::ImageCapture:  return TEXT("Image capture");
+    case ESimPhase::ImageReadback: return TEXT("Image readback");
+    case ESimPhase::ImageEncode:   return TEXT("Image encode");
+    case ESimPhase::Obstacles:     return TEXT("Obstacles");
+    case ESimPhase::UI:            return TEXT("UI build");
+    default:                       return TEXT("Unknown");
+    }
+}
+
+void FSimProfiler::SetEnabled(bool bInEnabled)
+{
+    check(IsInGameThread());
+
+    if (bInEnabled == IsEnabled())
+    {
+        return;
+    }
+
+    if (bInEnabled)
+    {
+        // Start from the current totals so time measured before this point is not dumped into one frame
+        FScopeLock Lock(&RegistryLock);
+        FMemory::Memzero(LastPhaseTotals);
+        FMemory::Memzero(LastDroneTotals);
+        for (const TUniquePtr<FThreadCounters>& Counters : ThreadCounters)
+        {
+            for (int32 p = 0; p < NumPhases; p++)
+            {
+                LastPhaseTotals[p] += Counters->Phases[p].load(std::memory_order_relaxed);
+            }
+            for (int32 d = 0; d < MaxDrones; d++)
+            {
+                LastDroneTotals[d] += Counters->Drones[d].load(std::memory_order_relaxed);
+            }
+        }
+
+        History.Reset();
+        StartTime = FPlatformTime::Seconds();
+        LastEndFrameTime = StartTime;
+        EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FSimProfiler::EndFrame);
+    }
+    else
+    {
+        FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+        EndFrameHandle.Reset();
+        CaptureDuration = 0.0;
+    }
+
+    bEnabled.store(bInEnabled, std::memory_order_relaxed);
+}
+
+FSimProfiler::FThreadCounters& FSimProfiler::GetThreadCounters()
+{
+    static thread_local FThreadCounters* Counters = nullptr;
+    if (!Counters)
+    {
+        FScopeLock Lock(&RegistryLock);
+        Counters = ThreadCounters.Add_GetRef(MakeUnique<FThreadCounters>()).Get();
+    }
+    return *Counters;
+}
+
+void FSimProfiler::AddCycles(ESimPhase Phase, int32 DroneSlot, uint64 Cycles)
+{
+    // Only this thread writes its counters, so a plain load and store is enough; the reader may see either value
+    FThreadCounters& Counters = GetThreadCounters();
+    std::atomic<uint64>& PhaseCounter = Counters.Phases[static_cast<int32>(Phase)];
+    PhaseCounter.store(PhaseCounter.load(std::memory_order_relaxed) + Cycles, std::memory_order_relaxed);
+
+    if (DroneSlot >= 0 && DroneSlot < MaxDrones)
+    {
+        std::atomic<uint64>& DroneCounter = Counters.Drones[DroneSlot];
+        DroneCounter.store(DroneCounter.load(std::memory_order_relaxed) + Cycles, std::memory_order_relaxed);
+    }
+}
+
+int32 FSimProfiler::GetDroneSlot(const FString& DroneID)
+{
+    FScopeLock Lock(&RegistryLock);
+    if (const int32* Slot = DroneSlots.Find(DroneID))
+    {
+        return *Slot;
+    }
+    if (DroneIDs.Num() >= MaxDrones)
+    {
+        return INDEX_NONE;
+    }
+    DroneIDs.Add(DroneID);
+    return DroneSlots.Add(DroneID, DroneIDs.Num() - 1);
+}
+
+FString FSimProfiler::GetDroneID(int32 Slot) const
+{
+    FScopeLock Lock(&RegistryLock);
+    return DroneIDs.IsValidIndex(Slot) ? DroneIDs[Slot] : FString();
+}
+
+int32 FSimProfiler::NumDroneSlots() const
+{
+    FScopeLock Lock(&RegistryLock);
+    return DroneIDs.Num();
+}
+
+void FSimProfiler::BindPhysics(UWorld* World)
+{
+    FPhysScene* Scene = World ? World->GetPhysicsScene() : nullptr;
+    if (!Scene || PhysicsHandles.Contains(World))
+    {
+        return;
+    }
+
+    const FDelegateHandle PreTick = Scene->OnPhysScenePreTick.AddLambda([this](auto*, float)
+    {
+        PhysicsStartCycles = IsEnabled() ? FPlatformTime::Cycles64() : 0;
+    });
+    const FDelegateHandle PostTick = Scene->OnPhysScenePostTick.AddLambda([this](auto*)
+    {
+        if (PhysicsStartCycles != 0)
+        {
+            AddCycles(ESimPhase::Physics, INDEX_NONE, FPlatformTime::Cycles64() - PhysicsStartCycles);
+            PhysicsStartCycles = 0;
+        }
+    });
+    PhysicsHandles.Add(World, TPair<FDelegateHandle, FDelegateHandle>(PreTick, PostTick));
+}
+
+void FSimProfiler::UnbindPhysics(UWorld* World)
+{
+    TPair<FDelegateHandle, FDelegateHandle> Handles;
+    if (!PhysicsHandles.RemoveAndCopyValue(World, Handles))
+    {
+        return;
+    }
+    if (FPhysScene* Scene = World->GetPhysicsScene())
+    {
+        Scene->OnPhysScenePreTick.Remove(Handles.Key);
+        Scene->OnPhysScenePostTick.Remove(Handles.Value);
+    }
+}
+
+void FSimProfiler::EndFrame()
+{
+    uint64 PhaseTotals[NumPhases] = {};
+    uint64 DroneTotals[MaxDrones] = {};
+    int32 NumDrones = 0;
+    {
+        FScopeLock Lock(&RegistryLock);
+        NumDrones = DroneIDs.Num();
+        for (const TUniquePtr<FThreadCounters>& Counters : ThreadCounters)
+        {
+            for (int32 p = 0; p < NumPhases; p++)
+            {
+                PhaseTotals[p] += Counters->Phases[p].load(std::memory_order_relaxed);
+            }
+            for (int32 d = 0; d < NumDrones; d++)
+            {
+                DroneTotals[d] += Counters->Drones[d].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    const double MsPerCycle = FPlatformTime::GetSecondsPerCycle64() * 1000.0;
+    FCaptureFrame Frame;
+    for (int32 p = 0; p < NumPhases; p++)
+    {
+        Frame.Ms[p] = static_cast<float>((PhaseTotals[p] - LastPhaseTotals[p]) * MsPerCycle);
+        LastPhaseTotals[p] = PhaseTotals[p];
+    }
+
+    // Measured wall time; FApp::GetDeltaTime() is the fixed step under -MaxSpeed and journal replay
+    const double Now = FPlatformTime::Seconds();
+    Frame.Ms[FrameChannel] = static_cast<float>((Now - LastEndFrameTime) * 1000.0);
+    LastEndFrameTime = Now;
+
+    for (int32 d = 0; d < NumDrones; d++)
+    {
+        const float Ms = static_cast<float>((DroneTotals[d] - LastDroneTotals[d]) * MsPerCycle);
+        LastDroneTotals[d] = DroneTotals[d];
+        DroneMs[d] = FMath::Lerp(DroneMs[d], Ms, DroneMsSmoothing);
+
+        if (IsCapturing())
+        {
+            CaptureDroneMs.SetNumZeroed(NumDrones);
+            CaptureDroneMs[d] += Ms;
+        }
+    }
+
+    History.Push(Now - StartTime,
+        Frame.Ms[0], Frame.Ms[1], Frame.Ms[2], Frame.Ms[3], Frame.Ms[4],
+        Frame.Ms[5], Frame.Ms[6], Frame.Ms[7], Frame.Ms[8], Frame.Ms[9]);
+    static_assert(NumChannels == 10, "Update the History.Push call when adding phases");
+
+    if (IsCapturing())
+    {
+        CaptureFrames.Add(Frame);
+        if (Now - CaptureStart >= CaptureDuration)
+        {
+            WriteReport();
+            CaptureDuration = 0.0;
+        }
+    }
+}
+
+bool FSimProfiler::StartCapture(double Seconds)
+{
+    if (IsCapturing() || Seconds <= 0.0)
+    {
+        return false;
+    }
+
+    SetEnabled(true);
+    CaptureFrames.Reset();
+    CaptureDroneMs.Reset();
+    CaptureStart = FPlatformTime::Seconds();
+    CaptureDuration = Seconds;
+    return true;
+}
+
+float FSimProfiler::GetCaptureProgress() const
+{
+    return IsCapturing() ? FMath::Clamp(static_cast<float>((FPlatformTime::Seconds() - CaptureStart) / CaptureDuration), 0.f, 1.f) : 0.f;
+}
+
+void FSimProfiler::GetPercentiles(int32 Channel, int32 NumFrames, float& OutP50, float& OutP95, float& OutP99) const
+{
+    const int32 Count = FMath::Min(NumFrames, History.Num());
+    PercentileScratch.Reset(Count);
+    for (int32 i = History.Num() - Count; i < History.Num(); i++)
+    {
+        PercentileScratch.Add(static_cast<float>(History.GetValue(Channel, i)));
+    }
+    Algo::Sort(PercentileScratch);
+
+    OutP50 = Percentile(PercentileScratch, 0.50f);
+    OutP95 = Percentile(PercentileScratch, 0.95f);
+    OutP99 = Percentile(PercentileScratch, 0.99f);
+}
+
+void FSimProfiler::WriteReport()
+{
+    TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+    Report->SetStringField(TEXT("timestamp"), FDateTime::Now().ToIso8601());
+    Report->SetNumberField(TEXT("duration_s"), FPlatformTime::Seconds() - CaptureStart);
+    Report->SetNumberField(TEXT("frames"), CaptureFrames.Num());
+
+    // Summary statistics per phase plus the whole frame
+    TSharedRef<FJsonObject> Phases = MakeShared<FJsonObject>();
+    TArray<float> Values;
+    for (int32 c = 0; c < NumChannels; c++)
+    {
+        Values.Reset(CaptureFrames.Num());
+        double Sum = 0.0;
+        for (const FCaptureFrame& Frame : CaptureFrames)
+        {
+            Values.Add(Frame.Ms[c]);
+            Sum += Frame.Ms[c];
+        }
+        Algo::Sort(Values);
+
+        TSharedRef<FJsonObject> Stats = MakeShared<FJsonObject>();
+        Stats->SetNumberField(TEXT("mean_ms"), Values.Num() > 0 ? Sum / Values.Num() : 0.0);
+        Stats->SetNumberField(TEXT("p50_ms"), Percentile(Values, 0.50f));
+        Stats->SetNumberField(TEXT("p95_ms"), Percentile(Values, 0.95f));
+        Stats->SetNumberField(TEXT("p99_ms"), Percentile(Values, 0.99f));
+        Stats->SetNumberField(TEXT("max_ms"), Values.Num() > 0 ? Values.Last() : 0.f);
+
+        const TCHAR* Name = c == FrameChannel ? TEXT("Frame") : GetPhaseName(static_cast<ESimPhase>(c));
+        Phases->SetObjectField(Name, Stats);
+    }
+    Report->SetObjectField(TEXT("phases"), Phases);
+
+    TSharedRef<FJsonObject> Drones = MakeShared<FJsonObject>();
+    for (int32 d = 0; d < CaptureDroneMs.Num(); d++)
+    {
+        Drones->SetNumberField(GetDroneID(d), CaptureFrames.Num() > 0 ? CaptureDroneMs[d] / CaptureFrames.Num() : 0.0);
+    }
+    Report->SetObjectField(TEXT("drone_mean_ms"), Drones);
+
+    // Raw per-frame values in channel order, for plotting regressions offline
+    TArray<TSharedPtr<FJsonValue>> ChannelNames;
+    for (int32 c = 0; c < NumChannels; c++)
+    {
+        ChannelNames.Add(MakeShared<FJsonValueString>(c == FrameChannel ? TEXT("Frame") : GetPhaseName(static_cast<ESimPhase>(c))));
+    }
+    Report->SetArrayField(TEXT("channels"), ChannelNames);
+
+    TArray<TSharedPtr<FJsonValue>> FrameValues;
+    FrameValues.Reserve(CaptureFrames.Num());
+    for (const FCaptureFrame& Frame : CaptureFrames)
+    {
+        TArray<TSharedPtr<FJsonValue>> Row;
+        for (int32 c = 0; c < NumChannels; c++)
+        {
+            Row.Add(MakeShared<FJsonValueNumber>(Frame.Ms[c]));
+        }
+        FrameValues.Add(MakeShared<FJsonValueArray>(Row));
+    }
+    Report->SetArrayField(TEXT("frame_ms"), FrameValues);
+
+    FString Json;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Report, Writer);
+
+    const FString Directory = FPaths::ProjectSavedDir() / TEXT("Profiles");
+    IFileManager::Get().MakeDirectory(*Directory, true);
+    LastReportPath = Directory / FString::Printf(TEXT("SimProfile_%s.json"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+
+    if (FFileHelper::SaveStringToFile(Json, *LastReportPath))
+    {
+        UE_LOG(LogTemp, Display, TEXT("SimProfiler: Wrote %d frames to %s"), CaptureFrames.Num(), *LastReportPath);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SimProfiler: Failed to write %s"), *LastReportPath);
+    }
+
+    CaptureFrames.Reset();
+    CaptureDroneMs.Reset();
+}
+
+void FSimScopedTimer::Start()
+{
+    Parent = CurrentTimer;
+    CurrentTimer = this;
+    StartCycles = FPlatformTime::Cycles64();
+}
+
+void FSimScopedTimer::Stop()
+{
+    const uint64 Elapsed = FPlatformTime::Cycles64() - StartCycles;
+    CurrentTimer = Parent;
+    if (Parent)
+    {
+        Parent->ChildCycles += Elapsed;
+    }
+    FSimProfiler::Get().AddCycles(Phase, DroneSlot, Elapsed - FMath::Min(ChildCycles, Elapsed));
+}
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Math/RandomStream.h"
 #include "Utility/QuadPIDConroller.h"
+#include "Core/DroneJSONConfig.h"
+#include "Core/DroneStateSample.h"
+#include "Core/CommandMailbox.h"
 #include "UI/ImGuiUtil.h"
 #include "QuadDroneController.generated.h"
 
 class AQuadPawn; 
+struct FDroneRandomization;
 
 USTRUCT()
 struct FFullPIDSet
@@ -27,6 +32,20 @@ struct FFullPIDSet
        , PitchPID(nullptr)
        , YawPID(nullptr)
     {}
+
+    QuadPIDController* GetAxis(EPIDAxis Axis) const
+    {
+        switch (Axis)
+        {
+        case EPIDAxis::X:     return XPID;
+        case EPIDAxis::Y:     return YPID;
+        case EPIDAxis::Z:     return ZPID;
+        case EPIDAxis::Roll:  return RollPID;
+        case EPIDAxis::Pitch: return PitchPID;
+        case EPIDAxis::Yaw:   return YawPID;
+        default:              return nullptr;
+        }
+    }
 };
 
 
@@ -56,6 +75,14 @@ public:
     void ResetDroneIntegral();
     void ResetDroneHigh();
     void ResetDroneOrigin();
+    void ResetDroneTo(const FVector& Location, const FRotator& Rotation);
+
+    /** Teleports once and applies a domain-randomized mass, inertia, motor constant, wind and sensor noise */
+    void ApplyRandomization(const FDroneRandomization& Randomization);
+
+    /** State as a sensor would report it under the current randomization */
+    FVector GetSensedPosition(const FVector& TruePosition) { return AddSensorNoise(TruePosition, PositionNoiseStdDev); }
+    FVector GetSensedVelocity(const FVector& TrueVelocity) { return AddSensorNoise(TrueVelocity, VelocityNoiseStdDev); }
     
     void DrawDebugVisuals(const FVector& horizontalVelocity) const;
     void SetDesiredVelocity(const FVector& NewVelocity);
@@ -70,7 +97,50 @@ public:
 
     bool IsHoverModeActive() const { return bHoverModeActive; }
     void SetHoverMode(bool bActive);
+
+    /** Re-derives cached limits and gains from a config snapshot. Bound to UDroneJSONConfig::OnConfigChanged. */
+    void ApplyConfig(const FDroneConfigData& Config);
+
+    /** Name of the airframe profile this drone resolved to */
+    FName GetAirframeName() const { return Profile ? Profile->Name : NAME_None; }
+
+    /** Variable an axis's gains are scheduled on, or None. Scheduled gains are rewritten every control step. */
+    EGainScheduleVariable GetGainScheduleVariable(EPIDAxis Axis) const;
+
+    /** Feeds gain schedules indexed by battery voltage. Defaults to the profile's nominal voltage. */
+    void SetBatteryVoltage(float Voltage) { BatteryVoltage = Voltage; }
+    float GetBatteryVoltage() const { return BatteryVoltage; }
+
+    /** Index the next control step will carry; counts from 0 like FDroneStateSample::Step */
+    uint64 GetControlStep() const { return ControlStep; }
+
+    /** Fired at the end of every control step; the sample is only built while something is bound */
+    FOnDroneControlStep& OnControlStep() { return ControlStepEvent; }
+
+    /**
+     * Latest-value command slots, safe to post to from any thread. A command switches the drone to its control mode
+     * (velocity, attitude or raw motor thrust); if several kinds arrive within one step, the later one in that list wins.
+     */
+    TSharedRef<FDroneCommandMailboxes, ESPMode::ThreadSafe> GetCommandMailboxes() const { return CommandMailboxes; }
+
+    /** Holds roll and pitch at the target attitude, turns to its yaw and applies the collective thrust (1 = hover) */
+    void SetAttitudeTarget(const FRotator& Attitude, float CollectiveThrust);
+    bool IsAttitudeModeActive() const { return bAttitudeMode; }
 private:
+    // Evaluates the profile's gain tables for the current flight state and loads them into the PIDs
+    void ApplyGainSchedules(const FVector& CurrentVelocity, const FVector& CurrentPosition);
+
+    // Appends this control step to the flight log
+    void RecordFlightStep(const FVector& CurrentPosition, const FVector& CurrentVelocity, const FRotator& CurrentRotation);
+
+    // Applies whatever arrived in the command mailboxes since the last step
+    void ConsumeExternalCommands();
+
+    // Hands this control step's state to OnControlStep listeners
+    void BroadcastControlStep(const FVector& CurrentPosition, const FVector& CurrentVelocity, double DeltaTime);
+
+    void ApplyWind();
+    FVector AddSensorNoise(const FVector& Value, float StdDev);
     
     UPROPERTY()
     TArray<FFullPIDSet> PIDMap; 
@@ -100,5 +170,35 @@ private:
 
     bool bHoverModeActive;
     float hoverTargetAltitude;
-    
+
+    FDelegateHandle ConfigChangedHandle;
+
+    // Points into a config snapshot, which stays alive for the lifetime of the config object
+    const FDroneConfigData::FAirframeProfile* Profile;
+    float BatteryVoltage;
+
+    // Flight recorder bookkeeping
+    uint32 RecorderDroneIndex;
+    uint64 ControlStep;
+
+    // Per-drone attribution in the performance HUD
+    int32 ProfilerDroneSlot;
+
+    FOnDroneControlStep ControlStepEvent;
+    FVector LastStepVelocity;
+
+    TSharedRef<FDroneCommandMailboxes, ESPMode::ThreadSafe> CommandMailboxes;
+    bool bAttitudeMode;
+    FRotator AttitudeTarget;
+    float AttitudeThrust;
+
+    // Domain randomization from the last batch reset
+    float BaseMassKg;
+    float MotorConstantScale;
+    FVector WindAcceleration;
+    float WindGustStdDev;
+    float PositionNoiseStdDev;
+    float VelocityNoiseStdDev;
+    FRandomStream GustStream;
+    FRandomStream NoiseStream;
 };
\ No newline at end of file
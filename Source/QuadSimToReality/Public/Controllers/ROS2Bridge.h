@@ -0,0 +1,187 @@
+// ROS2Bridge.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Controllers/ROS2StatePublisher.h"
+#include "Core/CommandMailbox.h"
+#include "ROS2Bridge.generated.h"
+
+class ADroneManager;
+class AQuadPawn;
+class UROS2GenericMsg;
+class UROS2NodeComponent;
+class UROS2Publisher;
+class UROS2Subscriber;
+struct FExternalCommand;
+
+/** Topic names (relative to each drone's namespace) and rates the bridge uses for every drone */
+USTRUCT(BlueprintType)
+struct FROS2BridgeTopics
+{
+	GENERATED_BODY()
+
+	// State streams, published every Nth control step (0 disables a stream)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|State")
+	FString Odometry = TEXT("odom");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|State", meta = (ClampMin = "0"))
+	int32 OdometryDecimation = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|State")
+	FString Imu = TEXT("imu/data");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|State", meta = (ClampMin = "0"))
+	int32 ImuDecimation = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|State")
+	FString Motors = TEXT("motor_outputs");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|State", meta = (ClampMin = "0"))
+	int32 MotorDecimation = 1;
+
+	// Command topics (geometry_msgs/Twist; Float32MultiArray [roll, pitch, yaw (rad), thrust (1 = hover)];
+	// Float32MultiArray with one thrust per motor). Empty disables a subscriber.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|Commands")
+	FString VelocityCommand = TEXT("cmd_vel");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|Commands")
+	FString AttitudeCommand = TEXT("cmd_attitude");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|Commands")
+	FString MotorCommand = TEXT("cmd_motors");
+};
+
+/** One drone's publishers, subscribers and command mailboxes on the bridge's node */
+UCLASS()
+class QUADSIMTOREALITY_API UROS2DroneLink : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** Creates the drone's topics under Namespace. The pawn's controller must exist. */
+	void Init(AQuadPawn* InPawn, const FString& InNamespace, UROS2NodeComponent* Node, const FROS2BridgeTopics& Topics, FROS2StatePublisher* InStatePublisher);
+
+	/** Stops publishing and tears the drone's topics down. The link is unusable afterwards. */
+	void Shutdown();
+
+	AQuadPawn* GetPawn() const { return Pawn.Get(); }
+	const FString& GetNamespace() const { return Namespace; }
+
+private:
+	UFUNCTION()
+	void UpdateStateMessage(UROS2GenericMsg* InMessage);
+
+	UFUNCTION()
+	void HandleVelocityCommand(const UROS2GenericMsg* InMsg);
+
+	UFUNCTION()
+	void HandleAttitudeCommand(const UROS2GenericMsg* InMsg);
+
+	UFUNCTION()
+	void HandleMotorCommand(const UROS2GenericMsg* InMsg);
+
+	void HandleControlStep(const FDroneStateSample& Sample);
+	UROS2Subscriber* Subscribe(UROS2NodeComponent* Node, const FString& Topic, TSubclassOf<UROS2GenericMsg> MsgClass, FName Callback);
+
+	// Posts to the drone's mailbox, or goes through the command journal while it records or replays
+	template <typename CommandType>
+	void PostCommand(const TCHAR* Name, TCommandMailbox<CommandType>& Mailbox, const CommandType& Command);
+
+	// Applies journaled commands, live or replayed
+	void DispatchCommand(const FExternalCommand& Command);
+
+	UPROPERTY()
+	UROS2Publisher* OdometryPublisher = nullptr;
+
+	UPROPERTY()
+	UROS2Publisher* ImuPublisher = nullptr;
+
+	UPROPERTY()
+	UROS2Publisher* MotorPublisher = nullptr;
+
+	UPROPERTY()
+	TArray<UROS2Subscriber*> Subscribers;
+
+	TWeakObjectPtr<AQuadPawn> Pawn;
+	FString Namespace;
+	FString JournalTarget;
+	int32 OdometryDecimation = 0;
+	int32 ImuDecimation = 0;
+	int32 MotorDecimation = 0;
+
+	// Shared with the drone's controller so callbacks never write into a freed slot
+	TSharedPtr<FDroneCommandMailboxes, ESPMode::ThreadSafe> CommandMailboxes;
+
+	FROS2StatePublisher* StatePublisher = nullptr;
+	int32 StateHandle = INDEX_NONE;
+	FDelegateHandle ControlStepHandle;
+};
+
+/**
+ * Connects every drone the drone manager knows about to ROS2 through one node.
+ *
+ * A node per drone would also mean an executor, a DDS participant and discovery traffic per drone;
+ * here the swarm shares one of each. Each drone gets its state publishers and command subscribers
+ * under its own namespace, created when the drone registers with the manager and torn down when it
+ * leaves, so the rest of the swarm is not touched. State goes out through one publisher thread, which
+ * also publishes /clock.
+ *
+ * The drone manager spawns a bridge when none is placed in the level. AROS2Controller puts its camera,
+ * position and obstacle topics on the same node, so a process runs exactly one.
+ */
+UCLASS()
+class QUADSIMTOREALITY_API AROS2Bridge : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AROS2Bridge();
+
+	virtual void Tick(float DeltaTime) override;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2")
+	FString NodeName = TEXT("quadsim_bridge");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2")
+	FROS2BridgeTopics Topics;
+
+	// Publishes sim time on /clock so ROS nodes can run with use_sim_time
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2")
+	bool bPublishClock = true;
+
+	/** Namespace a drone's topics live under: its DroneID, reduced to characters ROS allows */
+	static FString MakeNamespace(const FString& DroneID);
+
+	/** The bridge's node, once it has begun play; other ROS2 actors put their topics on it too */
+	UROS2NodeComponent* GetNode() const { return HasActorBegunPlay() ? Node : nullptr; }
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	void AddDrone(AQuadPawn* Drone);
+	void RemoveDrone(AQuadPawn* Drone);
+
+	UFUNCTION()
+	void UpdateClockMessage(UROS2GenericMsg* InMessage);
+
+	UPROPERTY()
+	UROS2NodeComponent* Node;
+
+	UPROPERTY()
+	UROS2Publisher* ClockPublisher = nullptr;
+
+	UPROPERTY()
+	TArray<UROS2DroneLink*> Links;
+
+	// Drones whose controller did not exist yet when they registered
+	TArray<TWeakObjectPtr<AQuadPawn>> PendingDrones;
+
+	TWeakObjectPtr<ADroneManager> Manager;
+	FDelegateHandle DroneAddedHandle;
+	FDelegateHandle DroneRemovedHandle;
+
+	TUniquePtr<FROS2StatePublisher> StatePublisher;
+};
@@ -12,9 +12,13 @@
 #include "Msgs/ROS2Str.h"
 #include "Utility/ObstacleManager.h"
 #include "Pawns/QuadPawn.h"
+#include "Utility/SharedFrameRing.h"
 
 #include "ROS2Controller.generated.h"
 
+class AROS2Bridge;
+struct FExternalCommand;
+
 UCLASS()
 class QUADSIMTOREALITY_API AROS2Controller : public AActor
 {
@@ -23,9 +27,11 @@ class QUADSIMTOREALITY_API AROS2Controller : public AActor
 public:
     AROS2Controller();
 
+    // Unused: the topics live on the ROS2 bridge's node. Kept so existing levels still load.
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2")
     FString NodeName = TEXT("quad_controller_node");
 
+    // Prefix for topic names that do not start with '/'
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2")
     FString Namespace = TEXT("quad");
 
@@ -46,6 +52,14 @@ public:
     UPROPERTY(EditAnywhere, Category = "ROS2|Image")
     FVector2D ImageResolution = FVector2D(128, 128);
 
+    // Write frames to a shared memory ring (/dev/shm/quadsim_<name>) and publish only a descriptor on
+    // ImageDescriptorTopicName, for consumers on the same host. The image topic is not published then.
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|Image")
+    bool bSharedMemoryFrames = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ROS2|Image")
+    FString ImageDescriptorTopicName = TEXT("/camera/image_shm");
+
     UPROPERTY(EditAnywhere, Category = "ROS2")
     AQuadPawn* QuadPawn;
 
@@ -64,9 +78,12 @@ protected:
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
+    // Runs on the first tick, once the drone manager has spawned the bridge whose node the topics go on
+    void InitializeROS2();
     void InitializeImageCapture();
     void CaptureImage();
-    void ProcessCapturedImage(const TArray<FColor>& Pixels);
+    void ProcessCapturedImage(const TArray<FColor>& Pixels, double SimTime);
+    void PublishFrameDescriptor(uint64 FrameId);
     void SetupObstacleManager();
 
     UFUNCTION()
@@ -77,23 +94,34 @@ private:
 
     UFUNCTION()
     void HandleObstacleMessage(const UROS2GenericMsg* InMsg);
+
+    // Applies a subscriber command, live or replayed from the command journal
+    void DispatchCommand(const FExternalCommand& Command);
     
-    // ROS2 Components
+    // ROS2 Components. The node is the bridge's; topics created here are destroyed in EndPlay while it lives on.
     UPROPERTY()
-    UROS2NodeComponent* Node;
+    UROS2NodeComponent* Node = nullptr;
+
+    TWeakObjectPtr<AROS2Bridge> Bridge;
 
     UPROPERTY()
-    UROS2Publisher* PositionPublisher;
+    UROS2Publisher* PositionPublisher = nullptr;
 
     UPROPERTY()
-    UROS2Publisher* ImagePublisher;
+    UROS2Publisher* ImagePublisher = nullptr;
+
+    UPROPERTY()
+    UROS2Publisher* ImageDescriptorPublisher = nullptr;
 
     UPROPERTY()
     AObstacleManager* ObstacleManagerInstance;
 
     // Subscriber for obstacle commands
     UPROPERTY()
-    UROS2Subscriber* ObstacleSubscriber;
+    UROS2Subscriber* ObstacleSubscriber = nullptr;
+
+    // Written on the render thread right after readback; bIsProcessingImage keeps it to one frame at a time
+    FSharedFrameRing FrameRing;
 
     FTimerHandle CaptureTimerHandle;
     int32 CurrentRenderTargetIndex = 0;
@@ -0,0 +1,53 @@
+// ROS2Conversions.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Msgs/ROS2Time.h"
+
+/**
+ * Unreal is left-handed (X forward, Y right, Z up, cm); ROS is right-handed ENU / FLU in meters.
+ * Mirroring Y converts positions and directions. Axial vectors (angular velocity) pick up an extra sign,
+ * and quaternions mirror to (-x, y, -z, w). Every mapping here is its own inverse apart from the scale.
+ */
+namespace QuadROS2
+{
+	inline FVector ToROSVector(const FVector& V, double Scale = 0.01)
+	{
+		return FVector(V.X, -V.Y, V.Z) * Scale;
+	}
+
+	inline FVector FromROSVector(const FVector& V, double Scale = 100.0)
+	{
+		return FVector(V.X, -V.Y, V.Z) * Scale;
+	}
+
+	inline FVector ToROSAngular(const FVector& W)
+	{
+		return FVector(-W.X, W.Y, -W.Z);
+	}
+
+	inline FQuat ToROSQuat(const FQuat& Q)
+	{
+		return FQuat(-Q.X, Q.Y, -Q.Z, Q.W);
+	}
+
+	inline FQuat FromROSQuat(const FQuat& Q)
+	{
+		return ToROSQuat(Q);
+	}
+
+	/** Roll, pitch, yaw in radians (ROS convention, applied yaw-pitch-roll) to an Unreal rotator */
+	inline FRotator FromROSEuler(double Roll, double Pitch, double Yaw)
+	{
+		const FQuat Q = FQuat(FVector::UpVector, Yaw) * FQuat(FVector::RightVector, Pitch) * FQuat(FVector::ForwardVector, Roll);
+		return FromROSQuat(Q).Rotator();
+	}
+
+	inline FROSTime ToROSTime(double Seconds)
+	{
+		FROSTime Time;
+		Time.Sec = static_cast<int32>(FMath::FloorToDouble(Seconds));
+		Time.Nanosec = static_cast<uint32>((Seconds - Time.Sec) * 1.0e9);
+		return Time;
+	}
+}
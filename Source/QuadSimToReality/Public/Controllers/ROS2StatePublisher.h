@@ -0,0 +1,87 @@
+// ROS2StatePublisher.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+#include "Core/DroneStateSample.h"
+#include <atomic>
+
+class UROS2Publisher;
+
+/** Publishers one drone's state goes out on. Any of them may be null. */
+struct FROS2DroneStreams
+{
+	UROS2Publisher* Odometry = nullptr;  // nav_msgs/Odometry
+	UROS2Publisher* Imu = nullptr;       // sensor_msgs/Imu
+	UROS2Publisher* Motors = nullptr;    // std_msgs/Float32MultiArray, mixer thrust per motor
+
+	FString OdomFrameId;
+	FString BaseFrameId;
+};
+
+/**
+ * Publishes drone state to ROS2 from a worker thread, so high control rates do not cost the game thread
+ * more than a queue push per step.
+ *
+ * Samples are converted to ROS conventions (ENU, meters, FLU body frame) and stamped with sim time on the
+ * worker. A /clock message goes out whenever a sample advances the sim time. The owner keeps the
+ * publishers alive (UPROPERTY) for as long as they are registered here; rcl publishers are safe to use
+ * from another thread, and only the worker touches their messages.
+ */
+class QUADSIMTOREALITY_API FROS2StatePublisher : public FRunnable
+{
+public:
+	enum EStream : uint8
+	{
+		Odometry = 1 << 0,
+		Imu      = 1 << 1,
+		Motors   = 1 << 2,
+	};
+
+	explicit FROS2StatePublisher(UROS2Publisher* InClockPublisher);
+	virtual ~FROS2StatePublisher() override;
+
+	/** Returns the handle samples for this drone are queued under */
+	int32 RegisterDrone(const FROS2DroneStreams& Streams);
+	void UnregisterDrone(int32 Handle);
+
+	/** Game thread. Drops the sample (and returns false) when the worker has fallen too far behind. */
+	bool Enqueue(int32 Handle, const FDroneStateSample& Sample, uint8 StreamMask);
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	// Bound on queued samples; past this the worker is not keeping up and new samples are dropped
+	static constexpr int32 MaxPendingSamples = 4096;
+
+	struct FPendingSample
+	{
+		int32 Handle;
+		uint8 StreamMask;
+		FDroneStateSample Sample;
+	};
+
+	void Drain();
+	void Publish(const FROS2DroneStreams& Streams, const FDroneStateSample& Sample, uint8 StreamMask);
+	void PublishClock(double SimTime);
+
+	TQueue<FPendingSample, EQueueMode::Spsc> Pending;
+	std::atomic<int32> NumPending{ 0 };
+	std::atomic<bool> bStopping{ false };
+
+	// Registration is rare; the worker holds the lock while it drains a batch, so once UnregisterDrone
+	// returns the drone's publishers are no longer in use. Handles are never reused.
+	FCriticalSection StreamsLock;
+	TMap<int32, FROS2DroneStreams> Streams;
+	int32 NextHandle = 0;
+
+	UROS2Publisher* ClockPublisher;
+	double LastClockTime = -1.0;
+	uint64 NumDropped = 0;
+
+	FEvent* WakeEvent = nullptr;
+	FRunnableThread* Thread = nullptr;
+};
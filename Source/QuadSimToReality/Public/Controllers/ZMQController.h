@@ -4,7 +4,11 @@
 #include <zmq_addon.hpp>
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Utility/SharedFrameRing.h"
+#include "Core/DroneStateSample.h"
+#include "Controllers/ZMQStepServer.h"
 class SZMQImageWidget;
+struct FExternalCommand;
 
 #include "ZMQController.generated.h"
 // Forward declarations
@@ -13,6 +17,14 @@ class UQuadDroneController;
 class USceneCaptureComponent2D;
 class UTextureRenderTarget2D;
 
+UENUM(BlueprintType)
+enum class EZMQTransport : uint8
+{
+    Tcp,     // tcp://*:<port>, reachable from other hosts
+    Ipc,     // ipc://<IpcDirectory>/quadsim_<port>, Unix domain sockets on this host
+    Inproc   // inproc://quadsim_<port>, consumers inside this process only
+};
+
 USTRUCT(BlueprintType)
 struct FZMQConfiguration
 {
@@ -27,12 +39,61 @@ struct FZMQConfiguration
     UPROPERTY(EditAnywhere, Category = "ZMQ")
     int32 ControlPort = 5558;
 
+    // Request/reply step endpoint (ROUTER); see ZMQStepProtocol.h
+    UPROPERTY(EditAnywhere, Category = "ZMQ")
+    bool bEnableStepRpc = true;
+
+    UPROPERTY(EditAnywhere, Category = "ZMQ")
+    int32 RpcPort = 5559;
+
+    // Ports still name the endpoints with IPC and inproc, so clients only switch the scheme
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Transport")
+    EZMQTransport Transport = EZMQTransport::Tcp;
+
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Transport")
+    FString IpcDirectory = TEXT("/tmp");
+
+    // Messages a socket queues per peer before it drops (PUB) or stops reading (SUB); 0 is unlimited
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Sockets", meta = (ClampMin = "0"))
+    int32 ImageSendHighWaterMark = 2;
+
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Sockets", meta = (ClampMin = "0"))
+    int32 StateSendHighWaterMark = 1000;
+
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Sockets", meta = (ClampMin = "0"))
+    int32 CommandReceiveHighWaterMark = 1000;
+
+    // Keep only the newest state message per subscriber instead of a queue
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Sockets")
+    bool bConflateState = true;
+
+    // Only queue messages for peers that have completed their connection
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Sockets")
+    bool bImmediate = true;
+
+    // How long unsent messages may hold up shutdown
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Sockets")
+    int32 LingerMs = 0;
+
+    // I/O threads of the context all ZMQ controllers share; read when the first one initializes
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Sockets", meta = (ClampMin = "1"))
+    int32 IOThreads = 1;
+
+    // Commands applied per tick at most; the rest wait for the next tick
+    UPROPERTY(EditAnywhere, Category = "ZMQ|Sockets", meta = (ClampMin = "1"))
+    int32 MaxCommandsPerTick = 256;
+
     UPROPERTY(EditAnywhere, Category = "Image Capture")
     FIntPoint ImageResolution = FIntPoint(128, 128);
 
     UPROPERTY(EditAnywhere, Category = "Image Capture")
     float CaptureInterval = 0.1f;  // e.g., 0.1 sec ~ 10 FPS
 
+    // Write frames to a shared memory ring (/dev/shm/quadsim_<DroneID>) and publish only a descriptor,
+    // for consumers on the same host. Falls back to PNG where shared memory is unavailable.
+    UPROPERTY(EditAnywhere, Category = "Image Capture")
+    bool bSharedMemoryFrames = false;
+
     UPROPERTY(EditAnywhere, Category = "Communication")
     FString DroneID = TEXT("drone1");
 };
@@ -66,6 +127,11 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="ZMQ")
     AQuadPawn* TargetPawn;
 
+    // Endpoint for a port under the configured transport; binds use the wildcard host for TCP
+    static FString MakeEndpoint(const FZMQConfiguration& Config, int32 Port, bool bBind);
+    static void ConfigureSocket(const FZMQConfiguration& Config, zmq::socket_t& Socket, int32 SendHighWaterMark, int32 ReceiveHighWaterMark);
+    static zmq::context_t& GetSharedContext(int32 IOThreads);
+
 protected:
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -76,17 +142,25 @@ private:
     void ProcessImageCapture();
     void InitializeZMQ();
     void HandleResetCommand();
-    void HandleVelocityCommand(zmq::multipart_t& Message);
+    void HandleRandomizedResetCommand(const TArray<uint8>& Data);
+    void HandleVelocityCommand(const TArray<uint8>& Data);
     void SendStateData();
     void ProcessCommands();
+    // Applies a command from the socket or from a replayed journal
+    void DispatchCommand(const FExternalCommand& Command);
     void CheckAndInitialize();
     TArray<uint8> CompressImageData(const TArray<FColor>& ImageData);
 
+    // Step endpoint, serving this drone as environment 0
+    void HandleControlStep(const FDroneStateSample& Sample);
+    FZMQStepTarget MakeStepTarget();
+    FZMQStepState MakeStepState() const;
+
     // ZMQ and image capture members
-    zmq::context_t Context;
     TSharedPtr<zmq::socket_t> PublishSocket;
     TSharedPtr<zmq::socket_t> CommandSocket;
     TSharedPtr<zmq::socket_t> ControlSocket;
+    FZMQStepServer StepServer;
 
     UPROPERTY(EditAnywhere, Category = "ZMQ")
     FZMQConfiguration Configuration;
@@ -110,4 +184,14 @@ private:
 
     FVector CurrentGoalPosition;
 
+    // Only written by the image task, which bIsCapturing keeps to one at a time
+    FSharedFrameRing FrameRing;
+
+    FDroneStateSample LastStepSample;
+    bool bHasStepSample = false;
+    FDelegateHandle ControlStepHandle;
+
+    // DroneID this controller is registered under with the command journal
+    FString RegisteredCommandTarget;
+
 };
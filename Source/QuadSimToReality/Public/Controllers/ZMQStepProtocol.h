@@ -0,0 +1,91 @@
+// ZMQStepProtocol.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Binary framing of the request/reply step endpoint (FZMQStepServer, RpcPort). Everything is
+ * little-endian and packed as declared. quadsim_rpc.py in the project root mirrors these structs;
+ * keep the two in sync and bump Version on any change.
+ *
+ * Clients connect a DEALER socket and may keep any number of requests in flight. Every message is a
+ * single frame: a header followed by the op's payload. Replies echo RequestId; STEP and RESET replies
+ * arrive in request order, GET_IMAGE is answered as soon as it is read.
+ *
+ * EnvIndex picks the environment on servers that host several (ASimEnvironmentManager); a ZMQ
+ * controller serves its drone as environment 0. Each environment keeps its own request order.
+ *
+ * Positions depend on the server. A ZMQ controller reports Position and Goal in world coordinates;
+ * ASimEnvironmentManager reports them relative to the environment's origin, so every environment
+ * looks the same. Directions (velocities, orientation) are world-aligned on both.
+ *
+ *   STEP       request: FZMQStepAction     reply: FZMQStepState
+ *   RESET      request: UTF-8 FResetSpec JSON (empty for a plain reset)   reply: FZMQStepState
+ *   GET_IMAGE  request: -                  reply: FZMQStepImage + Width * Height BGRA8 pixels
+ */
+namespace ZMQStep
+{
+	static constexpr uint16 Version = 2;
+
+	enum class EOp : uint8
+	{
+		Step = 1,
+		Reset = 2,
+		GetImage = 3,
+	};
+
+	enum class EStatus : uint8
+	{
+		Ok = 0,
+		BadRequest = 1,
+		NoImage = 2,
+		Cancelled = 3,   // The controller shut down before the request completed
+	};
+}
+
+struct FZMQStepRequestHeader
+{
+	uint32 RequestId;
+	uint8 Op;                // ZMQStep::EOp
+	uint8 EnvIndex;          // Environment the request addresses; unknown ones get BadRequest
+	uint16 SubSteps;         // STEP/RESET: control steps to run before replying (0 replies with the current state)
+};
+static_assert(sizeof(FZMQStepRequestHeader) == 8, "FZMQStepRequestHeader layout changed; update quadsim_rpc.py and Version");
+
+struct FZMQStepReplyHeader
+{
+	uint32 RequestId;
+	uint8 Op;
+	uint8 Status;            // ZMQStep::EStatus
+	uint16 Version;
+};
+static_assert(sizeof(FZMQStepReplyHeader) == 8, "FZMQStepReplyHeader layout changed; update quadsim_rpc.py and Version");
+
+struct FZMQStepAction
+{
+	float Velocity[3];       // cm/s, world; same as the VELOCITY command
+};
+static_assert(sizeof(FZMQStepAction) == 12, "FZMQStepAction layout changed; update quadsim_rpc.py and Version");
+
+// Unreal units and axes, like the text state on ControlPort. "Server frame" is world on a ZMQ
+// controller and the environment's origin on ASimEnvironmentManager (see above).
+struct FZMQStepState
+{
+	uint64 Step;             // Per-drone control step index
+	double SimTime;          // World time in seconds
+	float Position[3];       // cm, server frame
+	float Velocity[3];       // cm/s, world axes
+	float Orientation[4];    // Body to world quaternion, x y z w
+	float AngularVelocity[3]; // rad/s, world axes
+	float Goal[3];           // cm, server frame
+};
+static_assert(sizeof(FZMQStepState) == 80, "FZMQStepState layout changed; update quadsim_rpc.py and Version");
+
+struct FZMQStepImage
+{
+	uint64 FrameId;          // Counts captures from 1
+	double SimTime;
+	uint32 Width;
+	uint32 Height;
+};
+static_assert(sizeof(FZMQStepImage) == 24, "FZMQStepImage layout changed; update quadsim_rpc.py and Version");
@@ -0,0 +1,94 @@
+// ZMQStepServer.h
+#pragma once
+
+#include <zmq.hpp>
+#include <zmq_addon.hpp>
+#include "CoreMinimal.h"
+#include "Controllers/ZMQStepProtocol.h"
+
+struct FZMQConfiguration;
+
+/** One environment the step server can address */
+struct FZMQStepTarget
+{
+	// Journal target that STEP and RESET actions are submitted to, as VELOCITY / RESET / RESET_RANDOMIZED
+	FString CommandTarget;
+
+	// State reported in STEP and RESET replies
+	TFunction<FZMQStepState()> GetState;
+
+	// Whether control steps are coming; without them requests reply as soon as their action is applied
+	TFunction<bool()> HasControlSteps;
+};
+
+/**
+ * The request/reply step endpoint (ZMQStepProtocol.h) on one ROUTER socket. Requests carry the index
+ * of the environment they address; each environment runs its STEP and RESET requests in arrival
+ * order, independently of the others. AZMQController serves its one drone as environment 0,
+ * ASimEnvironmentManager serves all of its environments on a single port.
+ *
+ * Game thread only, except PublishImage.
+ */
+class QUADSIMTOREALITY_API FZMQStepServer
+{
+public:
+	~FZMQStepServer();
+
+	/** Binds Config.RpcPort under Config's transport and socket options */
+	bool Bind(const FZMQConfiguration& Config);
+
+	/** Cancels every pending request and closes the socket */
+	void Close();
+
+	bool IsBound() const { return Socket.IsValid(); }
+
+	void SetTarget(uint8 EnvIndex, FZMQStepTarget Target);
+	void RemoveTarget(uint8 EnvIndex);
+
+	/** Reads up to MaxRequests requests, then starts whatever the environments can run */
+	void Poll(int32 MaxRequests);
+
+	/** Call from the environment's OnControlStep; completes requests whose control steps have run */
+	void OnControlStep(uint8 EnvIndex);
+
+	/** Hands over the newest camera frame for GET_IMAGE. Safe from any thread. */
+	void PublishImage(uint8 EnvIndex, TArray<FColor>&& Pixels, uint32 Width, uint32 Height, double SimTime);
+
+private:
+	struct FPendingStep
+	{
+		TArray<uint8> Client;
+		FZMQStepRequestHeader Header;
+		TArray<uint8> Payload;
+		int32 Remaining = 0;
+		// Journal step the action is dispatched on; control steps count down from there
+		uint64 DispatchStep = 0;
+		bool bStarted = false;
+	};
+
+	struct FEnvironment
+	{
+		FZMQStepTarget Target;
+		TArray<FPendingStep> Pending;
+	};
+
+	struct FLatestImage
+	{
+		TArray<FColor> Pixels;
+		FZMQStepImage Info = {};
+	};
+
+	void RejectMalformed(const zmq::multipart_t& Message);
+	void HandleRequest(FPendingStep&& Request);
+	void Advance(FEnvironment& Environment);
+	void CancelPending(FEnvironment& Environment);
+	void SendReply(const TArray<uint8>& Client, const FZMQStepRequestHeader& Request, ZMQStep::EStatus Status,
+		const void* Payload = nullptr, int64 PayloadSize = 0, const void* Extra = nullptr, int64 ExtraSize = 0);
+
+	TSharedPtr<zmq::socket_t> Socket;
+	TMap<uint8, FEnvironment> Environments;
+
+	// Written by image tasks, read by Poll
+	FCriticalSection ImageLock;
+	TMap<uint8, FLatestImage> LatestImages;
+};
@@ -0,0 +1,121 @@
+// CommandJournal.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/World.h"
+
+/** A command from an external client (ZMQ, ROS2), addressed to a registered target by name */
+struct FExternalCommand
+{
+	FString Target;
+	FString Name;
+	TArray<uint8> Data;
+};
+
+DECLARE_DELEGATE_OneParam(FOnExternalCommand, const FExternalCommand& /*Command*/);
+
+/**
+ * Routes every inbound external command so that runs driven by Python or ROS2 can be reproduced.
+ *
+ *   -RecordCommands[=File]   Journal every command with the sim step it takes effect on, plus a hash
+ *                            of all drone states after each step. Defaults to Saved/CommandLogs.
+ *   -ReplayCommands=File     Ignore live input, re-inject the journaled commands at the same steps
+ *                            and compare the per-step state hashes against the recording.
+ *   -FixedStepHz=N           Step rate for both modes (default 60).
+ *   -ReplayStopOnDivergence  Exit at the first step whose state hash differs.
+ *   -ReplayExitWhenDone      Exit once the journal has been fully replayed.
+ *
+ * Both modes run on a fixed dt. Recording is paced to real time; replay runs as fast as the machine
+ * allows, which is what makes bisecting a long RL run practical. In both modes a command is applied
+ * at the start of the step after it was received, so it lands at the same point relative to actor
+ * ticks whether it came from a socket or from the journal.
+ */
+class QUADSIMTOREALITY_API FCommandJournal
+{
+public:
+	enum class EMode : uint8
+	{
+		Off,
+		Record,
+		Replay
+	};
+
+	static FCommandJournal& Get();
+
+	void RegisterTarget(const FString& Target, FOnExternalCommand Handler);
+	void UnregisterTarget(const FString& Target);
+
+	/** Entry point for all external commands. Dispatches immediately when the journal is off. */
+	void Submit(FExternalCommand&& Command);
+
+	EMode GetMode() const { return Mode; }
+	bool IsReplaying() const { return Mode == EMode::Replay; }
+
+	/** Index of the current sim step in the journaled world, starting at 1 on its first tick */
+	uint64 GetStep() const { return Step; }
+
+	/** Step on which a command submitted now is dispatched, or 0 when Submit dispatches it right away */
+	uint64 GetDispatchStep() const { return Mode == EMode::Record && SessionWorld.IsValid() ? Step + 1 : 0; }
+
+private:
+	enum class EEntryType : uint8
+	{
+		Command = 1,
+		StateHash = 2
+	};
+
+	struct FReplayCommand
+	{
+		uint64 Step;
+		FExternalCommand Command;
+	};
+
+	FCommandJournal();
+	~FCommandJournal();
+
+	FCommandJournal(const FCommandJournal&) = delete;
+	FCommandJournal& operator=(const FCommandJournal&) = delete;
+
+	void ConfigureTimeStep();
+	bool BeginSession(UWorld* World);
+	void EndSession();
+	bool LoadReplay(const FString& Path);
+
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	void Dispatch(const FExternalCommand& Command);
+	void WriteCommand(uint64 CommandStep, FExternalCommand& Command);
+	void WriteStateHash(uint32 Hash);
+	void CompareStateHash(uint32 Hash);
+	void FinishReplay();
+
+	static uint32 ComputeStateHash(UWorld* World);
+
+	EMode Mode = EMode::Off;
+	float FixedDeltaTime = 1.f / 60.f;
+	int32 RandomSeed = 0;
+
+	TMap<FString, FOnExternalCommand> Targets;
+
+	TWeakObjectPtr<UWorld> SessionWorld;
+	uint64 Step = 0;
+
+	// Recording
+	FString JournalPath;
+	TUniquePtr<FArchive> Writer;
+	TArray<FExternalCommand> PendingCommands;
+
+	// Replay
+	TArray<FReplayCommand> ReplayCommands;
+	int32 ReplayCursor = 0;
+	TArray<TPair<uint64, uint32>> RecordedHashes;
+	int32 HashCursor = 0;
+	uint64 StepsCompared = 0;
+	uint64 StepsDiverged = 0;
+	uint64 FirstDivergentStep = 0;
+	bool bReplayFinished = false;
+};
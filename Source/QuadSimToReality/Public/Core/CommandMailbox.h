@@ -0,0 +1,100 @@
+// CommandMailbox.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+#include <type_traits>
+
+/**
+ * Single-slot, latest-value mailbox for commands arriving on another thread.
+ *
+ * Writers overwrite the slot in O(1); a burst of commands between two reads collapses into the newest
+ * one instead of queueing. The slot is guarded by a sequence number (a seqlock): it is odd while a write
+ * is in progress and advances by two per completed write, so the reader can tell a new command from one
+ * it has already consumed and retries if it raced a writer. Any number of writers may post; there must
+ * be a single reader.
+ */
+template <typename T>
+class TCommandMailbox
+{
+	static_assert(std::is_trivially_copyable_v<T>, "Mailbox payloads are copied bytewise and must be trivially copyable");
+
+public:
+	/** Any thread */
+	void Post(const T& Value)
+	{
+		uint64 Sequence = WriteSequence.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			// Another writer holds the slot; it only does a memcpy, so spinning is short
+			if ((Sequence & 1) == 0 && WriteSequence.compare_exchange_weak(Sequence, Sequence + 1, std::memory_order_acquire))
+			{
+				break;
+			}
+			FPlatformProcess::Yield();
+			Sequence = WriteSequence.load(std::memory_order_relaxed);
+		}
+
+		std::atomic_thread_fence(std::memory_order_release);
+		FMemory::Memcpy(&Slot, &Value, sizeof(T));
+		WriteSequence.store(Sequence + 2, std::memory_order_release);
+	}
+
+	/** Reader thread. Copies the newest command if one was posted since the last successful call. */
+	bool ConsumeLatest(T& OutValue)
+	{
+		for (;;)
+		{
+			const uint64 Before = WriteSequence.load(std::memory_order_acquire);
+			if (Before == ReadSequence)
+			{
+				return false;
+			}
+			if (Before & 1)
+			{
+				FPlatformProcess::Yield();
+				continue;
+			}
+
+			FMemory::Memcpy(&OutValue, &Slot, sizeof(T));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (WriteSequence.load(std::memory_order_relaxed) == Before)
+			{
+				ReadSequence = Before;
+				return true;
+			}
+		}
+	}
+
+	/** Number of commands posted so far, including ones that were overwritten before being read */
+	uint64 GetNumPosted() const { return WriteSequence.load(std::memory_order_relaxed) / 2; }
+
+private:
+	std::atomic<uint64> WriteSequence{ 0 };
+	uint64 ReadSequence = 0;
+	T Slot{};
+};
+
+/** Mailboxes external clients (ROS2 subscribers) use to command one drone. The controller reads them once per control step. */
+struct FDroneCommandMailboxes
+{
+	struct FVelocity
+	{
+		FVector Velocity;       // cm/s, world
+	};
+
+	struct FAttitude
+	{
+		FRotator Attitude;      // Degrees, world
+		float Thrust;           // Collective thrust, 1 = hover
+	};
+
+	struct FMotors
+	{
+		float Thrusts[4];       // Same units as UQuadDroneController::Thrusts
+	};
+
+	TCommandMailbox<FVelocity> Velocity;
+	TCommandMailbox<FAttitude> Attitude;
+	TCommandMailbox<FMotors> Motors;
+};
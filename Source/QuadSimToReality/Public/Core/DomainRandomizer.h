@@ -0,0 +1,97 @@
+// DomainRandomizer.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/RandomStream.h"
+
+class FJsonObject;
+
+/** Closed interval a parameter is drawn from uniformly. Min == Max pins the value. */
+struct FRandomRange
+{
+	float Min = 0.f;
+	float Max = 0.f;
+
+	FRandomRange() = default;
+	FRandomRange(float InValue) : Min(InValue), Max(InValue) {}
+	FRandomRange(float InMin, float InMax) : Min(InMin), Max(InMax) {}
+
+	float Sample(FRandomStream& Stream) const { return Min == Max ? Min : Stream.FRandRange(Min, Max); }
+};
+
+/**
+ * Randomization spec carried by a RESET_RANDOMIZED request. Every field has a neutral default, so a
+ * spec of {} is a plain reset to the origin.
+ *
+ *   {
+ *     "seed": 42,
+ *     "spawn": { "x": [-500, 500], "y": [-500, 500], "z": 10, "yaw": [-180, 180], "tilt": [0, 5] },
+ *     "mass_scale": [0.9, 1.1], "inertia_scale": [0.9, 1.1], "motor_constant_scale": [0.95, 1.05],
+ *     "wind": { "acceleration": [0, 150], "gust_stddev": 20 },
+ *     "sensor_noise": { "position": 2.0, "velocity": 1.0 },
+ *     "obstacles": 5
+ *   }
+ */
+struct FResetSpec
+{
+	int32 Seed = 0;
+
+	// Spawn pose, cm and degrees. Tilt is the magnitude of a random roll/pitch offset.
+	FRandomRange SpawnX;
+	FRandomRange SpawnY;
+	FRandomRange SpawnZ = FRandomRange(10.f);
+	FRandomRange SpawnYaw;
+	FRandomRange SpawnTilt;
+
+	// Multipliers on the airframe's nominal values
+	FRandomRange MassScale = FRandomRange(1.f);
+	FRandomRange InertiaScale = FRandomRange(1.f);
+	FRandomRange MotorConstantScale = FRandomRange(1.f);
+
+	// Horizontal wind as a constant acceleration in a random direction, cm/s^2, plus per-step gusts
+	FRandomRange WindAcceleration;
+	float WindGustStdDev = 0.f;
+
+	// Standard deviation of the noise added to reported state, cm and cm/s
+	float PositionNoiseStdDev = 0.f;
+	float VelocityNoiseStdDev = 0.f;
+
+	// Obstacle layout seeded from Seed; negative leaves the current layout alone
+	int32 ObstacleCount = -1;
+
+	static bool FromJson(const FString& Json, FResetSpec& OutSpec);
+	static FResetSpec FromJsonObject(const FJsonObject& Object);
+};
+
+/** Everything drawn for one drone in one reset */
+struct FDroneRandomization
+{
+	FVector SpawnLocation = FVector::ZeroVector;
+	FRotator SpawnRotation = FRotator::ZeroRotator;
+	float MassScale = 1.f;
+	float InertiaScale = 1.f;
+	float MotorConstantScale = 1.f;
+	FVector WindAcceleration = FVector::ZeroVector;
+	float WindGustStdDev = 0.f;
+	float PositionNoiseStdDev = 0.f;
+	float VelocityNoiseStdDev = 0.f;
+
+	// Gusts and sensor noise draw from separate streams, so changing one leaves the other's sequence alone
+	int32 GustSeed = 0;
+	int32 NoiseSeed = 0;
+};
+
+/**
+ * Draws per-drone randomizations for a reset. Each drone index draws from a stream seeded from the
+ * spec seed and the index. A drone therefore gets the same draw for the same seed however many
+ * other drones reset with it.
+ */
+class QUADSIMTOREALITY_API FDomainRandomizer
+{
+public:
+	/** Draws drone DroneIndex's randomization for this spec */
+	static void SampleDrone(const FResetSpec& Spec, int32 DroneIndex, FDroneRandomization& OutDrone);
+
+	/** Standard normal deviate (Box-Muller) */
+	static float Gaussian(FRandomStream& Stream);
+};
@@ -2,6 +2,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Core/GainSchedule.h"
+#include <atomic>
 #include "DroneJSONConfig.generated.h"
 
 USTRUCT()
@@ -9,29 +12,73 @@ struct FDroneConfigData
 {
 	GENERATED_BODY()
 
+	// Bumped every time a new snapshot is published
+	uint32 Version = 0;
+
 	struct FFlightParameters {
-		float MaxVelocity;
-		float MaxAngle;
-		float MaxPIDOutput;
-		float AltitudeThreshold;
-		float MinAltitudeLocal;
-		float AcceptableDistance;
+		float MaxVelocity = 130.f;
+		float MaxAngle = 15.f;
+		float MaxPIDOutput = 350.f;
+		float AltitudeThreshold = 0.6f;
+		float MinAltitudeLocal = 500.f;
+		float AcceptableDistance = 200.f;
 	} FlightParams;
 
+	// Flight parameters and PID gains for one airframe, fully resolved at load time
+	struct FAirframeProfile
+	{
+		FName Name;
+		FFlightParameters FlightParams;
+		FPIDGains Gains[static_cast<int32>(EPIDAxis::Count)];
+		FGainScheduleTable Schedules[static_cast<int32>(EPIDAxis::Count)];
+		float NominalBatteryVoltage = 16.8f;
+
+		bool HasSchedules() const;
+	};
+
+	// Named airframes from "airframes"; DefaultAirframeName is always present
+	TMap<FName, FAirframeProfile> Airframes;
+
+	// Airframe plus per-drone overrides from "drones", keyed by DroneID
+	TMap<FString, FAirframeProfile> DroneProfiles;
+
+	static const FName DefaultAirframeName;
+
+	FDroneConfigData();
+
+	/** Profile for a drone, falling back to the default airframe when it has no entry */
+	const FAirframeProfile& GetProfile(const FString& DroneID) const;
+
 	struct FControllerParameters {
-		float AltitudeRate;
-		float YawRate;
-		float MinVelocityForYaw;
+		float AltitudeRate = 400.f;
+		float YawRate = 90.f;
+		float MinVelocityForYaw = 10.f;
 	} ControllerParams;
 
 	struct FObstacleParameters
 	{
-		float InnerBoundarySize;
-		float OuterBoundarySize;
-		float SpawnHeight;
+		float InnerBoundarySize = 10000.f;
+		float OuterBoundarySize = 12000.f;
+		float SpawnHeight = 0.f;
 	} ObstacleParams;
+
+	struct FFlightRecorderParameters
+	{
+		bool bEnabled = false;
+		// Relative paths are resolved against the project's Saved directory
+		FString Directory = TEXT("FlightLogs");
+	} FlightRecorderParams;
+
+	struct FHotReloadParameters
+	{
+		bool bEnabled = true;
+		float PollInterval = 1.0f;
+	} HotReloadParams;
 };
 
+// Fired on the game thread after a new snapshot has been published
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDroneConfigChanged, const FDroneConfigData& /*NewConfig*/);
+
 UCLASS()
 class QUADSIMTOREALITY_API UDroneJSONConfig : public UObject
 {
@@ -39,14 +86,48 @@ class QUADSIMTOREALITY_API UDroneJSONConfig : public UObject
 
 public:
 	UDroneJSONConfig();
-    
+
 	static UDroneJSONConfig& Get();
+
+	/**
+	 * Config for a constructor to start from. Class defaults and archetypes get the built-in defaults,
+	 * so loading classes at startup never reads or watches the file; live objects get GetConfig().
+	 */
+	static const FDroneConfigData& GetConfigFor(const UObject& Object);
+
 	bool LoadConfig();
 	bool ReloadConfig();
 
-	FDroneConfigData Config;
+	/**
+	 * Returns the current immutable snapshot. This is a single atomic pointer load with no locking,
+	 * so it is safe to call from any thread. Snapshots are never freed while the config object lives,
+	 * so a reference obtained here stays valid across reloads (it just may be stale).
+	 */
+	const FDroneConfigData& GetConfig() const { return *CurrentConfig.load(std::memory_order_acquire); }
+	uint32 GetVersion() const { return GetConfig().Version; }
+
+	/** Subscribers re-derive their cached parameters from the new snapshot here */
+	FOnDroneConfigChanged& OnConfigChanged() { return ConfigChanged; }
+
+	virtual void BeginDestroy() override;
 
 private:
 	static UDroneJSONConfig* Instance;
 	FString GetConfigFilePath() const;
-};
\ No newline at end of file
+
+	void StartFileWatcher();
+	void StopFileWatcher();
+	bool PollConfigFile(float DeltaTime);
+
+	// Published snapshot; points into Snapshots
+	std::atomic<const FDroneConfigData*> CurrentConfig;
+
+	// Every snapshot ever published. Reloads are rare and a snapshot is a few dozen bytes, so old
+	// versions are retired here instead of freed to keep readers lock-free.
+	TArray<TUniquePtr<FDroneConfigData>> Snapshots;
+
+	FOnDroneConfigChanged ConfigChanged;
+
+	FDateTime LastFileTimestamp;
+	FTSTicker::FDelegateHandle FileWatcherHandle;
+};
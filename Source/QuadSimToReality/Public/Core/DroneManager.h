@@ -2,10 +2,15 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Core/DomainRandomizer.h"
 #include "DroneManager.generated.h"
 
 class AQuadPawn;
+class AROS2Bridge;
 class AROS2Controller;
+class UCameraMosaicComponent;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDroneRegistered, AQuadPawn*);
 
 UCLASS()
 class QUADSIMTOREALITY_API ADroneManager : public AActor
@@ -24,6 +29,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Drone Manager")
 	TArray<AQuadPawn*> GetDroneList() const;
 
+	/** Fired when a drone joins the manager's list, and when it leaves play */
+	FOnDroneRegistered& OnDroneAdded() { return DroneAddedEvent; }
+	FOnDroneRegistered& OnDroneRemoved() { return DroneRemovedEvent; }
+
 	// Function for ROS2Controllers to register themselves.
 	UFUNCTION(BlueprintCallable, Category = "Drone Manager")
 	void RegisterROS2Controller(AROS2Controller* Controller);
@@ -31,6 +40,16 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = "Drone Manager")
 	int32 SelectedDroneIndex;
 
+	/**
+	 * Resets one drone with the draw it would get in a reset of the whole swarm (its stream follows its
+	 * place in DroneID order). The shared obstacle layout is only rebuilt when the spec asks for another one,
+	 * so the controllers of all drones resetting for the same episode rebuild it once.
+	 */
+	void ResetDrone(AQuadPawn* Drone, const FResetSpec& Spec);
+
+	/** Spawns a drone beside the selected one, as the HUD's Spawn Drone button does */
+	void SpawnDroneNextToSelected();
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -45,11 +64,42 @@ protected:
 	UPROPERTY(VisibleAnywhere, Category = "Drone Manager")
 	TArray<TWeakObjectPtr<AQuadPawn>> AllDrones;
 
+	// Camera thumbnails of every drone, opened from the manager window
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Drone Manager")
+	UCameraMosaicComponent* CameraMosaic;
+
+	// Frame phase timings; the profiler only measures while this window is open
+	UPROPERTY(EditAnywhere, Category = "Drone Manager")
+	bool bShowPerfHud = false;
+
+	// Spawns a ROS2 bridge for the drones when the level does not place one and the run profile has ROS2
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone Manager")
+	bool bSpawnROS2Bridge = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Drone Manager")
+	TSubclassOf<AROS2Bridge> ROS2BridgeClass;
+
 	// Array to keep track of all spawned ROS2Controllers.
 	UPROPERTY(VisibleAnywhere, Category = "Drone Manager")
 	TArray<TWeakObjectPtr<AROS2Controller>> AllROS2Controllers;
 
 	void OnActorSpawned(AActor* SpawnedActor);
 
+	void AddDrone(AQuadPawn* Pawn);
+
+	UFUNCTION()
+	void OnDroneEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+
+	void PossessSelectedDrone();
+
+	// Copies drone state into the async HUD's triple buffer (only used with -ImGuiAsyncFrames)
+	void PublishHudSnapshot();
+
 	FDelegateHandle OnActorSpawnedHandle;
+	FOnDroneRegistered DroneAddedEvent;
+	FOnDroneRegistered DroneRemovedEvent;
+
+	// Obstacle layout the last randomized reset built
+	int32 LastObstacleSeed = 0;
+	int32 LastObstacleCount = -1;
 };
\ No newline at end of file
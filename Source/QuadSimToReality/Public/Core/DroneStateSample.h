@@ -0,0 +1,19 @@
+// DroneStateSample.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Full state of one drone at the end of a control step, in Unreal units and frames */
+struct FDroneStateSample
+{
+	uint64 Step = 0;                                    // Per-drone control step index
+	double SimTime = 0.0;                               // World time in seconds
+	FVector Position = FVector::ZeroVector;             // cm, world
+	FVector Velocity = FVector::ZeroVector;             // cm/s, world
+	FQuat Orientation = FQuat::Identity;                // Body to world
+	FVector AngularVelocity = FVector::ZeroVector;      // rad/s, world
+	FVector SpecificForce = FVector::ZeroVector;        // cm/s^2, world; what an accelerometer reads (+g up at rest)
+	float Thrusts[4] = {};
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnDroneControlStep, const FDroneStateSample&);
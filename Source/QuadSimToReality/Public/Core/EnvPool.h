@@ -0,0 +1,61 @@
+// EnvPool.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/World.h"
+
+/**
+ * This process's slot in a pool of simulator instances started side by side (env_pool.py). Every
+ * instance is given its own index on the command line and derives everything that would otherwise
+ * collide from it:
+ *
+ *   -EnvIndex=N          Index of this instance. ZMQ ports move up by N * stride, which also moves
+ *                        the IPC socket paths; shared memory rings and log files get an env<N>_
+ *                        prefix.
+ *   -EnvPortStride=S     Port distance between instances (default 100).
+ *   -ReadyFile=Path      Readiness handshake. Written once the world is ticking and a full tick has
+ *                        passed without a new endpoint being bound, as JSON with the instance's
+ *                        endpoints, run profile and startup milestones (Core/RunProfile.h).
+ *                        Defaults to Saved/EnvPool/env_<N>.json for pooled instances.
+ *
+ * Without -EnvIndex nothing changes, so a single instance keeps the configured ports and names.
+ */
+class QUADSIMTOREALITY_API FEnvPool
+{
+public:
+	static FEnvPool& Get();
+
+	bool IsPooled() const { return EnvIndex >= 0; }
+	int32 GetEnvIndex() const { return EnvIndex; }
+
+	/** A configured port moved into this instance's range */
+	int32 OffsetPort(int32 Port) const { return IsPooled() ? Port + EnvIndex * PortStride : Port; }
+
+	/** Name of a host-wide resource (shared memory, log file) made unique to this instance */
+	FString QualifyName(const FString& Name) const;
+
+	/** Records an endpoint for the readiness file, e.g. ("drone1", "rpc", "tcp://localhost:5559") */
+	void ReportEndpoint(const FString& Owner, const FString& Kind, const FString& Endpoint);
+
+private:
+	FEnvPool();
+
+	FEnvPool(const FEnvPool&) = delete;
+	FEnvPool& operator=(const FEnvPool&) = delete;
+
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void WriteReadyFile(UWorld* World);
+	void RemoveReadyFile();
+
+	int32 EnvIndex = -1;
+	int32 PortStride = 100;
+	FString ReadyFilePath;
+	bool bReadyWritten = false;
+
+	// Endpoint count seen at the last tick start; the ready file waits for a tick without a change
+	int32 SettledEndpointCount = 0;
+
+	// Owner -> kind -> endpoint
+	TMap<FString, TMap<FString, FString>> Endpoints;
+};
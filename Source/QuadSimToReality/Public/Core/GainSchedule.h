@@ -0,0 +1,70 @@
+// GainSchedule.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Index into per-axis gain arrays. Matches the members of FFullPIDSet.
+enum class EPIDAxis : uint8
+{
+	X,
+	Y,
+	Z,
+	Roll,
+	Pitch,
+	Yaw,
+	Count
+};
+
+// Flight-state quantity a gain schedule is indexed by
+enum class EGainScheduleVariable : uint8
+{
+	None,
+	GroundSpeed,    // cm/s, magnitude of the body's velocity over ground; wind is not subtracted
+	Altitude,       // cm, world Z
+	BatteryVoltage  // V
+};
+
+struct QUADSIMTOREALITY_API FPIDGains
+{
+	float P = 0.f;
+	float I = 0.f;
+	float D = 0.f;
+
+	FPIDGains() = default;
+	FPIDGains(float InP, float InI, float InD) : P(InP), I(InI), D(InD) {}
+};
+
+/**
+ * Gains interpolated over one flight-state variable.
+ *
+ * The breakpoints from the config are resampled onto a uniform grid when the config is loaded,
+ * so evaluating the schedule is one index computation and one lerp, with no search.
+ */
+struct QUADSIMTOREALITY_API FGainScheduleTable
+{
+	EGainScheduleVariable Variable = EGainScheduleVariable::None;
+
+	bool IsActive() const { return Variable != EGainScheduleVariable::None && Samples.Num() > 0; }
+
+	/** Builds the flat table from (possibly non-uniform) breakpoints sorted by input */
+	bool Build(EGainScheduleVariable InVariable, const TArray<float>& Breakpoints, const TArray<FPIDGains>& Gains, int32 NumSamples = 64);
+
+	FORCEINLINE FPIDGains Evaluate(float Input) const
+	{
+		const float Position = FMath::Clamp((Input - MinInput) * InvStep, 0.f, static_cast<float>(Samples.Num() - 1));
+		const int32 Index = FMath::Min(static_cast<int32>(Position), Samples.Num() - 2);
+		const float Alpha = Position - Index;
+		const FPIDGains& A = Samples[Index];
+		const FPIDGains& B = Samples[Index + 1];
+		return FPIDGains(FMath::Lerp(A.P, B.P, Alpha), FMath::Lerp(A.I, B.I, Alpha), FMath::Lerp(A.D, B.D, Alpha));
+	}
+
+	static EGainScheduleVariable ParseVariable(const FString& Name);
+	static const TCHAR* GetVariableName(EGainScheduleVariable Variable);
+
+private:
+	float MinInput = 0.f;
+	float InvStep = 0.f;
+	// Always holds at least two samples once built
+	TArray<FPIDGains> Samples;
+};
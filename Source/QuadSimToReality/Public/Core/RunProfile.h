@@ -0,0 +1,60 @@
+// RunProfile.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/World.h"
+
+enum class ERunProfile : uint8
+{
+	Operator,	// Windowed, with the ImGui panels, debug drawing and ROS2
+	Training,	// Headless worker: ZMQ only, no UI, no debug drawing, no ROS2 node
+	ROSBridge	// ROS2 node and bridge, no UI or debug drawing
+};
+
+/**
+ * What this process is started for, and so which subsystems it brings up:
+ *
+ *   -RunProfile=operator|training|ros
+ *
+ * Without the flag a pooled instance (-EnvIndex) or one that cannot render runs as training, anything
+ * else as operator. Subsystems ask here instead of starting unconditionally: ImGui goes headless before
+ * the first viewport exists, ROS2 nodes are only initialized where WantsROS2(), and debug lines are only
+ * drawn where WantsDebugDraw().
+ *
+ * It also keeps time-to-ready: milestones since process start (engine init, world init, first tick,
+ * sockets bound, first step), logged as they are reached and summarized at the first step.
+ */
+class QUADSIMTOREALITY_API FRunProfile
+{
+public:
+	static FRunProfile& Get();
+
+	ERunProfile GetProfile() const { return Profile; }
+	const TCHAR* GetProfileName() const;
+
+	bool WantsUI() const { return Profile == ERunProfile::Operator; }
+	bool WantsDebugDraw() const { return Profile == ERunProfile::Operator; }
+	bool WantsROS2() const { return Profile != ERunProfile::Training; }
+
+	/** Records a startup milestone the first time it is reached; later calls are ignored */
+	void MarkMilestone(const TCHAR* Name);
+
+	/** Milestones reached so far, as seconds since process start, in the order they were reached */
+	const TArray<TPair<FString, double>>& GetMilestones() const { return Milestones; }
+
+private:
+	FRunProfile();
+
+	FRunProfile(const FRunProfile&) = delete;
+	FRunProfile& operator=(const FRunProfile&) = delete;
+
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+	void LogSummary() const;
+
+	ERunProfile Profile = ERunProfile::Operator;
+
+	// Milestones are marked from the game thread only
+	TArray<TPair<FString, double>> Milestones;
+};
@@ -0,0 +1,78 @@
+// SimClock.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Engine/World.h"
+#include <atomic>
+
+/**
+ * The simulation's notion of time: a tick counter and sim seconds for the game world, advanced at the
+ * start of every world tick. Controllers, the flight recorder and the ZMQ/ROS2 bridges stamp their
+ * output with it, so every consumer sees the same timeline. The getters are safe from any thread.
+ *
+ * It also owns how ticks are paced:
+ *
+ *   -FixedStepHz=N        Fixed dt of 1/N s, paced to real time.
+ *   -MaxSpeed             Fixed dt (60 Hz unless -FixedStepHz says otherwise) with no pacing, no vsync
+ *                         and no frame rate cap: ticks run back to back, as fast as the CPU allows.
+ *   -TimeDilation=X       Sim seconds per wall second while paced (0.25 for slow motion debugging).
+ *                         With a fixed step the dt stays the same and only the tick rate changes.
+ *
+ * Max speed and dilation can also be changed at runtime from the Global Drone Manager window.
+ */
+class QUADSIMTOREALITY_API FSimClock
+{
+public:
+	static FSimClock& Get();
+
+	uint64 GetTick() const { return Tick.load(std::memory_order_relaxed); }
+	double GetSimSeconds() const { return SimSeconds.load(std::memory_order_relaxed); }
+
+	/** Fixed step in seconds, or 0 when the engine runs on a variable dt */
+	float GetFixedDeltaTime() const { return FixedDeltaTime; }
+
+	/** Switches to a fixed step; the command journal uses this for record (paced) and replay (max speed) */
+	void SetFixedStep(float DeltaTime, bool bInMaxSpeed);
+
+	bool IsMaxSpeed() const { return bMaxSpeed; }
+	void SetMaxSpeed(bool bInMaxSpeed);
+
+	float GetDilation() const { return Dilation; }
+	void SetDilation(float InDilation);
+
+	/** Sim seconds advanced per wall second, smoothed over about a second */
+	float GetRealTimeFactor() const { return RealTimeFactor; }
+
+private:
+	FSimClock();
+
+	FSimClock(const FSimClock&) = delete;
+	FSimClock& operator=(const FSimClock&) = delete;
+
+	void ApplyPacing();
+	void ApplyWorldDilation(UWorld* World) const;
+
+	void OnPostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void OnWorldTickStart(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	std::atomic<uint64> Tick{ 0 };
+	std::atomic<double> SimSeconds{ 0.0 };
+
+	float FixedDeltaTime = 0.f;
+	float Dilation = 1.f;
+	bool bMaxSpeed = false;
+
+	// The game world the clock follows; editor preview worlds never advance it
+	TWeakObjectPtr<UWorld> ClockWorld;
+
+	double LastWallTime = 0.0;
+	float RealTimeFactor = 1.f;
+
+	// Frame limits in place before max speed overrode them
+	int32 SavedVSync = 0;
+	int32 SavedMaxFPS = 0;
+	bool bSavedSmoothFrameRate = false;
+	bool bFrameLimitsSaved = false;
+};
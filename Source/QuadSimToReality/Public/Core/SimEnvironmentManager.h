@@ -0,0 +1,92 @@
+// SimEnvironmentManager.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Core/DomainRandomizer.h"
+#include "Core/DroneStateSample.h"
+#include "Controllers/ZMQController.h"
+#include "Controllers/ZMQStepServer.h"
+#include "SimEnvironmentManager.generated.h"
+
+class AQuadPawn;
+class AObstacleManager;
+class UQuadDroneController;
+struct FExternalCommand;
+
+/**
+ * Hosts several independent training environments in one process. Each environment is a drone with
+ * its own obstacle layout, placed on a grid far enough apart that nothing in one can touch another;
+ * physics islands that never interact are solved in parallel by Chaos, and every environment advances
+ * on the same world tick, so they stay in lockstep. Run with -MaxSpeed for throughput.
+ *
+ * All environments are served by one step endpoint (ZMQStepProtocol.h) on StepConfiguration.RpcPort,
+ * addressed by the request's EnvIndex. Their actions go through the command journal as "Env<i>".
+ *
+ *   -NumEnvs=N    Overrides NumEnvironments
+ */
+UCLASS()
+class QUADSIMTOREALITY_API ASimEnvironmentManager : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	ASimEnvironmentManager();
+
+	virtual void Tick(float DeltaTime) override;
+
+	UFUNCTION(BlueprintCallable, Category = "Environments")
+	int32 GetNumEnvironments() const { return Environments.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Environments")
+	AQuadPawn* GetEnvironmentDrone(int32 EnvIndex) const;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(EditAnywhere, Category = "Environments", meta = (ClampMin = "1", ClampMax = "256"))
+	int32 NumEnvironments = 4;
+
+	// Distance between environment origins; keep it well beyond the obstacle boundary and flight area
+	UPROPERTY(EditAnywhere, Category = "Environments", meta = (ClampMin = "1000"))
+	float EnvironmentSpacing = 100000.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Environments")
+	TSubclassOf<AQuadPawn> QuadPawnClass;
+
+	// Each environment gets its own; leave empty for environments without obstacles
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Environments")
+	TSubclassOf<AObstacleManager> ObstacleManagerClass;
+
+	// Transport, socket options and RpcPort of the step endpoint; the other ports are unused
+	UPROPERTY(EditAnywhere, Category = "Environments")
+	FZMQConfiguration StepConfiguration;
+
+private:
+	struct FEnvironment
+	{
+		FVector Origin = FVector::ZeroVector;
+		FVector Goal = FVector::ZeroVector;
+		FString CommandTarget;
+		TWeakObjectPtr<AQuadPawn> Drone;
+		TWeakObjectPtr<AObstacleManager> Obstacles;
+
+		// The drone's controller is created in its BeginPlay, so it is bound from Tick
+		TWeakObjectPtr<UQuadDroneController> BoundController;
+		FDelegateHandle ControlStepHandle;
+
+		FDroneStateSample LastSample;
+		bool bHasSample = false;
+	};
+
+	void SpawnEnvironment(int32 EnvIndex);
+	void BindControllers();
+	void HandleControlStep(const FDroneStateSample& Sample, int32 EnvIndex);
+	void DispatchCommand(const FExternalCommand& Command, int32 EnvIndex);
+	void ResetEnvironment(int32 EnvIndex, const FResetSpec* Spec);
+	FZMQStepState MakeStepState(int32 EnvIndex) const;
+
+	TArray<FEnvironment> Environments;
+	FZMQStepServer StepServer;
+};
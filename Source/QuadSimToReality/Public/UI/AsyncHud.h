@@ -0,0 +1,82 @@
+// AsyncHud.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/TripleBuffer.h"
+#include "UI/TelemetryPyramid.h"
+
+class ADroneManager;
+class AQuadPawn;
+
+/** State of one drone as the HUD sees it */
+struct FDroneHudState
+{
+	// Only dereferenced by commands that run on the game thread
+	TWeakObjectPtr<AQuadPawn> Pawn;
+
+	FString DroneID;
+	FVector Position = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	FRotator Rotation = FRotator::ZeroRotator;
+	FVector DesiredVelocity = FVector::ZeroVector;
+	float Thrusts[4] = {};
+};
+
+/** Copy of the sim state that one UI frame draws from. Never modified once published. */
+struct FSimHudSnapshot
+{
+	uint64 FrameNumber = 0;
+	double SimTime = 0.0;
+	int32 SelectedDrone = 0;
+	TWeakObjectPtr<ADroneManager> Manager;
+	TArray<FDroneHudState> Drones;
+};
+
+/**
+ * HUD used when ImGui builds its frames on a task graph worker (-ImGuiAsyncFrames).
+ *
+ * The game thread fills a snapshot once per frame and publishes it through a triple buffer, which is all the HUD costs
+ * the sim. The worker draws the newest snapshot and never touches actors; anything the user does in the HUD is sent
+ * back to the game thread as a task that resolves its target through weak pointers. The inline HUD (UImGuiUtil and the
+ * drone manager window) is skipped in this mode, since ImGui must not be called from the game thread.
+ */
+class QUADSIMTOREALITY_API FAsyncHud
+{
+public:
+	static FAsyncHud& Get();
+
+	/** True when ImGui frames are built on a worker and game code must not call ImGui directly */
+	static bool IsEnabled();
+
+	/** Draw the HUD in the given world's ImGui context */
+	void Register(UWorld* World);
+	void Unregister(UWorld* World);
+
+	/** Game thread: fill the returned snapshot, then Publish hands it to the next UI frame */
+	FSimHudSnapshot& BeginPublish() { return Snapshots.GetWriteBuffer(); }
+	void Publish() { Snapshots.SwapWriteBuffers(); }
+
+private:
+	struct FDroneHistory
+	{
+		// FL, FR, BL, BR thrust, then speed and altitude; double so sim time stays exact over long runs
+		TTelemetryHistory<double, 1 << 14, 6> Samples;
+		uint64 LastFrame = 0;
+	};
+
+	FAsyncHud() = default;
+
+	FAsyncHud(const FAsyncHud&) = delete;
+	FAsyncHud& operator=(const FAsyncHud&) = delete;
+
+	// Everything below runs on the ImGui worker
+	void Draw();
+	void DrawManagerWindow(const FSimHudSnapshot& Snapshot);
+	void DrawDroneWindow(const FSimHudSnapshot& Snapshot, const FDroneHudState& Drone);
+	void RecordHistory(const FSimHudSnapshot& Snapshot);
+
+	TTripleBuffer<FSimHudSnapshot> Snapshots;
+
+	TMap<FString, TUniquePtr<FDroneHistory>> Histories;
+	float PlotWindow = 10.f;
+};
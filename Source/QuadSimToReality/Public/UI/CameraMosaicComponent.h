@@ -0,0 +1,90 @@
+// CameraMosaicComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ImGuiTextureHandle.h"
+#include "CameraMosaicComponent.generated.h"
+
+class AQuadPawn;
+class USceneCaptureComponent2D;
+class UTextureRenderTarget2D;
+
+/**
+ * Thumbnails of every drone's FPV camera, composed into one atlas render target and shown in a single
+ * ImGui window.
+ *
+ * One scene capture renders into a tile-sized target, which is then copied into the drone's cell of the
+ * atlas on the GPU. The atlas is registered with ImGui once, so the window draws every feed from one
+ * texture. Each frame at most TilesPerFrame tiles are captured, picking the ones that are most overdue
+ * relative to their own refresh rate. Nothing is captured while the window is closed or no UI is shown.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class QUADSIMTOREALITY_API UCameraMosaicComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UCameraMosaicComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Drones to show, in tile order. Tiles keep their schedule as long as their drone stays at the same index. */
+	void SetDrones(const TArray<AQuadPawn*>& Drones);
+
+	/** Overrides the refresh rate of one tile; a rate of zero or less restores TileRefreshHz */
+	void SetTileRefreshRate(int32 TileIndex, float Hz);
+
+	/** Draws the mosaic window. Clicking a tile writes its index to InOutSelectedDrone. */
+	void DrawWindow(int32& InOutSelectedDrone);
+
+	UPROPERTY(EditAnywhere, Category = "Camera Mosaic")
+	bool bShowWindow = false;
+
+	UPROPERTY(EditAnywhere, Category = "Camera Mosaic", meta = (ClampMin = "16"))
+	int32 TileWidth = 256;
+
+	UPROPERTY(EditAnywhere, Category = "Camera Mosaic", meta = (ClampMin = "16"))
+	int32 TileHeight = 144;
+
+	/** Default thumbnail refresh rate */
+	UPROPERTY(EditAnywhere, Category = "Camera Mosaic", meta = (ClampMin = "0.1"))
+	float TileRefreshHz = 5.f;
+
+	/** Scene captures allowed per frame, across all tiles */
+	UPROPERTY(EditAnywhere, Category = "Camera Mosaic", meta = (ClampMin = "1"))
+	int32 TilesPerFrame = 4;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	struct FTile
+	{
+		TWeakObjectPtr<AQuadPawn> Drone;
+		double LastCaptureTime = -1.0e9;
+		float RefreshHz = 0.f;
+	};
+
+	bool EnsureResources();
+	void CaptureTile(int32 TileIndex);
+	FIntPoint GetTileOrigin(int32 TileIndex) const;
+
+	UPROPERTY(Transient)
+	USceneCaptureComponent2D* Capture = nullptr;
+
+	UPROPERTY(Transient)
+	UTextureRenderTarget2D* TileTarget = nullptr;
+
+	UPROPERTY(Transient)
+	UTextureRenderTarget2D* Atlas = nullptr;
+
+	FImGuiTextureHandle AtlasHandle;
+	int32 AtlasColumns = 0;
+	int32 AtlasRows = 0;
+
+	TArray<FTile> Tiles;
+
+	// Reused by the scheduler so it does not allocate per frame
+	TArray<TPair<double, int32>> DueTiles;
+};
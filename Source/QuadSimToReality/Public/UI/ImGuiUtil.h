@@ -2,11 +2,14 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "Controllers/ZMQController.h"
+#include "UI/TelemetryPyramid.h"
+#include "UI/PIDGainHistory.h"
 #include "ImGuiUtil.generated.h"
 // Forward declarations
 class AQuadPawn;
 class QuadPIDController;
 class UQuadDroneController;
+struct FDroneConfigData;
 
 UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
 class QUADSIMTOREALITY_API UImGuiUtil : public UActorComponent
@@ -16,6 +19,9 @@ public:
 
     UImGuiUtil();
 
+    /** False on headless runs and while no viewport shows ImGui; every HUD entry point is a no-op then */
+    static bool IsUIActive();
+
     /** Call this once the owning controller and pawn are valid */
     void Initialize(AQuadPawn* InPawn, UQuadDroneController* InController);
     /** Main functions to draw the UI */
@@ -38,6 +44,7 @@ public:
 
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
 private:
@@ -49,27 +56,28 @@ private:
     UPROPERTY()
     UQuadDroneController* Controller;
 
-    // Parameters (stored by value now)
+    // Parameters (stored by value now, refreshed on config reload)
     float maxVelocity;
     float maxAngle;
 
-    // Data for plotting
-    TArray<float> TimeData;
-    TArray<float> Thrust0Data;
-    TArray<float> Thrust1Data;
-    TArray<float> Thrust2Data;
-    TArray<float> Thrust3Data;
-    float CumulativeTime;
+    void ApplyConfig(const FDroneConfigData& Config);
+    FDelegateHandle ConfigChangedHandle;
+
+    // Data for plotting. The raw rings hold about two minutes at 1 kHz and the min/max pyramids
+    // behind them cover hours; MaxPlotTime is only the visible window. Time is kept in double so
+    // it still resolves single steps that far in.
+    static constexpr int32 TelemetryCapacity = 1 << 17;
+    TTelemetryHistory<double, TelemetryCapacity, 4> ThrustHistory;   // FL, FR, BL, BR
+    TTelemetryHistory<double, TelemetryCapacity, 3> HeadingHistory;  // Desired, current, error
+    double CumulativeTime;
     float MaxPlotTime;
-    TArray<float> DesiredYawData;
-    TArray<float> CurrentYawData;
-    TArray<float> DesiredHeadingData;  
-    TArray<float> CurrentHeadingData;  
-    TArray<float> VectorErrorData;     
 
 
-    // Helper method to load PID values from a CSV row
-    void LoadPIDValues(const TArray<FString>& Values);
+    // Parsed PIDGains.csv, reloaded only when the file changes
+    FPIDGainHistory PIDHistory;
+    int32 PIDHistoryFilterColumn;
+    char PIDHistoryFilter[64];
 
-    static const int32 MaxDataPoints = 500;
+    // Helper method to load PID values from a saved row
+    void LoadPIDValues(const FPIDGainRow& Row);
 };
\ No newline at end of file
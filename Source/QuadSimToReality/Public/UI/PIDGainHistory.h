@@ -0,0 +1,78 @@
+// PIDGainHistory.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** One saved PID configuration: timestamp, then P, I, D for X, Y, Z, roll, pitch and yaw */
+struct FPIDGainRow
+{
+	static constexpr int32 NumGains = 18;
+
+	FString Timestamp;
+	float Gains[NumGains] = {};
+
+	// Rows written while a PID was missing have fewer gains and cannot be loaded back
+	int32 NumValues = 0;
+
+	// Position in the file, which is also chronological order
+	int32 FileOrder = 0;
+
+	bool IsComplete() const { return NumValues == NumGains; }
+};
+
+/**
+ * Parsed copy of PIDGains.csv for the history window.
+ *
+ * The file is only re-read when its size or timestamp changes, polled at most once per RefreshInterval,
+ * or right after MarkDirty (the save button appends to it). Sorting and filtering work on an index view
+ * over the parsed rows and are recomputed only when the data, the sort column or the filter changes.
+ */
+class QUADSIMTOREALITY_API FPIDGainHistory
+{
+public:
+	FPIDGainHistory() = default;
+	explicit FPIDGainHistory(const FString& InFilePath);
+
+	/** Reloads the file if it changed on disk. Cheap to call every frame. */
+	void Refresh();
+
+	/** Forces a reload on the next Refresh, e.g. after appending a row */
+	void MarkDirty() { bDirty = true; }
+
+	const FString& GetFilePath() const { return FilePath; }
+	bool FileExists() const { return bFileExists; }
+	const TArray<FString>& GetHeaders() const { return Headers; }
+	int32 NumRowsInFile() const { return Rows.Num(); }
+
+	/** Rows that pass the filter, in the current sort order */
+	int32 NumVisibleRows() const { return View.Num(); }
+	const FPIDGainRow& GetVisibleRow(int32 Index) const { return Rows[View[Index]]; }
+
+	/** Column 0 sorts by time, column c > 0 by gain c - 1 */
+	void SetSort(int32 Column, bool bAscending);
+
+	/** Keeps rows whose text in Column contains Text (case-insensitive); an empty Text keeps every row */
+	void SetFilter(int32 Column, const FString& Text);
+
+private:
+	static constexpr double RefreshInterval = 1.0;
+
+	void Load();
+	void RebuildView();
+
+	FString FilePath;
+	bool bFileExists = false;
+	bool bDirty = true;
+	double NextPollTime = 0.0;
+	FDateTime LoadedTimeStamp;
+	int64 LoadedSize = -1;
+
+	TArray<FString> Headers;
+	TArray<FPIDGainRow> Rows;
+	TArray<int32> View;
+
+	int32 SortColumn = 0;
+	bool bSortAscending = true;
+	int32 FilterColumn = 0;
+	FString FilterText;
+};
@@ -0,0 +1,20 @@
+// PerfHud.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * ImGui window showing FSimProfiler data: a rolling plot of each frame phase, percentiles over the
+ * plotted window, the per-drone cost, and a button that captures a JSON report.
+ *
+ * The profiler only measures while this window is open (or a capture is running).
+ */
+class QUADSIMTOREALITY_API FPerfHud
+{
+public:
+	/** Game thread only, in the inline HUD. Clearing bInOutOpen stops profiling. */
+	static void Draw(bool& bInOutOpen);
+
+	/** Length of the report the capture button records */
+	static constexpr double CaptureSeconds = 10.0;
+};
@@ -23,7 +23,7 @@ void Construct(const FArguments& InArgs);
 	/** Updates the render target to display */
 	void SetRenderTarget(UTextureRenderTarget2D* InRenderTarget);
 
-	// Override Tick to update FPS and refresh the brush
+	// Override Tick to update FPS. The brush keeps pointing at the render target, so it needs no refresh.
 	virtual void Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime) override;
 
 private:
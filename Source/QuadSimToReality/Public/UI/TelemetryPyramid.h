@@ -0,0 +1,287 @@
+// TelemetryPyramid.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "implot.h"
+#include "UI/TelemetryRing.h"
+
+/**
+ * Multi-resolution min/max summary of a telemetry stream, maintained as samples arrive.
+ *
+ * Level L holds buckets of Fanout^(L+1) samples. Each bucket keeps its time span plus the min and
+ * max of every channel and when they occurred (M4 aggregation without the first/last points, which
+ * the neighbouring buckets supply). A bucket is folded into the level above once it closes, so a
+ * push costs O(1) amortized. Every level is its own ring of BucketsPerLevel buckets; the coarse
+ * levels therefore reach back far longer than any raw sample buffer.
+ *
+ * With the defaults a bucket is 8, 64, 512, 4096 or 32768 samples wide and the top level spans
+ * about 1.3e8 samples, i.e. well over a day at 1 kHz, in a few MB per series. That reach needs
+ * T = double: a float clock accumulated in 1 ms steps resolves less than a millisecond after about
+ * 2.3 hours and stops advancing altogether a few hours later.
+ */
+template <typename T, int32 NumChannels, int32 NumLevels = 5, int32 Fanout = 8, int32 BucketsPerLevel = 4096>
+class TTelemetryPyramid
+{
+	static_assert(NumLevels > 0, "Telemetry pyramid needs at least one level");
+	static_assert(Fanout > 1, "Telemetry pyramid buckets must merge at least two children");
+
+public:
+	struct FBucket
+	{
+		T StartTime;
+		T EndTime;
+		T Min[NumChannels];
+		T Max[NumChannels];
+		T MinTime[NumChannels];
+		T MaxTime[NumChannels];
+	};
+
+	void Push(T Time, const T (&Values)[NumChannels])
+	{
+		FBucket Sample;
+		Sample.StartTime = Time;
+		Sample.EndTime = Time;
+		for (int32 c = 0; c < NumChannels; c++)
+		{
+			Sample.Min[c] = Sample.Max[c] = Values[c];
+			Sample.MinTime[c] = Sample.MaxTime[c] = Time;
+		}
+		Accumulate(0, Sample);
+	}
+
+	void Reset()
+	{
+		for (FLevel& Level : Levels)
+		{
+			Level.Head = 0;
+			Level.Count = 0;
+			Level.PartialChildren = 0;
+		}
+	}
+
+	static constexpr int32 GetNumLevels() { return NumLevels; }
+	static constexpr int32 GetBucketsPerLevel() { return BucketsPerLevel; }
+
+	/** Closed buckets at a level; the bucket still filling is not included */
+	int32 NumBuckets(int32 Level) const { return Levels[Level].Count; }
+
+	/** Access by age, 0 being the oldest bucket */
+	const FBucket& GetBucket(int32 Level, int32 Index) const
+	{
+		const FLevel& L = Levels[Level];
+		const int32 Oldest = L.Count < BucketsPerLevel ? 0 : L.Head;
+		const int32 Physical = Oldest + Index;
+		return L.Buckets[Physical >= BucketsPerLevel ? Physical - BucketsPerLevel : Physical];
+	}
+
+	/** True if the level has not dropped any bucket ending at or after Time */
+	bool Covers(int32 Level, T Time) const
+	{
+		const FLevel& L = Levels[Level];
+		return L.Count < BucketsPerLevel || GetBucket(Level, 0).StartTime <= Time;
+	}
+
+	/** First bucket index at a level whose end is after Time */
+	int32 UpperBound(int32 Level, T Time) const
+	{
+		int32 Low = 0;
+		int32 High = Levels[Level].Count;
+		while (Low < High)
+		{
+			const int32 Mid = (Low + High) / 2;
+			if (GetBucket(Level, Mid).EndTime <= Time)
+			{
+				Low = Mid + 1;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+		return Low;
+	}
+
+private:
+	struct FLevel
+	{
+		TArray<FBucket> Buckets;
+		int32 Head = 0;
+		int32 Count = 0;
+
+		// Bucket being filled from the level below (or from raw samples at level 0)
+		FBucket Partial;
+		int32 PartialChildren = 0;
+	};
+
+	void Accumulate(int32 LevelIndex, const FBucket& Child)
+	{
+		FLevel& Level = Levels[LevelIndex];
+		if (Level.PartialChildren == 0)
+		{
+			Level.Partial = Child;
+		}
+		else
+		{
+			Merge(Level.Partial, Child);
+		}
+
+		if (++Level.PartialChildren < Fanout)
+		{
+			return;
+		}
+
+		if (Level.Buckets.Num() == 0)
+		{
+			Level.Buckets.SetNumUninitialized(BucketsPerLevel);
+		}
+		Level.Buckets[Level.Head] = Level.Partial;
+		Level.Head = Level.Head + 1 == BucketsPerLevel ? 0 : Level.Head + 1;
+		Level.Count = FMath::Min(Level.Count + 1, BucketsPerLevel);
+		Level.PartialChildren = 0;
+
+		if (LevelIndex + 1 < NumLevels)
+		{
+			Accumulate(LevelIndex + 1, Level.Buckets[Level.Head == 0 ? BucketsPerLevel - 1 : Level.Head - 1]);
+		}
+	}
+
+	static void Merge(FBucket& Into, const FBucket& Later)
+	{
+		Into.EndTime = Later.EndTime;
+		for (int32 c = 0; c < NumChannels; c++)
+		{
+			if (Later.Min[c] < Into.Min[c])
+			{
+				Into.Min[c] = Later.Min[c];
+				Into.MinTime[c] = Later.MinTime[c];
+			}
+			if (Later.Max[c] > Into.Max[c])
+			{
+				Into.Max[c] = Later.Max[c];
+				Into.MaxTime[c] = Later.MaxTime[c];
+			}
+		}
+	}
+
+	FLevel Levels[NumLevels];
+};
+
+/**
+ * Raw ring plus min/max pyramid over the same stream, for plots that must stay cheap at any zoom.
+ *
+ * PlotLine uses the raw samples while the visible range holds no more than about two per pixel
+ * column. Beyond that it draws the finest pyramid level with at most one bucket per pixel, so the
+ * point count is bounded by the plot width rather than by the history length. Samples newer than
+ * the last closed bucket of that level come from the finer levels and then the raw ring, so the
+ * right edge of the plot is always current.
+ */
+template <typename T, int32 Capacity, int32 NumChannels = 1>
+class TTelemetryHistory
+{
+public:
+	using FRing = TTelemetryRing<T, Capacity, NumChannels>;
+	using FPyramid = TTelemetryPyramid<T, NumChannels>;
+
+	template <typename... ChannelTypes>
+	void Push(T Time, ChannelTypes... Values)
+	{
+		Ring.Push(Time, Values...);
+		const T Sample[] = { static_cast<T>(Values)... };
+		Pyramid.Push(Time, Sample);
+	}
+
+	void Reset()
+	{
+		Ring.Reset();
+		Pyramid.Reset();
+	}
+
+	int32 Num() const { return Ring.Num(); }
+	T GetLatestTime() const { return Ring.GetLatestTime(); }
+	const FRing& GetRing() const { return Ring; }
+	const FPyramid& GetPyramid() const { return Pyramid; }
+
+	/** Draws one channel into the current plot. Must be called between BeginPlot and EndPlot, after setup. */
+	void PlotLine(const char* Label, int32 Channel, ImPlotLineFlags Flags = 0) const
+	{
+		if (Ring.Num() == 0)
+		{
+			return;
+		}
+
+		const ImPlotRect Limits = ImPlot::GetPlotLimits();
+		const T ViewMin = static_cast<T>(Limits.X.Min);
+		const T ViewMax = static_cast<T>(Limits.X.Max);
+		const int32 Pixels = FMath::Max(static_cast<int32>(ImPlot::GetPlotSize().x), 1);
+
+		const bool bRingCovers = Ring.Num() < Capacity || Ring.GetTime(0) <= ViewMin;
+		if (bRingCovers && Ring.LowerBound(ViewMax) - Ring.LowerBound(ViewMin) <= Pixels * 2)
+		{
+			Ring.PlotLine(Label, Channel, Flags);
+			return;
+		}
+
+		int32 Level = FPyramid::GetNumLevels() - 1;
+		for (int32 l = 0; l < FPyramid::GetNumLevels(); l++)
+		{
+			if (Pyramid.Covers(l, ViewMin) && Pyramid.UpperBound(l, ViewMax) - Pyramid.UpperBound(l, ViewMin) <= Pixels)
+			{
+				Level = l;
+				break;
+			}
+		}
+
+		ScratchTimes.Reset();
+		ScratchValues.Reset();
+
+		// Closed buckets at the chosen level, then progressively finer ones for the still-open tail.
+		// Each finer level contributes fewer than Fanout buckets, so the tail stays small.
+		T EmittedEnd = TNumericLimits<T>::Lowest();
+		for (int32 l = Level; l >= 0; l--)
+		{
+			int32 Index = l == Level ? FMath::Max(Pyramid.UpperBound(l, ViewMin) - 1, 0) : Pyramid.UpperBound(l, EmittedEnd);
+			for (; Index < Pyramid.NumBuckets(l); Index++)
+			{
+				const typename FPyramid::FBucket& Bucket = Pyramid.GetBucket(l, Index);
+				EmitBucket(Bucket, Channel);
+				EmittedEnd = Bucket.EndTime;
+				if (Bucket.StartTime > ViewMax)
+				{
+					break;
+				}
+			}
+		}
+
+		for (int32 i = Ring.UpperBound(EmittedEnd); i < Ring.Num(); i++)
+		{
+			ScratchTimes.Add(Ring.GetTime(i));
+			ScratchValues.Add(Ring.GetValue(Channel, i));
+			if (Ring.GetTime(i) > ViewMax)
+			{
+				break;
+			}
+		}
+
+		ImPlot::PlotLine(Label, ScratchTimes.GetData(), ScratchValues.GetData(), ScratchTimes.Num(), Flags);
+	}
+
+private:
+	void EmitBucket(const typename FPyramid::FBucket& Bucket, int32 Channel) const
+	{
+		const bool bMinFirst = Bucket.MinTime[Channel] <= Bucket.MaxTime[Channel];
+		ScratchTimes.Add(bMinFirst ? Bucket.MinTime[Channel] : Bucket.MaxTime[Channel]);
+		ScratchValues.Add(bMinFirst ? Bucket.Min[Channel] : Bucket.Max[Channel]);
+		if (Bucket.Min[Channel] != Bucket.Max[Channel])
+		{
+			ScratchTimes.Add(bMinFirst ? Bucket.MaxTime[Channel] : Bucket.MinTime[Channel]);
+			ScratchValues.Add(bMinFirst ? Bucket.Max[Channel] : Bucket.Min[Channel]);
+		}
+	}
+
+	FRing Ring;
+	FPyramid Pyramid;
+
+	// Reused between frames so drawing does not allocate once warmed up
+	mutable TArray<T> ScratchTimes;
+	mutable TArray<T> ScratchValues;
+};
@@ -0,0 +1,187 @@
+// TelemetryRing.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "implot.h"
+
+/**
+ * Fixed-capacity history of a time axis plus NumChannels value series, for ImPlot views.
+ *
+ * Pushing a sample overwrites the oldest one once the ring is full, so appending is O(1) with no
+ * memmove. Storage is channel-major and allocated on the first push, so a HUD that is never shown
+ * costs nothing. The time axis must be non-decreasing.
+ *
+ * PlotLine draws only the samples inside the current plot's X limits. A contiguous visible range is
+ * handed to ImPlot in place (using its offset parameter when the whole ring is visible). A wide
+ * range is min/max decimated to about two points per pixel column, so spikes survive.
+ */
+template <typename T, int32 Capacity, int32 NumChannels = 1>
+class TTelemetryRing
+{
+	static_assert(Capacity > 1, "Telemetry ring needs room for at least two samples");
+	static_assert(NumChannels > 0, "Telemetry ring needs at least one channel");
+
+public:
+	template <typename... ChannelTypes>
+	void Push(T Time, ChannelTypes... Values)
+	{
+		static_assert(sizeof...(Values) == NumChannels, "Push takes one value per channel");
+
+		if (Storage.Num() == 0)
+		{
+			Storage.SetNumUninitialized(Capacity * (NumChannels + 1));
+		}
+
+		T* Data = Storage.GetData();
+		Data[Head] = Time;
+		int32 Column = 1;
+		((Data[Column++ * Capacity + Head] = static_cast<T>(Values)), ...);
+
+		Head = Head + 1 == Capacity ? 0 : Head + 1;
+		Count = FMath::Min(Count + 1, Capacity);
+	}
+
+	void Reset()
+	{
+		Head = 0;
+		Count = 0;
+	}
+
+	int32 Num() const { return Count; }
+	static constexpr int32 GetCapacity() { return Capacity; }
+
+	/** Physical index of the oldest sample; this is ImPlot's offset for the whole ring */
+	int32 GetOffset() const { return Count < Capacity ? 0 : Head; }
+
+	const T* GetTimes() const { return Storage.GetData(); }
+	const T* GetChannel(int32 Channel) const { return Storage.GetData() + (Channel + 1) * Capacity; }
+
+	/** Access by age, 0 being the oldest sample */
+	T GetTime(int32 Index) const { return GetTimes()[ToPhysical(Index)]; }
+	T GetValue(int32 Channel, int32 Index) const { return GetChannel(Channel)[ToPhysical(Index)]; }
+	T GetLatestTime() const { return Count > 0 ? GetTime(Count - 1) : T(0); }
+
+	/** First sample index whose time is not before Time */
+	int32 LowerBound(T Time) const
+	{
+		return Partition([Time](T SampleTime) { return SampleTime < Time; });
+	}
+
+	/** First sample index whose time is after Time */
+	int32 UpperBound(T Time) const
+	{
+		return Partition([Time](T SampleTime) { return SampleTime <= Time; });
+	}
+
+	/** Draws one channel into the current plot. Must be called between BeginPlot and EndPlot, after setup. */
+	void PlotLine(const char* Label, int32 Channel, ImPlotLineFlags Flags = 0) const
+	{
+		if (Count == 0)
+		{
+			return;
+		}
+
+		// One sample of margin either side so the line runs off the plot edges
+		const ImPlotRect Limits = ImPlot::GetPlotLimits();
+		const int32 First = FMath::Max(LowerBound(static_cast<T>(Limits.X.Min)) - 1, 0);
+		const int32 Last = FMath::Min(LowerBound(static_cast<T>(Limits.X.Max)) + 1, Count);
+		const int32 Visible = Last - First;
+		if (Visible <= 0)
+		{
+			return;
+		}
+
+		const int32 MaxPoints = FMath::Max(static_cast<int32>(ImPlot::GetPlotSize().x) * 2, 2);
+		const T* Times = GetTimes();
+		const T* Values = GetChannel(Channel);
+
+		if (Visible == Count && Count <= MaxPoints)
+		{
+			ImPlot::PlotLine(Label, Times, Values, Count, Flags, GetOffset());
+			return;
+		}
+
+		const int32 Start = ToPhysical(First);
+		if (Visible <= MaxPoints && Start + Visible <= Capacity)
+		{
+			ImPlot::PlotLine(Label, Times + Start, Values + Start, Visible, Flags);
+			return;
+		}
+
+		Decimate(Channel, First, Visible, MaxPoints / 2);
+		ImPlot::PlotLine(Label, ScratchTimes.GetData(), ScratchValues.GetData(), ScratchTimes.Num(), Flags);
+	}
+
+private:
+	template <typename PredicateType>
+	int32 Partition(PredicateType IsBefore) const
+	{
+		int32 Low = 0;
+		int32 High = Count;
+		while (Low < High)
+		{
+			const int32 Mid = (Low + High) / 2;
+			if (IsBefore(GetTime(Mid)))
+			{
+				Low = Mid + 1;
+			}
+			else
+			{
+				High = Mid;
+			}
+		}
+		return Low;
+	}
+
+	int32 ToPhysical(int32 Index) const
+	{
+		const int32 Physical = GetOffset() + Index;
+		return Physical >= Capacity ? Physical - Capacity : Physical;
+	}
+
+	// Emits the min and max of each bucket, in time order
+	void Decimate(int32 Channel, int32 First, int32 Num, int32 Buckets) const
+	{
+		ScratchTimes.Reset();
+		ScratchValues.Reset();
+		Buckets = FMath::Clamp(Buckets, 1, Num);
+
+		const int32 BucketSize = FMath::DivideAndRoundUp(Num, Buckets);
+		for (int32 BucketStart = First; BucketStart < First + Num; BucketStart += BucketSize)
+		{
+			const int32 BucketEnd = FMath::Min(BucketStart + BucketSize, First + Num);
+			int32 MinIndex = BucketStart;
+			int32 MaxIndex = BucketStart;
+			for (int32 i = BucketStart + 1; i < BucketEnd; i++)
+			{
+				const T Value = GetValue(Channel, i);
+				if (Value < GetValue(Channel, MinIndex))
+				{
+					MinIndex = i;
+				}
+				else if (Value > GetValue(Channel, MaxIndex))
+				{
+					MaxIndex = i;
+				}
+			}
+
+			const int32 A = FMath::Min(MinIndex, MaxIndex);
+			const int32 B = FMath::Max(MinIndex, MaxIndex);
+			ScratchTimes.Add(GetTime(A));
+			ScratchValues.Add(GetValue(Channel, A));
+			if (B != A)
+			{
+				ScratchTimes.Add(GetTime(B));
+				ScratchValues.Add(GetValue(Channel, B));
+			}
+		}
+	}
+
+	TArray<T> Storage;
+	int32 Head = 0;
+	int32 Count = 0;
+
+	// Reused between frames so decimation does not allocate once warmed up
+	mutable TArray<T> ScratchTimes;
+	mutable TArray<T> ScratchValues;
+};
@@ -0,0 +1,172 @@
+// FlightRecorder.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/LockFreeList.h"
+#include "HAL/Runnable.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include <atomic>
+
+/**
+ * On-disk layout of a flight log (.qsfl). Everything is little-endian and naturally aligned.
+ * flight_log.py in the project root mirrors these structs; keep the two in sync and bump
+ * FormatVersion on any change.
+ *
+ *   [FFlightLogHeader, padded to HeaderSize bytes][FFlightRecord]*
+ */
+struct FFlightLogHeader
+{
+	static constexpr uint32 FormatVersion = 1;
+	static constexpr uint32 HeaderSize = 8192;
+	static constexpr int32 MaxDrones = 64;
+	static constexpr int32 MaxDroneNameLength = 64;
+
+	char Magic[8];           // "QSFLTLOG"
+	uint32 Version;
+	uint32 RecordSize;
+	uint32 HeaderBytes;
+	uint32 NumDrones;
+	uint64 NumRecords;       // Records on disk, updated whenever the writer appends; exact once the log is closed
+	int64 StartUnixTimeMs;
+	char DroneNames[MaxDrones][MaxDroneNameLength]; // UTF-8, null terminated, indexed by DroneIndex
+};
+static_assert(sizeof(FFlightLogHeader) <= FFlightLogHeader::HeaderSize, "Flight log header does not fit its reserved space");
+
+// One control step of one drone
+struct FFlightRecord
+{
+	enum EFlags : uint32
+	{
+		ManualThrust = 1 << 0,
+		HoverMode    = 1 << 1,
+	};
+
+	uint64 Step;                // Per-drone control step index
+	double SimTime;             // World time in seconds
+	uint32 DroneIndex;          // Index into FFlightLogHeader::DroneNames
+	uint32 Flags;
+	float Position[3];          // cm, world
+	float Velocity[3];          // cm/s, world
+	float Rotation[3];          // Roll, pitch, yaw in degrees
+	float AngularVelocity[3];   // deg/s
+	float DesiredVelocity[3];   // cm/s
+	float DesiredYaw;           // degrees
+	float PIDOutput[6];         // X, Y, Z, Roll, Pitch, Yaw (same order as EPIDAxis)
+	float PIDTerms[6][3];       // P, I, D term per axis
+	float Thrusts[4];
+};
+static_assert(sizeof(FFlightRecord) == 200, "FFlightRecord layout changed; update flight_log.py and FormatVersion");
+
+/** Append-only file that grows in large mapped segments (falls back to buffered writes where mmap is unavailable) */
+class FMappedAppendFile
+{
+public:
+	~FMappedAppendFile() { Close(); }
+
+	bool Open(const FString& Path, int64 InDataOffset);
+	void Append(const void* Data, int64 Size);
+	void WriteAt(int64 Offset, const void* Data, int64 Size);
+	void Close();
+
+	bool IsOpen() const;
+	int64 GetAppendedBytes() const { return Appended; }
+
+private:
+	static constexpr int64 SegmentSize = 64 * 1024 * 1024;
+
+	int64 DataOffset = 0;
+	int64 Appended = 0;
+
+#if PLATFORM_UNIX
+	bool MapSegment(int64 NewSegmentStart);
+
+	int FileDescriptor = -1;
+	uint8* Segment = nullptr;
+	int64 SegmentStart = 0;
+#else
+	// Header rewrites seek the shared handle, so they are serialized against appends
+	FCriticalSection HandleLock;
+	TUniquePtr<IFileHandle> Handle;
+#endif
+};
+
+/**
+ * Records every control step of every drone to a binary log.
+ *
+ * Record() copies into a chunk owned by the calling thread without taking a lock. Full chunks go
+ * through a lock-free MPSC queue to a writer thread, which appends them to the mapped file and
+ * updates the record count in the header. When the writer has been idle for 100 ms it asks every
+ * producer to hand over its partial chunk with its next record, so a slow trickle is not held back
+ * until the session stops.
+ * Enable with "flight_recorder": { "enabled": true } in DroneConfig.json or -FlightRecord on the
+ * command line. A new log is started when the first drone registers and closed when its world is
+ * cleaned up. Producers must be idle when a session stops.
+ */
+class QUADSIMTOREALITY_API FFlightRecorder : public FRunnable
+{
+public:
+	static FFlightRecorder& Get();
+
+	/** Returns the drone's index in the current log, starting a session if recording is enabled */
+	uint32 RegisterDrone(const FString& DroneID);
+
+	FORCEINLINE bool IsRecording() const { return bRecording.load(std::memory_order_relaxed); }
+
+	void Record(const FFlightRecord& Record);
+
+	bool StartSession();
+	void StopSession();
+
+	// FRunnable, for the writer thread
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	static constexpr int32 ChunkCapacity = 512;
+
+	struct FChunk
+	{
+		int32 NumRecords = 0;
+		FFlightRecord Records[ChunkCapacity];
+	};
+
+	struct FThreadBuffer
+	{
+		FChunk* Current = nullptr;
+
+		// Set by the writer, cleared by the owning thread when it queues its partial chunk
+		std::atomic<bool> bFlushRequested{ false };
+	};
+
+	FFlightRecorder();
+	virtual ~FFlightRecorder() override;
+
+	FThreadBuffer& GetThreadBuffer();
+	FChunk* AcquireChunk();
+	void WriteChunk(FChunk* Chunk);
+	void DrainQueue();
+	void RequestFlush();
+	void WriteHeader();
+	bool IsEnabled() const;
+
+	std::atomic<bool> bRecording{ false };
+	std::atomic<bool> bStopWriter{ false };
+
+	TQueue<FChunk*, EQueueMode::Mpsc> FullChunks;
+	TLockFreePointerListUnordered<FChunk, PLATFORM_CACHE_LINE_SIZE> FreeChunks;
+
+	// Thread buffers are created once per producing thread and reused across sessions
+	FCriticalSection BufferRegistryLock;
+	TArray<TUniquePtr<FThreadBuffer>> ThreadBuffers;
+
+	// Only touched on the game thread or under DroneLock
+	FCriticalSection DroneLock;
+	FFlightLogHeader Header;
+	TMap<FString, uint32> DroneIndices;
+
+	FMappedAppendFile File;
+	FString FilePath;
+	FRunnableThread* WriterThread = nullptr;
+	FEvent* WakeEvent = nullptr;
+};
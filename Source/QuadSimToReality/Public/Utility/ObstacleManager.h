@@ -2,9 +2,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Math/RandomStream.h"
 #include "GameFramework/Actor.h"
 #include "ObstacleManager.generated.h"
 
+struct FDroneConfigData;
+
 UENUM(BlueprintType)
 enum class EGoalPosition : uint8
 {
@@ -44,6 +47,9 @@ public:
     // Main function to create obstacles and goal - called by ZMQ controller
     UFUNCTION(BlueprintCallable, Category = "Obstacles")
     void CreateObstacles(int32 NumObstacles, EGoalPosition GoalPos = EGoalPosition::Random);
+
+    // Same layout for the same seed. Batch resets place the drones themselves, so they skip the move.
+    void CreateObstaclesWithSeed(int32 NumObstacles, int32 Seed, EGoalPosition GoalPos = EGoalPosition::Random, bool bMoveDrone = true);
     
     // Clear all obstacles and goal
     UFUNCTION(BlueprintCallable, Category = "Obstacles")
@@ -54,6 +60,7 @@ public:
     
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
     
     // Draw debug visualization with thicker lines
     UFUNCTION(BlueprintCallable, Category = "Debug")
@@ -71,6 +78,10 @@ private:
 
     EGoalPosition GetOppositePosition(EGoalPosition Position);
     FVector GetPositionLocation(EGoalPosition Position);
+
+    // Pulls boundary sizes from a config snapshot and redraws the boundaries
+    void ApplyConfig(const FDroneConfigData& Config);
+    FDelegateHandle ConfigChangedHandle;
     
     // Store spawned actors for easy cleanup
     UPROPERTY()
@@ -78,4 +89,7 @@ private:
     
     UPROPERTY()
     AActor* SpawnedGoal;
+
+    // Source for obstacle placement and goal selection, reseeded on every layout
+    FRandomStream RandomStream;
 };
\ No newline at end of file
@@ -30,6 +30,10 @@ public:
 	float prevError;
 	// Last output for debugging or logging
 	float lastOutput;
+	// Individual terms of the last output, for telemetry
+	float lastPTerm;
+	float lastITerm;
+	float lastDTerm;
 
 private:
 	// Integral window duration in seconds
@@ -0,0 +1,93 @@
+// SharedFrameRing.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Layout of a camera frame ring in POSIX shared memory (/dev/shm/<name>). Everything is little-endian.
+ * quadsim_shm.py in the project root mirrors these structs; keep the two in sync and bump FormatVersion
+ * on any change.
+ *
+ *   [FSharedFrameRingHeader, padded to HeaderSize][FSharedFrameSlot, padded to SlotHeaderSize][pixels]...
+ *
+ * Every slot is guarded by a seqlock: Sequence is odd while the writer fills the slot and even once it
+ * is complete. A reader that sees the same even Sequence before and after using the pixels got a whole
+ * frame; otherwise the writer lapped it and the frame must be dropped or re-read.
+ */
+struct FSharedFrameRingHeader
+{
+	static constexpr uint32 FormatVersion = 1;
+	static constexpr uint32 HeaderSize = 256;
+	static constexpr uint32 SlotHeaderSize = 64;
+
+	char Magic[8];                  // "QSFRAMES"
+	uint32 Version;
+	uint32 NumSlots;
+	uint32 SlotBytes;               // Slot header plus pixels, a multiple of 64
+	uint32 Width;
+	uint32 Height;
+	uint32 BytesPerPixel;           // 4, BGRA8 as read back from the render target
+	std::atomic<uint64> LatestFrame; // FrameId of the newest complete frame, 0 before the first one
+};
+static_assert(sizeof(FSharedFrameRingHeader) <= FSharedFrameRingHeader::HeaderSize, "Frame ring header does not fit its reserved space");
+
+struct FSharedFrameSlot
+{
+	std::atomic<uint32> Sequence;
+	uint32 Pad;
+	uint64 FrameId;                 // Counts from 1; slot = (FrameId - 1) % NumSlots
+	double SimTime;                 // World time of the capture in seconds
+	uint32 Width;
+	uint32 Height;
+};
+static_assert(sizeof(FSharedFrameSlot) <= FSharedFrameRingHeader::SlotHeaderSize, "Frame slot header does not fit its reserved space");
+
+/**
+ * Writer side of a camera frame ring shared with processes on the same host.
+ *
+ * Pixels are copied straight from the readback buffer into the next slot, and only a descriptor
+ * (see MakeDescriptor) goes out over ZMQ or ROS2, so transport cost no longer grows with resolution.
+ * The ring never waits for readers; a reader more than NumSlots frames behind loses frames.
+ *
+ * Only available on Unix; elsewhere Open fails and callers keep their serialized image path.
+ */
+class QUADSIMTOREALITY_API FSharedFrameRing
+{
+public:
+	FSharedFrameRing() = default;
+	~FSharedFrameRing() { Close(); }
+
+	FSharedFrameRing(const FSharedFrameRing&) = delete;
+	FSharedFrameRing& operator=(const FSharedFrameRing&) = delete;
+
+	/** Creates (or replaces) the named segment. Name is the bare shm name, without the leading '/'. */
+	bool Open(const FString& InName, int32 InWidth, int32 InHeight, int32 InNumSlots = 4);
+	void Close();
+	bool IsOpen() const { return Header != nullptr; }
+
+	/**
+	 * Copies one frame into the next slot and returns its FrameId, or 0 if the ring is closed or the
+	 * frame does not match the ring's size. Single writer; safe to call from any one thread at a time.
+	 */
+	uint64 Write(const FColor* Pixels, int32 InWidth, int32 InHeight, double SimTime);
+
+	/** "SHM:<name>,<frame id>,<slot>,<width>,<height>", the message sent in place of the pixels */
+	FString MakeDescriptor(uint64 FrameId) const;
+
+	const FString& GetName() const { return Name; }
+	int32 GetNumSlots() const { return NumSlots; }
+	int32 GetWidth() const { return Width; }
+	int32 GetHeight() const { return Height; }
+
+private:
+	FSharedFrameSlot* GetSlot(int32 Index) const;
+
+	FString Name;
+	FSharedFrameRingHeader* Header = nullptr;
+	int64 MappedBytes = 0;
+	int32 NumSlots = 0;
+	int32 Width = 0;
+	int32 Height = 0;
+	uint64 NextFrameId = 1;
+};
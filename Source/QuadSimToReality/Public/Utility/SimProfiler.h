@@ -0,0 +1,166 @@
+// SimProfiler.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UI/TelemetryRing.h"
+#include <atomic>
+
+/** Subsystems the performance HUD breaks a frame into */
+enum class ESimPhase : uint8
+{
+	Control,
+	Physics,
+	ZMQ,
+	ROS2,
+	ImageCapture,
+	ImageReadback,
+	ImageEncode,
+	Obstacles,
+	UI,
+	Count
+};
+
+/**
+ * Per-frame cost of each ESimPhase, measured with FSimScopedTimer.
+ *
+ * Timers add cycles to counters owned by the calling thread, so timing costs two cycle reads and no lock
+ * on any thread (game, render, workers). Once per frame the game thread sums every thread's counters and
+ * turns the difference to the previous frame into that frame's sample. Work done on other threads is
+ * therefore attributed to the frame in which it finished. Timers tagged with a drone slot are also summed
+ * per drone.
+ *
+ * Nothing is measured until the profiler is enabled (the performance HUD does that while it is open).
+ * StartCapture records every frame for a while and then writes a JSON report to Saved/Profiles.
+ */
+class QUADSIMTOREALITY_API FSimProfiler
+{
+public:
+	static constexpr int32 NumPhases = static_cast<int32>(ESimPhase::Count);
+	static constexpr int32 MaxDrones = 64;
+	static constexpr int32 HistoryFrames = 2048;
+
+	// Phases followed by the whole frame time, all in milliseconds. Double, because the time axis
+	// counts seconds since the profiler was enabled and a float loses frame resolution within hours
+	static constexpr int32 NumChannels = NumPhases + 1;
+	static constexpr int32 FrameChannel = NumPhases;
+	using FHistory = TTelemetryRing<double, HistoryFrames, NumChannels>;
+
+	static FSimProfiler& Get();
+	static const TCHAR* GetPhaseName(ESimPhase Phase);
+
+	FORCEINLINE static bool IsEnabled() { return bEnabled.load(std::memory_order_relaxed); }
+	void SetEnabled(bool bInEnabled);
+
+	/** Adds time to the calling thread's counters. DroneSlot may be INDEX_NONE. */
+	void AddCycles(ESimPhase Phase, int32 DroneSlot, uint64 Cycles);
+
+	/** Slot for per-drone attribution, or INDEX_NONE once MaxDrones are registered. Cache the result. */
+	int32 GetDroneSlot(const FString& DroneID);
+	FString GetDroneID(int32 Slot) const;
+	int32 NumDroneSlots() const;
+
+	/** Game thread: times the world's physics step until UnbindPhysics */
+	void BindPhysics(UWorld* World);
+	void UnbindPhysics(UWorld* World);
+
+	/** Records frames for the given time, then writes a report. Returns false if a capture is running. */
+	bool StartCapture(double Seconds);
+	bool IsCapturing() const { return CaptureDuration > 0.0; }
+	float GetCaptureProgress() const;
+	const FString& GetLastReportPath() const { return LastReportPath; }
+
+	const FHistory& GetHistory() const { return History; }
+
+	/** Smoothed per-frame cost of one drone, in milliseconds */
+	float GetDroneMs(int32 Slot) const { return Slot >= 0 && Slot < MaxDrones ? DroneMs[Slot] : 0.f; }
+
+	/** Percentiles of one channel over the newest NumFrames frames */
+	void GetPercentiles(int32 Channel, int32 NumFrames, float& OutP50, float& OutP95, float& OutP99) const;
+
+private:
+	struct FThreadCounters
+	{
+		std::atomic<uint64> Phases[NumPhases] = {};
+		std::atomic<uint64> Drones[MaxDrones] = {};
+	};
+
+	struct FCaptureFrame
+	{
+		float Ms[NumChannels];
+	};
+
+	FSimProfiler() = default;
+
+	FThreadCounters& GetThreadCounters();
+	void EndFrame();
+	void WriteReport();
+
+	static std::atomic<bool> bEnabled;
+
+	// Counters are created once per thread that ever measured something and never freed
+	mutable FCriticalSection RegistryLock;
+	TArray<TUniquePtr<FThreadCounters>> ThreadCounters;
+	TMap<FString, int32> DroneSlots;
+	TArray<FString> DroneIDs;
+
+	// Everything below is game thread only
+	uint64 LastPhaseTotals[NumPhases] = {};
+	uint64 LastDroneTotals[MaxDrones] = {};
+	float DroneMs[MaxDrones] = {};
+	FHistory History;
+	double StartTime = 0.0;
+	double LastEndFrameTime = 0.0;
+	FDelegateHandle EndFrameHandle;
+
+	TMap<TWeakObjectPtr<UWorld>, TPair<FDelegateHandle, FDelegateHandle>> PhysicsHandles;
+	uint64 PhysicsStartCycles = 0;
+
+	double CaptureDuration = 0.0;
+	double CaptureStart = 0.0;
+	TArray<FCaptureFrame> CaptureFrames;
+	TArray<double> CaptureDroneMs;
+	FString LastReportPath;
+
+	mutable TArray<float> PercentileScratch;
+};
+
+/**
+ * Adds the time until it goes out of scope to a phase (and optionally a drone).
+ *
+ * Phases are exclusive: time spent in a nested timer on the same thread is only counted by the inner
+ * one, so the HUD drawn from inside the control step shows up as UI and not as Control.
+ */
+class QUADSIMTOREALITY_API FSimScopedTimer
+{
+public:
+	FORCEINLINE explicit FSimScopedTimer(ESimPhase InPhase, int32 InDroneSlot = INDEX_NONE)
+		: Phase(InPhase)
+		, DroneSlot(InDroneSlot)
+	{
+		if (FSimProfiler::IsEnabled())
+		{
+			Start();
+		}
+	}
+
+	FORCEINLINE ~FSimScopedTimer()
+	{
+		if (StartCycles != 0)
+		{
+			Stop();
+		}
+	}
+
+	FSimScopedTimer(const FSimScopedTimer&) = delete;
+	FSimScopedTimer& operator=(const FSimScopedTimer&) = delete;
+
+private:
+	void Start();
+	void Stop();
+
+	ESimPhase Phase;
+	int32 DroneSlot;
+	uint64 StartCycles = 0;
+	uint64 ChildCycles = 0;
+	FSimScopedTimer* Parent = nullptr;
+};
@@ -1,6 +1,21 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "QuadSimToReality.h"
+#include "Core/RunProfile.h"
+#include "ImGuiModule.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, QuadSimToReality, "QuadSimToReality" );
+class FQuadSimToRealityModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+		// ImGui loads before us and no viewport exists yet, so runs without UI never build fonts or widgets
+		if (!FRunProfile::Get().WantsUI() && FImGuiModule::IsAvailable())
+		{
+			FImGuiModule::Get().EnterHeadlessMode();
+		}
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FQuadSimToRealityModule, QuadSimToReality, "QuadSimToReality" );
@@ -0,0 +1,226 @@
+"""Launches a pool of headless simulator instances and measures how fast they come up.
+
+Each instance gets -EnvIndex=N, so its ZMQ ports (and IPC paths) move up by N * stride and its shared
+memory rings and logs are prefixed with env<N>_ (see Source/QuadSimToReality/Public/Core/EnvPool.h).
+Once its world is ticking and its sockets have stopped appearing, an instance writes a readiness file
+(<ready dir>/env_<N>.json) with its endpoints and its own startup time. The launcher waits for those
+files instead of guessing with sleeps.
+
+All instances share one derived data cache directory, so shaders and other derived data are built by
+the first instance that needs them and read by the rest.
+
+Usage:
+    python env_pool.py --exe Binaries/Linux/QuadSimToReality --count 16 --benchmark
+    python env_pool.py --exe /opt/UE_5.5/Engine/Binaries/Linux/UnrealEditor \\
+        --project QuadSimToReality.uproject --count 4
+
+Or from Python:
+    pool = EnvPool("Binaries/Linux/QuadSimToReality", count=8)
+    pool.start()
+    ready = pool.wait_ready()       # one dict per instance, as written by the simulator
+    ...
+    pool.stop()
+"""
+import argparse
+import json
+import os
+import statistics
+import subprocess
+import tempfile
+import threading
+import time
+
+DEFAULT_PORT_STRIDE = 100
+
+# Headless, unattended and unpaced; -RenderOffscreen keeps cameras working without a window. The training
+# profile skips ImGui, debug drawing and ROS2 so workers reach their first step sooner
+DEFAULT_FLAGS = ["-unattended", "-nosplash", "-nosound", "-RenderOffscreen", "-MaxSpeed", "-RunProfile=training"]
+
+
+class EnvPool:
+    def __init__(self, exe, count, project=None, port_stride=DEFAULT_PORT_STRIDE, ready_dir=None,
+                 ddc_dir=None, no_render=False, extra_args=()):
+        self.exe = exe
+        self.count = count
+        self.project = project
+        self.port_stride = port_stride
+        self.ready_dir = os.path.abspath(ready_dir or tempfile.mkdtemp(prefix="quadsim_pool_"))
+        self.ddc_dir = os.path.abspath(ddc_dir or os.path.expanduser("~/.cache/quadsim_ddc"))
+        self.flags = [f for f in DEFAULT_FLAGS if not (no_render and f == "-RenderOffscreen")]
+        if no_render:
+            self.flags.append("-nullrhi")
+        self.flags += list(extra_args)
+        self.processes = []
+        self.launch_times = []
+
+    def ready_file(self, env_index):
+        return os.path.join(self.ready_dir, "env_%d.json" % env_index)
+
+    def command(self, env_index):
+        command = [self.exe]
+        if self.project:
+            command += [os.path.abspath(self.project), "-game"]
+        command += self.flags
+        command += [
+            "-EnvIndex=%d" % env_index,
+            "-EnvPortStride=%d" % self.port_stride,
+            "-ReadyFile=%s" % self.ready_file(env_index),
+            "-abslog=%s" % os.path.join(self.ready_dir, "env_%d.log" % env_index),
+        ]
+        return command
+
+    def start(self, stagger=0.0):
+        os.makedirs(self.ready_dir, exist_ok=True)
+        os.makedirs(self.ddc_dir, exist_ok=True)
+
+        environment = dict(os.environ)
+        environment["UE-LocalDataCachePath"] = self.ddc_dir
+        environment.setdefault("UE-SharedDataCachePath", self.ddc_dir)
+
+        for env_index in range(self.count):
+            path = self.ready_file(env_index)
+            if os.path.exists(path):
+                os.remove(path)
+            self.launch_times.append(time.monotonic())
+            self.processes.append(subprocess.Popen(self.command(env_index), env=environment,
+                                                   stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL))
+            if stagger > 0.0:
+                time.sleep(stagger)
+
+    def poll_ready(self):
+        """Readiness files written so far, by env index"""
+        ready = {}
+        for env_index in range(self.count):
+            try:
+                with open(self.ready_file(env_index)) as f:
+                    ready[env_index] = json.load(f)
+            except (OSError, ValueError):
+                pass
+        return ready
+
+    def wait_ready(self, timeout=600.0, on_ready=None):
+        """Blocks until every instance is ready; on_ready(env_index, info) is called as each one is.
+
+        Everything found ready in one poll is timestamped before any callback runs, so a slow callback
+        does not count against the instances after it; it still delays the next poll, so keep it short."""
+        deadline = time.monotonic() + timeout
+        ready = {}
+        while len(ready) < self.count:
+            now = time.monotonic()
+            newly_ready = [(env_index, info) for env_index, info in self.poll_ready().items() if env_index not in ready]
+            for env_index, info in newly_ready:
+                info["ready_seconds"] = now - self.launch_times[env_index]
+                ready[env_index] = info
+            if on_ready:
+                for env_index, info in newly_ready:
+                    on_ready(env_index, info)
+            for env_index, process in enumerate(self.processes):
+                if env_index not in ready and process.poll() is not None:
+                    raise RuntimeError("Instance %d exited with code %d before it was ready (see %s)"
+                                       % (env_index, process.returncode, os.path.join(self.ready_dir, "env_%d.log" % env_index)))
+            if time.monotonic() > deadline:
+                raise TimeoutError("%d of %d instances ready after %.0f s" % (len(ready), self.count, timeout))
+            time.sleep(0.05)
+        return [ready[i] for i in range(self.count)]
+
+    def stop(self, timeout=10.0):
+        for process in self.processes:
+            if process.poll() is None:
+                process.terminate()
+        for process in self.processes:
+            try:
+                process.wait(timeout)
+            except subprocess.TimeoutExpired:
+                process.kill()
+        self.processes = []
+
+
+def rpc_endpoint(info):
+    """The step endpoint an instance reported: its environment manager's, else its first drone's"""
+    endpoints = info.get("endpoints", {})
+    if "rpc" in endpoints.get("environments", {}):
+        return endpoints["environments"]["rpc"]
+    for owner in sorted(endpoints):
+        if "rpc" in endpoints[owner]:
+            return endpoints[owner]["rpc"]
+    return None
+
+
+def benchmark(pool, timeout):
+    """Seconds from launch to the first completed step, per instance"""
+    from quadsim_rpc import StepClient
+
+    first_step = {}
+    steppers = []
+
+    def step_once(env_index, info):
+        endpoint = rpc_endpoint(info)
+        if endpoint is None:
+            return
+        client = StepClient(endpoint=endpoint)
+        try:
+            client.reset()
+            client.step([0.0, 0.0, 0.0])
+            first_step[env_index] = time.monotonic() - pool.launch_times[env_index]
+        finally:
+            client.close()
+
+    # Each instance is stepped on its own thread, so the polling that timestamps readiness never waits on a step
+    def start_stepping(env_index, info):
+        stepper = threading.Thread(target=step_once, args=(env_index, info), daemon=True)
+        stepper.start()
+        steppers.append(stepper)
+
+    ready = pool.wait_ready(timeout, on_ready=start_stepping)
+    for stepper in steppers:
+        stepper.join(timeout)
+
+    print("env  engine startup  ready  first step")
+    for env_index, info in enumerate(ready):
+        step = first_step.get(env_index)
+        print("%3d  %12.2f s  %5.2f s  %s" % (env_index, info["startup_seconds"], info["ready_seconds"],
+                                            "%8.2f s" % step if step is not None else "  no rpc"))
+
+    if first_step:
+        times = sorted(first_step.values())
+        print("seconds-to-first-step over %d instances: min %.2f  median %.2f  max %.2f"
+              % (len(times), times[0], statistics.median(times), times[-1]))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Launch a pool of headless simulator instances")
+    parser.add_argument("--exe", required=True, help="packaged game binary, or UnrealEditor together with --project")
+    parser.add_argument("--project", help="uproject to run with the editor binary in -game mode")
+    parser.add_argument("--count", type=int, default=4)
+    parser.add_argument("--port-stride", type=int, default=DEFAULT_PORT_STRIDE)
+    parser.add_argument("--ready-dir", help="where readiness files and logs go (a temp dir by default)")
+    parser.add_argument("--ddc-dir", help="derived data cache shared by all instances (~/.cache/quadsim_ddc)")
+    parser.add_argument("--no-render", action="store_true", help="run with -nullrhi; no camera images")
+    parser.add_argument("--stagger", type=float, default=0.0, help="seconds between launches")
+    parser.add_argument("--timeout", type=float, default=600.0)
+    parser.add_argument("--benchmark", action="store_true", help="report seconds-to-first-step and exit")
+    parser.add_argument("extra", nargs=argparse.REMAINDER, help="further simulator arguments after --")
+    args = parser.parse_args()
+
+    extra = [a for a in args.extra if a != "--"]
+    pool = EnvPool(args.exe, args.count, project=args.project, port_stride=args.port_stride,
+                   ready_dir=args.ready_dir, ddc_dir=args.ddc_dir, no_render=args.no_render, extra_args=extra)
+    print("Launching %d instances, readiness files in %s" % (args.count, pool.ready_dir))
+    pool.start(args.stagger)
+    try:
+        if args.benchmark:
+            benchmark(pool, args.timeout)
+            return
+        for info in pool.wait_ready(args.timeout):
+            print("env %d ready after %.2f s: %s" % (info["env_index"], info["ready_seconds"], rpc_endpoint(info)))
+        print("Pool ready; Ctrl+C stops it")
+        while all(p.poll() is None for p in pool.processes):
+            time.sleep(1.0)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        pool.stop()
+
+
+if __name__ == "__main__":
+    main()
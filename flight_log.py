@@ -0,0 +1,154 @@
+"""Reader and exporter for QuadSimToReality flight logs (.qsfl).
+
+The layout mirrors FFlightLogHeader / FFlightRecord in
+Source/QuadSimToReality/Public/Utility/FlightRecorder.h.
+
+Usage:
+    python flight_log.py Saved/FlightLogs/flight_20250101_120000.qsfl --csv out.csv
+    python flight_log.py flight.qsfl --parquet out.parquet
+
+Or from Python:
+    log = FlightLog("flight.qsfl")
+    df = log.to_dataframe()
+"""
+import argparse
+import os
+
+import numpy as np
+
+MAGIC = b"QSFLTLOG"
+FORMAT_VERSION = 1
+MAX_DRONES = 64
+MAX_DRONE_NAME_LENGTH = 64
+
+HEADER_DTYPE = np.dtype([
+    ("magic", "S8"),
+    ("version", "<u4"),
+    ("record_size", "<u4"),
+    ("header_bytes", "<u4"),
+    ("num_drones", "<u4"),
+    ("num_records", "<u8"),
+    ("start_unix_time_ms", "<i8"),
+    ("drone_names", "S%d" % MAX_DRONE_NAME_LENGTH, (MAX_DRONES,)),
+])
+
+AXES = ("x", "y", "z", "roll", "pitch", "yaw")
+
+RECORD_DTYPE = np.dtype([
+    ("step", "<u8"),
+    ("sim_time", "<f8"),
+    ("drone_index", "<u4"),
+    ("flags", "<u4"),
+    ("position", "<f4", (3,)),
+    ("velocity", "<f4", (3,)),
+    ("rotation", "<f4", (3,)),
+    ("angular_velocity", "<f4", (3,)),
+    ("desired_velocity", "<f4", (3,)),
+    ("desired_yaw", "<f4"),
+    ("pid_output", "<f4", (6,)),
+    ("pid_terms", "<f4", (6, 3)),
+    ("thrusts", "<f4", (4,)),
+])
+assert RECORD_DTYPE.itemsize == 200
+
+FLAG_MANUAL_THRUST = 1 << 0
+FLAG_HOVER_MODE = 1 << 1
+
+
+class FlightLog:
+    def __init__(self, path):
+        self.path = path
+
+        header = np.fromfile(path, dtype=HEADER_DTYPE, count=1)
+        if header.size == 0 or header["magic"][0] != MAGIC:
+            raise ValueError("%s is not a flight log" % path)
+        header = header[0]
+
+        if header["version"] != FORMAT_VERSION:
+            raise ValueError("Unsupported flight log version %d" % header["version"])
+        if header["record_size"] != RECORD_DTYPE.itemsize:
+            raise ValueError("Record size %d does not match reader (%d)" % (header["record_size"], RECORD_DTYPE.itemsize))
+
+        self.header_bytes = int(header["header_bytes"])
+        self.start_unix_time_ms = int(header["start_unix_time_ms"])
+        self.drone_names = [name.decode("utf-8") for name in header["drone_names"][:header["num_drones"]]]
+
+        # The count is kept current while recording, so a crashed session reads up to its last write.
+        # Logs from before that have no count; the file grows in zeroed segments, so stop at the first
+        # all-zero record instead of returning the unused tail
+        num_records = int(header["num_records"])
+        if num_records == 0:
+            num_records = (os.path.getsize(path) - self.header_bytes) // RECORD_DTYPE.itemsize
+            if num_records > 0:
+                raw = np.memmap(path, dtype=np.uint8, mode="r", offset=self.header_bytes,
+                                shape=(num_records, RECORD_DTYPE.itemsize))
+                empty = np.flatnonzero(~raw.any(axis=1))
+                if empty.size > 0:
+                    num_records = int(empty[0])
+
+        self.records = np.memmap(path, dtype=RECORD_DTYPE, mode="r", offset=self.header_bytes, shape=(num_records,)) \
+            if num_records > 0 else np.zeros(0, dtype=RECORD_DTYPE)
+
+    def __len__(self):
+        return len(self.records)
+
+    def drone(self, name):
+        """Records of one drone, in step order"""
+        index = self.drone_names.index(name)
+        selected = self.records[self.records["drone_index"] == index]
+        return selected[np.argsort(selected["step"], kind="stable")]
+
+    def to_columns(self):
+        """Flattens the records into a dict of 1-D column arrays"""
+        r = self.records
+        names = np.array(self.drone_names + ["<unknown>"], dtype=object)
+        indices = np.minimum(r["drone_index"], len(self.drone_names))
+
+        columns = {
+            "drone": names[indices],
+            "step": r["step"],
+            "sim_time": r["sim_time"],
+            "manual_thrust": (r["flags"] & FLAG_MANUAL_THRUST) != 0,
+            "hover_mode": (r["flags"] & FLAG_HOVER_MODE) != 0,
+        }
+        for field in ("position", "velocity", "angular_velocity", "desired_velocity"):
+            for i, axis in enumerate("xyz"):
+                columns["%s_%s" % (field, axis)] = r[field][:, i]
+        for i, axis in enumerate(("roll", "pitch", "yaw")):
+            columns["rotation_%s" % axis] = r["rotation"][:, i]
+        columns["desired_yaw"] = r["desired_yaw"]
+        for a, axis in enumerate(AXES):
+            columns["pid_%s_output" % axis] = r["pid_output"][:, a]
+            for t, term in enumerate("pid"):
+                columns["pid_%s_%s" % (axis, term)] = r["pid_terms"][:, a, t]
+        for i in range(4):
+            columns["thrust_%d" % i] = r["thrusts"][:, i]
+        return columns
+
+    def to_dataframe(self):
+        import pandas as pd
+        return pd.DataFrame(self.to_columns())
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Inspect and export QuadSimToReality flight logs")
+    parser.add_argument("log", help="Path to a .qsfl file")
+    parser.add_argument("--csv", help="Write all records to this CSV file")
+    parser.add_argument("--parquet", help="Write all records to this Parquet file (requires pyarrow)")
+    args = parser.parse_args()
+
+    log = FlightLog(args.log)
+    print("%s: %d records, drones: %s" % (args.log, len(log), ", ".join(log.drone_names) or "none"))
+
+    if args.csv or args.parquet:
+        df = log.to_dataframe()
+        if args.csv:
+            df.to_csv(args.csv, index=False)
+            print("Wrote %s" % args.csv)
+        if args.parquet:
+            df.to_parquet(args.parquet, index=False)
+            print("Wrote %s" % args.parquet)
+
+
+if __name__ == "__main__":
+    main()
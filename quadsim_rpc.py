@@ -0,0 +1,191 @@
+"""Client for the simulator's request/reply step endpoint.
+
+The framing mirrors Source/QuadSimToReality/Public/Controllers/ZMQStepProtocol.h.
+
+Each ZMQ controller serves one drone on its RpcPort (5559 by default) as environment 0; a
+SimEnvironmentManager serves all of its environments on one port (5600 by default), picked by the
+env_index of each request. Requests are pipelined: send as many as you like, then collect the replies,
+which carry the request id they answer. Within an environment STEP and RESET run in the order they
+were sent, each for the requested number of control steps.
+
+State positions and goals are in world coordinates from a ZMQ controller, and relative to the
+environment's origin from a SimEnvironmentManager. Don't mix the two in one dataset.
+
+Usage:
+    python quadsim_rpc.py --steps 200 --substeps 2
+    python quadsim_rpc.py --ports 5559 5569 5579      # one client per drone, steps kept in flight on all
+    python quadsim_rpc.py --ports 5600 --envs 16      # 16 environments of one process, one socket
+
+Or from Python:
+    client = StepClient(5559)
+    state = client.reset()
+    state = client.step([0.0, 0.0, 100.0], substeps=2)
+
+    ids = [client.send_step([0, 0, 100], substeps=1) for _ in range(4)]   # pipelined
+    states = [client.wait(i) for i in ids]
+
+    envs = StepClient(5600)
+    states = envs.step_all([[0, 0, 100]] * 16)    # one action per environment, all stepped together
+"""
+import argparse
+import json
+import struct
+import time
+
+import numpy as np
+import zmq
+
+VERSION = 2
+
+OP_STEP = 1
+OP_RESET = 2
+OP_GET_IMAGE = 3
+
+STATUS_OK = 0
+STATUS_BAD_REQUEST = 1
+STATUS_NO_IMAGE = 2
+STATUS_CANCELLED = 3
+
+REQUEST_HEADER = struct.Struct("<IBBH")   # request id, op, env index, substeps
+REPLY_HEADER = struct.Struct("<IBBH")     # request id, op, status, version
+ACTION = struct.Struct("<3f")
+
+STATE_DTYPE = np.dtype([
+    ("step", "<u8"),
+    ("sim_time", "<f8"),
+    ("position", "<f4", (3,)),
+    ("velocity", "<f4", (3,)),
+    ("orientation", "<f4", (4,)),
+    ("angular_velocity", "<f4", (3,)),
+    ("goal", "<f4", (3,)),
+])
+assert STATE_DTYPE.itemsize == 80
+
+IMAGE_DTYPE = np.dtype([
+    ("frame_id", "<u8"),
+    ("sim_time", "<f8"),
+    ("width", "<u4"),
+    ("height", "<u4"),
+])
+assert IMAGE_DTYPE.itemsize == 24
+
+
+class StepError(RuntimeError):
+    pass
+
+
+class StepClient:
+    def __init__(self, port=5559, endpoint=None, context=None):
+        self.context = context or zmq.Context.instance()
+        self.socket = self.context.socket(zmq.DEALER)
+        self.socket.setsockopt(zmq.LINGER, 0)
+        self.socket.connect(endpoint or "tcp://localhost:%d" % port)
+        self._next_id = 1
+        self._replies = {}
+
+    def close(self):
+        self.socket.close()
+
+    # Pipelined interface: send_* returns the request id, wait() returns its reply
+
+    def send_step(self, velocity, substeps=1, env_index=0):
+        return self._send(OP_STEP, env_index, substeps, ACTION.pack(*velocity))
+
+    def send_reset(self, spec=None, substeps=1, env_index=0):
+        return self._send(OP_RESET, env_index, substeps, json.dumps(spec).encode() if spec else b"")
+
+    def send_get_image(self, env_index=0):
+        return self._send(OP_GET_IMAGE, env_index, 0, b"")
+
+    def wait(self, request_id, timeout_ms=5000):
+        while request_id not in self._replies:
+            if not self.socket.poll(timeout_ms, zmq.POLLIN):
+                raise TimeoutError("No reply to request %d" % request_id)
+            self.receive_one()
+        return self._replies.pop(request_id)
+
+    def receive_one(self):
+        """Reads one reply into the reply table and returns its request id"""
+        body = self.socket.recv()
+        request_id, op, status, version = REPLY_HEADER.unpack_from(body)
+        if version != VERSION:
+            raise StepError("Simulator speaks step protocol %d, client %d" % (version, VERSION))
+        self._replies[request_id] = _decode(op, status, memoryview(body)[REPLY_HEADER.size:])
+        return request_id
+
+    # Blocking conveniences
+
+    def step(self, velocity, substeps=1, env_index=0):
+        return self.wait(self.send_step(velocity, substeps, env_index))
+
+    def reset(self, spec=None, substeps=1, env_index=0):
+        return self.wait(self.send_reset(spec, substeps, env_index))
+
+    def get_image(self, env_index=0):
+        return self.wait(self.send_get_image(env_index))
+
+    # Vectorized environments: one request per environment, sent before any reply is awaited
+
+    def step_all(self, velocities, substeps=1):
+        ids = [self.send_step(velocity, substeps, env) for env, velocity in enumerate(velocities)]
+        return [self.wait(i) for i in ids]
+
+    def reset_all(self, num_envs, spec=None, substeps=1):
+        ids = [self.send_reset(spec, substeps, env) for env in range(num_envs)]
+        return [self.wait(i) for i in ids]
+
+    def _send(self, op, env_index, substeps, payload):
+        request_id = self._next_id
+        self._next_id = (self._next_id + 1) & 0xFFFFFFFF or 1
+        self.socket.send(REQUEST_HEADER.pack(request_id, op, env_index, substeps) + payload)
+        return request_id
+
+
+def _decode(op, status, payload):
+    if status == STATUS_NO_IMAGE:
+        return None
+    if status != STATUS_OK:
+        raise StepError("Request (op %d) failed with status %d" % (op, status))
+    if op == OP_GET_IMAGE:
+        info = np.frombuffer(payload, dtype=IMAGE_DTYPE, count=1)[0]
+        pixels = np.frombuffer(payload, dtype=np.uint8, offset=IMAGE_DTYPE.itemsize)
+        return info, pixels.reshape(int(info["height"]), int(info["width"]), 4)
+    return np.frombuffer(payload, dtype=STATE_DTYPE, count=1)[0]
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Measure step round trips against the simulator")
+    parser.add_argument("--ports", type=int, nargs="+", default=[5559], help="RpcPort of each drone or environment manager")
+    parser.add_argument("--envs", type=int, default=1, help="environments behind each port")
+    parser.add_argument("--steps", type=int, default=100)
+    parser.add_argument("--substeps", type=int, default=1)
+    parser.add_argument("--in-flight", type=int, default=2, help="requests kept in flight per environment")
+    args = parser.parse_args()
+
+    clients = [StepClient(port) for port in args.ports]
+    lanes = [(client, env) for client in clients for env in range(args.envs)]
+    for client in clients:
+        client.reset_all(args.envs)
+
+    start = time.perf_counter()
+    in_flight = min(args.in_flight, args.steps)
+    pending = [[client.send_step([0.0, 0.0, 0.0], args.substeps, env) for _ in range(in_flight)] for client, env in lanes]
+    sent = [in_flight] * len(lanes)
+    done = 0
+    state = None
+    while any(pending):
+        for i, (client, env) in enumerate(lanes):
+            if pending[i]:
+                state = client.wait(pending[i].pop(0))
+                done += 1
+                if sent[i] < args.steps:
+                    pending[i].append(client.send_step([0.0, 0.0, 0.0], args.substeps, env))
+                    sent[i] += 1
+    elapsed = time.perf_counter() - start
+
+    print("%d steps over %d environment(s) in %.2f s: %.1f steps/s, last sim time %.3f"
+          % (done, len(lanes), elapsed, done / max(elapsed, 1e-9), float(state["sim_time"]) if state is not None else 0.0))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,176 @@
+"""Reader for the simulator's shared memory camera frame rings.
+
+The layout mirrors FSharedFrameRingHeader / FSharedFrameSlot in
+Source/QuadSimToReality/Public/Utility/SharedFrameRing.h.
+
+With bSharedMemoryFrames enabled, the simulator writes each camera frame into /dev/shm/quadsim_<id>
+(quadsim_env<N>_<id> in an instance started with -EnvIndex=N) and
+publishes only a descriptor ("SHM:<name>,<frame id>,<slot>,<width>,<height>") over ZMQ or ROS2.
+Frames are BGRA8 and are handed out as numpy views into the mapping, so reading them copies nothing.
+
+Usage:
+    python quadsim_shm.py quadsim_BP_QuadPawn_C_0
+
+Or from Python:
+    ring = FrameRing("quadsim_BP_QuadPawn_C_0")
+    frame = ring.frame_from_descriptor(descriptor)   # or ring.latest()
+    if frame is not None:
+        image = frame.bgr                               # (H, W, 3) view, no copy
+        ...                                             # use the pixels
+        if not frame.valid():                           # overwritten while in use
+            ...
+"""
+import argparse
+import mmap
+import os
+import time
+
+import numpy as np
+
+MAGIC = b"QSFRAMES"
+FORMAT_VERSION = 1
+HEADER_SIZE = 256
+SLOT_HEADER_SIZE = 64
+
+HEADER_DTYPE = np.dtype([
+    ("magic", "S8"),
+    ("version", "<u4"),
+    ("num_slots", "<u4"),
+    ("slot_bytes", "<u4"),
+    ("width", "<u4"),
+    ("height", "<u4"),
+    ("bytes_per_pixel", "<u4"),
+    ("latest_frame", "<u8"),
+])
+
+SLOT_DTYPE = np.dtype([
+    ("sequence", "<u4"),
+    ("pad", "<u4"),
+    ("frame_id", "<u8"),
+    ("sim_time", "<f8"),
+    ("width", "<u4"),
+    ("height", "<u4"),
+])
+
+
+def parse_descriptor(descriptor):
+    """Splits a frame descriptor into (ring name, frame id, slot, width, height), or None"""
+    if isinstance(descriptor, bytes):
+        descriptor = descriptor.decode("utf-8")
+    if not descriptor.startswith("SHM:"):
+        return None
+    name, frame_id, slot, width, height = descriptor[4:].split(",")
+    return name, int(frame_id), int(slot), int(width), int(height)
+
+
+class Frame:
+    """A zero-copy view of one slot. The pixels stay valid only while valid() returns True."""
+
+    def __init__(self, slot_header, pixels, sequence):
+        self._slot_header = slot_header
+        self._sequence = sequence
+        self.frame_id = int(slot_header["frame_id"])
+        self.sim_time = float(slot_header["sim_time"])
+        self.bgra = pixels
+        self.bgr = pixels[..., :3]
+
+    def valid(self):
+        """True while the writer has not started reusing this slot"""
+        return int(self._slot_header["sequence"]) == self._sequence
+
+    def copy(self):
+        """Copies the pixels out, or returns None if the frame was overwritten meanwhile"""
+        pixels = self.bgr.copy()
+        return pixels if self.valid() else None
+
+
+class FrameRing:
+    def __init__(self, name):
+        self.name = name
+        self.path = os.path.join("/dev/shm", name)
+        fd = os.open(self.path, os.O_RDONLY)
+        try:
+            stat = os.fstat(fd)
+            self._identity = (stat.st_ino, stat.st_size)
+            self._map = mmap.mmap(fd, 0, prot=mmap.PROT_READ)
+        finally:
+            os.close(fd)
+
+        header = np.frombuffer(self._map, dtype=HEADER_DTYPE, count=1)
+        if header["magic"][0] != MAGIC:
+            raise ValueError("%s is not a frame ring" % name)
+        if header["version"][0] != FORMAT_VERSION:
+            raise ValueError("Unsupported frame ring version %d" % header["version"][0])
+        self._header = header[0]
+
+        self.num_slots = int(self._header["num_slots"])
+        self.width = int(self._header["width"])
+        self.height = int(self._header["height"])
+        slot_bytes = int(self._header["slot_bytes"])
+        bytes_per_pixel = int(self._header["bytes_per_pixel"])
+
+        # Slot headers and pixels are mapped once; frames are views into these arrays
+        self._slots = []
+        for i in range(self.num_slots):
+            offset = HEADER_SIZE + i * slot_bytes
+            slot_header = np.frombuffer(self._map, dtype=SLOT_DTYPE, count=1, offset=offset)[0]
+            pixels = np.frombuffer(self._map, dtype=np.uint8, count=self.width * self.height * bytes_per_pixel,
+                                   offset=offset + SLOT_HEADER_SIZE).reshape(self.height, self.width, bytes_per_pixel)
+            self._slots.append((slot_header, pixels))
+
+    def replaced(self):
+        """True once the simulator has recreated the ring (e.g. a camera reopened at a new size); the old
+        mapping then stays readable but is never written again, so the ring has to be opened anew"""
+        try:
+            stat = os.stat(self.path)
+        except OSError:
+            return True
+        return (stat.st_ino, stat.st_size) != self._identity
+
+    @property
+    def latest_frame_id(self):
+        return int(self._header["latest_frame"])
+
+    def frame(self, frame_id):
+        """The frame with this id, or None if it is being written or was already overwritten"""
+        if frame_id <= 0:
+            return None
+        slot_header, pixels = self._slots[(frame_id - 1) % self.num_slots]
+        sequence = int(slot_header["sequence"])
+        if sequence & 1 or int(slot_header["frame_id"]) != frame_id:
+            return None
+        frame = Frame(slot_header, pixels, sequence)
+        return frame if frame.valid() else None
+
+    def latest(self):
+        return self.frame(self.latest_frame_id)
+
+    def frame_from_descriptor(self, descriptor):
+        parsed = parse_descriptor(descriptor)
+        if parsed is None or parsed[0] != self.name:
+            return None
+        return self.frame(parsed[1])
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Report the frame rate of a shared memory frame ring")
+    parser.add_argument("name", help="Ring name, e.g. quadsim_BP_QuadPawn_C_0 (see /dev/shm)")
+    args = parser.parse_args()
+
+    ring = FrameRing(args.name)
+    print("%s: %d slots of %dx%d" % (args.name, ring.num_slots, ring.width, ring.height))
+
+    last_id = ring.latest_frame_id
+    last_time = time.monotonic()
+    while True:
+        time.sleep(1.0)
+        frame_id = ring.latest_frame_id
+        now = time.monotonic()
+        frame = ring.latest()
+        sim_time = "%.3f" % frame.sim_time if frame is not None else "-"
+        print("frame %d  %.1f fps  sim time %s" % (frame_id, (frame_id - last_id) / (now - last_time), sim_time))
+        last_id, last_time = frame_id, now
+
+
+if __name__ == "__main__":
+    main()
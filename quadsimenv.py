@@ -5,15 +5,29 @@ import time
 import cv2  
 import glob 
 import os
+import json
 from stable_baselines3 import PPO
 from stable_baselines3.common.callbacks import CheckpointCallback, EvalCallback, BaseCallback
 from stable_baselines3.common.monitor import Monitor
+from quadsim_shm import FrameRing, parse_descriptor
 
 # --- QuadSimEnv definition ---
+def zmq_endpoint(transport, port, bind=False, ipc_directory="/tmp"):
+    """Endpoint for a port, matching AZMQController::MakeEndpoint"""
+    if transport == "ipc":
+        return "ipc://%s/quadsim_%d" % (ipc_directory, port)
+    if transport == "inproc":
+        return "inproc://quadsim_%d" % port
+    return ("tcp://*:%d" if bind else "tcp://localhost:%d") % port
+
+
 class QuadSimEnv(gym.Env):
-    def __init__(self):
+    def __init__(self, transport="tcp", ipc_directory="/tmp", env_index=0, port_stride=100):
         super(QuadSimEnv, self).__init__()  
 
+        # Instances launched with -EnvIndex=N (env_pool.py) serve their ports N * stride higher
+        port_offset = env_index * port_stride
+
         # Modify action space to only control Z
         self.action_space = gym.spaces.Box(
             low=np.array([-1]),  # Just Z control
@@ -40,21 +54,25 @@ class QuadSimEnv(gym.Env):
         self.prev_velocity = 0.0  
         self.context = zmq.Context()
 
-        # Subscriber socket for receiving images
+        # Subscriber socket for receiving images; a short queue so a slow step never reads stale frames
         self.image_socket = self.context.socket(zmq.SUB)
-        self.image_socket.connect("tcp://localhost:5557")
+        self.image_socket.setsockopt(zmq.RCVHWM, 2)
+        self.image_socket.connect(zmq_endpoint(transport, 5557 + port_offset, ipc_directory=ipc_directory))
         self.image_socket.setsockopt_string(zmq.SUBSCRIBE, '')
 
         # Publisher socket for sending velocity commands / reset command
         self.command_socket = self.context.socket(zmq.PUB)
-        self.command_socket.bind("tcp://*:5556")  
+        self.command_socket.bind(zmq_endpoint(transport, 5556 + port_offset, bind=True, ipc_directory=ipc_directory))
 
-        # Subscriber socket for receiving state
+        # Subscriber socket for receiving state; only the newest state is kept
         self.control_socket = self.context.socket(zmq.SUB)
-        self.control_socket.connect("tcp://localhost:5558")
+        self.control_socket.setsockopt(zmq.CONFLATE, 1)
+        self.control_socket.connect(zmq_endpoint(transport, 5558 + port_offset, ipc_directory=ipc_directory))
         self.control_socket.setsockopt_string(zmq.SUBSCRIBE, '')
 
         self.steps = 0
+        self.sim_time = 0.0
+        self.frame_rings = {}
         time.sleep(0.1)
 
     def get_observation(self):
@@ -134,12 +152,20 @@ class QuadSimEnv(gym.Env):
         self.command_socket.send_string(command_topic)
         time.sleep(0.1)
 
+    def send_randomized_reset_command(self, spec):
+        """Resets this env's drone with a randomized spawn and dynamics. spec follows FResetSpec, e.g.
+        {"seed": 7, "spawn": {"x": [-500, 500], "yaw": [-180, 180]}, "mass_scale": [0.9, 1.1]}"""
+        command_topic = "RESET_RANDOMIZED"
+        self.prev_goal_state = self.goal_state.copy()
+        self.command_socket.send_multipart([command_topic.encode(), json.dumps(spec).encode()])
+        time.sleep(0.1)
+
     def handle_data(self):
         try:
             if self.control_socket.poll(100, zmq.POLLIN):
                 unified_data = self.control_socket.recv_string()
                 data_parts = unified_data.split(";")
-                if len(data_parts) != 3:
+                if len(data_parts) < 3:
                     raise ValueError("Invalid data format")
                     
                 parsed_data = {}
@@ -156,6 +182,8 @@ class QuadSimEnv(gym.Env):
                     'position': np.array(parsed_data["POSITION"])
                 })
                 self.goal_state = np.array(parsed_data["GOAL"])
+                if len(parsed_data.get("TIME", [])) == 2:
+                    self.sim_time = parsed_data["TIME"][0]
                 
         except Exception as e:
             print(f"Data handling error: {str(e)}")
@@ -164,6 +192,25 @@ class QuadSimEnv(gym.Env):
     def get_data(self):
         try:
             [topic, message] = self.image_socket.recv_multipart(flags=zmq.NOBLOCK)
+            descriptor = parse_descriptor(message) if message.startswith(b"SHM:") else None
+            if descriptor is not None:
+                # Shared memory frame: map the ring once, then read the slot in place. A ring the sim
+                # recreated restarts its frame ids or changes size, and the old mapping goes stale
+                name, frame_id, _, width, height = descriptor
+                ring, last_frame_id = self.frame_rings.get(name, (None, 0))
+                if ring is not None and (frame_id < last_frame_id or (width, height) != (ring.width, ring.height)):
+                    ring = None
+                if ring is None:
+                    ring = FrameRing(name)
+                frame = ring.frame(frame_id)
+                if frame is None and ring.replaced():
+                    ring = FrameRing(name)
+                    frame = ring.frame(frame_id)
+                self.frame_rings[name] = (ring, frame_id)
+                if frame is None:
+                    return None
+                image = cv2.cvtColor(frame.bgra, cv2.COLOR_BGRA2RGB)
+                return image if frame.valid() else None
             image_data = np.frombuffer(message, dtype=np.uint8)
             image = cv2.imdecode(image_data, cv2.IMREAD_COLOR)
             if image is not None:
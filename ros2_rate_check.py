@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+"""Stand-in ROS2 consumer that reports the rate of the simulator's state topics.
+
+Subscribes to odometry, IMU and motor outputs of one drone namespace plus /clock, and prints the
+message rate of each topic (in wall time and in sim time) once a second.
+
+Usage:
+    python ros2_rate_check.py --ns quad
+    python ros2_rate_check.py --ns drone1 --window 5
+"""
+import argparse
+import collections
+import time
+
+import rclpy
+from rclpy.node import Node
+from rclpy.qos import qos_profile_sensor_data, QoSProfile, QoSReliabilityPolicy, QoSDurabilityPolicy
+from nav_msgs.msg import Odometry
+from sensor_msgs.msg import Imu
+from std_msgs.msg import Float32MultiArray
+from rosgraph_msgs.msg import Clock
+
+
+def stamp_seconds(stamp):
+    return stamp.sec + stamp.nanosec * 1e-9
+
+
+class RateCheck(Node):
+    def __init__(self, namespace, window):
+        super().__init__("ros2_rate_check")
+        self.window = window
+        self.arrivals = collections.defaultdict(collections.deque)
+        self.stamps = collections.defaultdict(collections.deque)
+
+        prefix = "/" + namespace.strip("/")
+        self.create_subscription(Odometry, prefix + "/odom", lambda m: self.record("odom", m.header.stamp), qos_profile_sensor_data)
+        self.create_subscription(Imu, prefix + "/imu/data", lambda m: self.record("imu", m.header.stamp), qos_profile_sensor_data)
+        self.create_subscription(Float32MultiArray, prefix + "/motor_outputs", lambda m: self.record("motors", None), qos_profile_sensor_data)
+
+        clock_qos = QoSProfile(depth=1, reliability=QoSReliabilityPolicy.BEST_EFFORT, durability=QoSDurabilityPolicy.VOLATILE)
+        self.create_subscription(Clock, "/clock", lambda m: self.record("clock", m.clock), clock_qos)
+
+        self.create_timer(1.0, self.report)
+
+    def record(self, name, stamp):
+        now = time.monotonic()
+        arrivals = self.arrivals[name]
+        arrivals.append(now)
+        while arrivals and now - arrivals[0] > self.window:
+            arrivals.popleft()
+
+        if stamp is not None:
+            stamps = self.stamps[name]
+            stamps.append(stamp_seconds(stamp))
+            while len(stamps) > len(arrivals):
+                stamps.popleft()
+
+    def report(self):
+        lines = []
+        for name in ("odom", "imu", "motors", "clock"):
+            arrivals = self.arrivals[name]
+            wall_hz = (len(arrivals) - 1) / (arrivals[-1] - arrivals[0]) if len(arrivals) > 1 and arrivals[-1] > arrivals[0] else 0.0
+
+            stamps = self.stamps[name]
+            sim_span = stamps[-1] - stamps[0] if len(stamps) > 1 else 0.0
+            sim_hz = (len(stamps) - 1) / sim_span if sim_span > 0.0 else 0.0
+
+            lines.append("%-7s %8.1f Hz wall %8.1f Hz sim" % (name, wall_hz, sim_hz))
+        self.get_logger().info("\n" + "\n".join(lines))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--ns", default="quad", help="drone namespace")
+    parser.add_argument("--window", type=float, default=2.0, help="averaging window in seconds")
+    args = parser.parse_args()
+
+    rclpy.init()
+    node = RateCheck(args.ns, args.window)
+    try:
+        rclpy.spin(node)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        node.destroy_node()
+        rclpy.shutdown()
+
+
+if __name__ == "__main__":
+    main()